@@ -0,0 +1,192 @@
+// file: bench_bignum.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Checks the bignum engine against GMP and times both for operands of 10 to 1000 digits
+
+# include <gmp.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "bignum.h"
+# include "host.h"
+
+// Benchmark Characteristics
+# define BENCH_PAIRS 64
+# define BENCH_OPERATIONS 5
+
+// Operand Sizes
+static const int benchDigits[] = { 10, 30, 100, 300, 1000 };
+
+// Operations
+static const char * const benchNames[BENCH_OPERATIONS] = { "add", "sub", "mul", "div", "mod" };
+
+// Operands
+// the divisors have half as many digits, so division has a quotient worth computing
+static char benchText[2][BENCH_PAIRS][BIGNUM_MAX_DIGITS + 2];
+static bignum_t benchOperands[2][BENCH_PAIRS];
+static mpz_t benchReference[2][BENCH_PAIRS];
+
+// Results
+static bignum_t benchResult;
+static char benchMine[BIGNUM_STRING_SIZE];
+static mpz_t benchTheirs;
+
+// Gets the next value of a 64-bit xorshift generator
+// @ param state - the generator state
+// @ return the next value
+static uint64_t bench_random(uint64_t * state) {
+    * state ^= * state << 13;
+    * state ^= * state >> 7;
+    * state ^= * state << 17;
+    return * state;
+}
+
+// Writes a random signed decimal with a nonzero leading digit
+// @ param text - where to write it
+// @ param digits - the number of digits
+// @ param seed - the generator state
+// @ return void
+static void bench_make(char * text, int digits, uint64_t * seed) {
+
+    int length = 0;
+
+    if (bench_random(seed) & 1) {
+        text[length++] = '-';
+    }
+
+    for (int i = 0; i < digits; i++) {
+        text[length++] = '0' + (i == 0 ? 1 + bench_random(seed) % 9 : bench_random(seed) % 10);
+    }
+
+    text[length] = '\0';
+}
+
+// Reads a signed decimal into a bignum the way the calculator types it
+// @ param n - the bignum
+// @ param text - the decimal
+// @ return void
+static void bench_parse(bignum_t * n, const char * text) {
+
+    int negative = (* text == '-');
+    text += negative;
+
+    bignum_set_int(n, 0);
+    for (; * text != '\0'; text++) {
+        bignum_mul_add_small(n, 10, * text - '0');
+    }
+
+    n->negative = negative;
+}
+
+// Runs one operation of the engine under test
+// @ param operation - the index of the operation
+// @ param a - the left operand
+// @ param b - the right operand
+// @ return the engine's status
+static int bench_mine(int operation, const bignum_t * a, const bignum_t * b) {
+    switch (operation) {
+        case 0: return bignum_add(&benchResult, a, b);
+        case 1: return bignum_sub(&benchResult, a, b);
+        case 2: return bignum_mul(&benchResult, a, b);
+        case 3: return bignum_div(&benchResult, a, b);
+        default: return bignum_mod(&benchResult, a, b);
+    }
+}
+
+// Runs one operation of the reference
+// @ param operation - the index of the operation
+// @ param a - the left operand
+// @ param b - the right operand
+// @ return void
+static void bench_theirs(int operation, const mpz_t a, const mpz_t b) {
+    switch (operation) {
+        case 0: mpz_add(benchTheirs, a, b); break;
+        case 1: mpz_sub(benchTheirs, a, b); break;
+        case 2: mpz_mul(benchTheirs, a, b); break;
+        case 3: mpz_tdiv_q(benchTheirs, a, b); break;
+        default: mpz_tdiv_r(benchTheirs, a, b); break;
+    }
+}
+
+// Runs the benchmark
+// @ param void
+// @ return 0 if every result matched the reference, otherwise 1
+int main(void) {
+
+    host_init();
+
+    uint64_t seed = 0x9E3779B97F4A7C15u;
+    long mismatches = 0;
+
+    mpz_init(benchTheirs);
+    for (int side = 0; side < 2; side++) {
+        for (int i = 0; i < BENCH_PAIRS; i++) {
+            mpz_init(benchReference[side][i]);
+        }
+    }
+
+    printf("host cycles per operation, bignum / GMP\n");
+    printf("digits");
+    for (int operation = 0; operation < BENCH_OPERATIONS; operation++) {
+        printf("  %18s", benchNames[operation]);
+    }
+    printf("\n");
+
+    for (unsigned size = 0; size < sizeof(benchDigits) / sizeof(benchDigits[0]); size++) {
+
+        int digits = benchDigits[size];
+
+        for (int i = 0; i < BENCH_PAIRS; i++) {
+            for (int side = 0; side < 2; side++) {
+                bench_make(benchText[side][i], side ? (digits + 1) / 2 : digits, &seed);
+                bench_parse(&benchOperands[side][i], benchText[side][i]);
+                mpz_set_str(benchReference[side][i], benchText[side][i], 10);
+            }
+        }
+
+        printf("%6d", digits);
+
+        for (int operation = 0; operation < BENCH_OPERATIONS; operation++) {
+
+            // check every pair against the reference
+            for (int i = 0; i < BENCH_PAIRS; i++) {
+
+                int status = bench_mine(operation, &benchOperands[0][i], &benchOperands[1][i]);
+                bench_theirs(operation, benchReference[0][i], benchReference[1][i]);
+                bignum_to_string(&benchResult, benchMine);
+
+                char * theirs = mpz_get_str(0, 10, benchTheirs);
+                if (status != BIGNUM_OK || strcmp(benchMine, theirs) != 0) {
+                    if (mismatches++ < 5) {
+                        printf("\n%s of %s and %s gave %s, expected %s\n", benchNames[operation],
+                               benchText[0][i], benchText[1][i], benchMine, theirs);
+                    }
+                }
+                free(theirs);
+            }
+
+            // then time a pass over all of them with each
+            uint64_t start = host_cycles();
+            for (int i = 0; i < BENCH_PAIRS; i++) {
+                bench_mine(operation, &benchOperands[0][i], &benchOperands[1][i]);
+            }
+            uint64_t mine = host_cycles() - start;
+
+            start = host_cycles();
+            for (int i = 0; i < BENCH_PAIRS; i++) {
+                bench_theirs(operation, benchReference[0][i], benchReference[1][i]);
+            }
+            uint64_t theirs = host_cycles() - start;
+
+            printf("  %8llu / %7llu", (unsigned long long) (mine / BENCH_PAIRS), (unsigned long long) (theirs / BENCH_PAIRS));
+        }
+
+        printf("\n");
+    }
+
+    printf("%d pairs per size checked against GMP, %ld mismatches\n", BENCH_PAIRS, mismatches);
+
+    return mismatches ? 1 : 0;
+}
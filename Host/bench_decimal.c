@@ -0,0 +1,312 @@
+// file: bench_decimal.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Checks the decimal engine against exact 128-bit arithmetic for every number of places and
+//              times it against double
+
+# include <stdint.h>
+# include <stdio.h>
+# include "decimal.h"
+# include "host.h"
+
+// Benchmark Characteristics
+# define BENCH_PAIRS 400000
+# define BENCH_OPERATORS 5
+# define BENCH_TIMED_PAIRS 1024
+# define BENCH_ROUNDS 8
+
+// A pass over the timed pairs with one operator
+typedef void (* bench_pass_t)(char operator);
+
+// Operators
+static const char benchOperators[BENCH_OPERATORS] = { '+', '-', '*', '/', '%' };
+
+// Powers of Ten
+static const int64_t benchPowers[DECIMAL_PLACES_MAX + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// Edge Values
+// the mantissas most likely to break an overflow check or a rounding step
+static const int64_t benchEdges[] = {
+    0, 1, -1, 2, -2, 5, -5, INT64_MAX, INT64_MIN, INT64_MAX - 1, INT64_MIN + 1,
+    3037000499, -3037000499, 3037000500, 4294967295, 4294967296, 1000000000, 999999999
+};
+
+// Timed Operands
+// visible outside the file so the compiler cannot drop the work that fills the results
+int64_t benchLeft[BENCH_TIMED_PAIRS];
+int64_t benchRight[BENCH_TIMED_PAIRS];
+int64_t benchMine[BENCH_TIMED_PAIRS];
+double benchLeftDouble[BENCH_TIMED_PAIRS];
+double benchRightDouble[BENCH_TIMED_PAIRS];
+double benchTheirs[BENCH_TIMED_PAIRS];
+
+// Path Counts
+// how many checks reached a tie or a 128-bit path, so a run shows that it exercised them
+static long benchTies;
+static long benchWideProducts;
+static long benchWideQuotients;
+
+// Gets the next value of a 64-bit xorshift generator
+// @ param state - the generator state
+// @ return the next value
+static uint64_t bench_random(uint64_t * state) {
+    * state ^= * state << 13;
+    * state ^= * state >> 7;
+    * state ^= * state << 17;
+    return * state;
+}
+
+// Draws a pair of mantissas, mixing full-width values, values of random width, edge values, small
+// values, and pairs whose exact product or quotient lies halfway between two results
+// @ param places - the number of places
+// @ param state - the generator state
+// @ param a - where to store the left mantissa
+// @ param b - where to store the right mantissa
+// @ return void
+static void bench_pair(int places, uint64_t * state, int64_t * a, int64_t * b) {
+
+    int64_t * sides[2] = { a, b };
+
+    for (int side = 0; side < 2; side++) {
+
+        uint64_t value = bench_random(state);
+        int64_t operand;
+
+        switch (value & 3) {
+            case 0:
+                operand = (int64_t) bench_random(state);
+                break;
+            case 1:
+                operand = (int64_t) (bench_random(state) >> (value >> 2) % 64);
+                operand = (value & 0x100) ? -operand : operand;
+                break;
+            case 2:
+                operand = benchEdges[(value >> 2) % (sizeof(benchEdges) / sizeof(benchEdges[0]))];
+                break;
+            default:
+                operand = (int64_t) ((value >> 2) % 20001) - 10000;
+                break;
+        }
+
+        * sides[side] = operand;
+    }
+
+    // an odd mantissa times one half, or over two, is exactly halfway between two results
+    uint64_t tie = bench_random(state);
+    if ((tie & 7) == 0) {
+        * a = ((* a >> 1) | 1) % 1000000007;
+        if (places > 0 && (tie & 8)) {
+            * b = 5 * benchPowers[places - 1];
+        } else {
+            * b = 2 * benchPowers[places];
+        }
+        * b = (tie & 16) ? -* b : * b;
+    }
+}
+
+// Rounds a 128-bit quotient half to even and checks that it fits
+// @ param numerator - the exact numerator
+// @ param denominator - the exact denominator, positive
+// @ param result - where to store the rounded quotient
+// @ return DECIMAL_OK, or DECIMAL_ERROR_OVERFLOW
+static int bench_round(__int128 numerator, __int128 denominator, int64_t * result) {
+
+    int negative = numerator < 0;
+    __int128 magnitude = negative ? -numerator : numerator;
+    __int128 quotient = magnitude / denominator;
+    __int128 twice = 2 * (magnitude % denominator);
+
+    if (twice == denominator) {
+        benchTies++;
+    }
+
+    if (twice > denominator || (twice == denominator && (quotient & 1))) {
+        quotient++;
+    }
+
+    quotient = negative ? -quotient : quotient;
+
+    if (quotient > INT64_MAX || quotient < INT64_MIN) {
+        return DECIMAL_ERROR_OVERFLOW;
+    }
+
+    * result = (int64_t) quotient;
+
+    return DECIMAL_OK;
+}
+
+// Computes what an operator should give on two decimals, exactly and then rounded half to even
+// @ param places - the number of places
+// @ param operator - the operator
+// @ param a - the left mantissa
+// @ param b - the right mantissa
+// @ param result - where to store the result
+// @ return the expected decimal status
+static int bench_reference(int places, char operator, int64_t a, int64_t b, int64_t * result) {
+
+    __int128 scale = benchPowers[places];
+    __int128 wide;
+
+    switch (operator) {
+
+        case '+': wide = (__int128) a + b; break;
+        case '-': wide = (__int128) a - b; break;
+
+        // the product carries the scale twice, so it is divided by it once
+        case '*':
+            wide = (__int128) a * b;
+            if (wide >= (__int128) 1 << 63 || wide <= -((__int128) 1 << 63)) {
+                benchWideProducts++;
+            }
+            return bench_round(wide, scale, result);
+
+        // the dividend is scaled up once so the quotient keeps the places
+        case '/':
+            if (b == 0) {
+                return DECIMAL_ERROR_DIVIDE;
+            }
+            wide = (__int128) a * scale;
+            if ((wide < 0 ? -wide : wide) >> 64 != 0) {
+                benchWideQuotients++;
+            }
+            return bench_round(b < 0 ? -wide : wide, b < 0 ? -(__int128) b : b, result);
+
+        case '%':
+            if (b == 0) {
+                return DECIMAL_ERROR_DIVIDE;
+            }
+            wide = (__int128) a % b;
+            break;
+
+        default:
+            return DECIMAL_ERROR_OVERFLOW;
+    }
+
+    if (wide > INT64_MAX || wide < INT64_MIN) {
+        return DECIMAL_ERROR_OVERFLOW;
+    }
+
+    * result = (int64_t) wide;
+
+    return DECIMAL_OK;
+}
+
+// Applies an operator to every timed pair with the decimal engine
+// @ param operator - the operator
+// @ return void
+static void bench_mine(char operator) {
+    for (int i = 0; i < BENCH_TIMED_PAIRS; i++) {
+        decimal_apply(operator, benchLeft[i], benchRight[i], &benchMine[i]);
+    }
+}
+
+// Applies an operator to every timed pair in double, with no rounding to the places
+// @ param operator - the operator
+// @ return void
+static void bench_theirs(char operator) {
+    for (int i = 0; i < BENCH_TIMED_PAIRS; i++) {
+        double a = benchLeftDouble[i];
+        double b = benchRightDouble[i];
+        switch (operator) {
+            case '+': benchTheirs[i] = a + b; break;
+            case '-': benchTheirs[i] = a - b; break;
+            case '*': benchTheirs[i] = a * b; break;
+            case '/': benchTheirs[i] = a / b; break;
+            default: benchTheirs[i] = a - b * (double) (int64_t) (a / b); break;
+        }
+    }
+}
+
+// Times a pass over the timed pairs
+// @ param pass - the pass
+// @ param operator - the operator
+// @ return the fewest cycles per operation over BENCH_ROUNDS passes, so an interrupt landing in one does not count
+static uint64_t bench_time(bench_pass_t pass, char operator) {
+
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+
+        uint64_t start = host_cycles();
+        pass(operator);
+        uint64_t cycles = host_cycles() - start;
+
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+
+    return best / BENCH_TIMED_PAIRS;
+}
+
+// Runs the benchmark
+// @ param void
+// @ return 0 if every result matched the reference, otherwise 1
+int main(void) {
+
+    host_init();
+
+    uint64_t seed = 0xD1B54A32D192ED03u;
+    long checked = 0;
+    long failures = 0;
+
+    for (int places = 0; places <= DECIMAL_PLACES_MAX; places++) {
+
+        decimal_set_places(places);
+
+        for (long pair = 0; pair < BENCH_PAIRS; pair++) {
+
+            int64_t a;
+            int64_t b;
+            bench_pair(places, &seed, &a, &b);
+
+            for (int i = 0; i < BENCH_OPERATORS; i++) {
+
+                char operator = benchOperators[i];
+
+                // a result left untouched on error shows up as the sentinel
+                int64_t expected = INT64_MIN;
+                int64_t actual = INT64_MIN;
+                int expectedStatus = bench_reference(places, operator, a, b, &expected);
+                int actualStatus = decimal_apply(operator, a, b, &actual);
+
+                checked++;
+
+                if (actualStatus != expectedStatus || actual != expected) {
+                    if (failures++ < 10) {
+                        printf("%d places: %lld %c %lld gave %lld (status %d), expected %lld (status %d)\n",
+                               places, (long long) a, operator, (long long) b,
+                               (long long) actual, actualStatus, (long long) expected, expectedStatus);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%ld operations checked over 0-%d places, %ld failures\n", checked, DECIMAL_PLACES_MAX, failures);
+    printf("%ld exact ties, %ld products past 63 bits, %ld dividends past 64 bits\n",
+           benchTies, benchWideProducts, benchWideQuotients);
+
+    // time money-sized operands at the default places, where a double would be the alternative
+    decimal_set_places(DECIMAL_PLACES_DEFAULT);
+
+    for (int i = 0; i < BENCH_TIMED_PAIRS; i++) {
+        benchLeft[i] = (int64_t) (bench_random(&seed) % 100000000) - 50000000;
+        benchRight[i] = (int64_t) (bench_random(&seed) % 1000000) + 1;
+        benchLeftDouble[i] = (double) benchLeft[i] / benchPowers[DECIMAL_PLACES_DEFAULT];
+        benchRightDouble[i] = (double) benchRight[i] / benchPowers[DECIMAL_PLACES_DEFAULT];
+    }
+
+    printf("host cycles per operation at %d places, decimal / double\n", DECIMAL_PLACES_DEFAULT);
+
+    for (int i = 0; i < BENCH_OPERATORS; i++) {
+        printf("  %c  %6llu / %6llu\n", benchOperators[i],
+               (unsigned long long) bench_time(bench_mine, benchOperators[i]),
+               (unsigned long long) bench_time(bench_theirs, benchOperators[i]));
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+// file: bench_entry.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Times the equals key of the accumulating calculator against the old sscanf re-parse
+
+# include <limits.h>
+# include <stdint.h>
+# include <stdio.h>
+# include "calc.h"
+# include "host.h"
+# include "keymap.h"
+# include "lcd_driver.h"
+
+// Benchmark Characteristics
+# define BENCH_RUNS 200000
+
+// Operand Pairs
+// typed as text for the old path and as digit actions for the new one
+static const char * const benchOperands[][2] = {
+    { "7", "3" }, { "1234", "56" }, { "99999", "123" }, { "123456789", "987654321" }, { "500000", "4000" }
+};
+static const char benchOperators[] = { '+', '-', '*', '/' };
+static const int benchActions[] = { ACTION_ADD, ACTION_SUBTRACT, ACTION_MULTIPLY, ACTION_DIVIDE };
+
+// Handles equals the way main did before the accumulator, parsing the whole op string and
+// printing the result twice, once to the LCD and once back into the op string
+// @ param opString - the null terminated first operand, operator, and second operand
+// @ return the result
+static int bench_sscanf_equals(char * opString) {
+
+    int firstOperand;
+    char operatorChar;
+    int secondOperand;
+
+    sscanf(opString, "%d%c%d", &firstOperand, &operatorChar, &secondOperand);
+
+    int result = 0;
+
+    switch (operatorChar) {
+        case '+':
+            if (!((secondOperand > 0 && firstOperand > INT_MAX - secondOperand) ||
+                  (secondOperand < 0 && firstOperand < INT_MIN - secondOperand))) {
+                result = firstOperand + secondOperand;
+            }
+            break;
+        case '-':
+            if (!((secondOperand < 0 && firstOperand > INT_MAX + secondOperand) ||
+                  (secondOperand > 0 && firstOperand < INT_MIN + secondOperand))) {
+                result = firstOperand - secondOperand;
+            }
+            break;
+        case '*':
+            if (!(firstOperand > INT_MAX / secondOperand || firstOperand < INT_MIN / secondOperand)) {
+                result = firstOperand * secondOperand;
+            }
+            break;
+        case '/':
+            if (secondOperand != 0) {
+                result = firstOperand / secondOperand;
+            }
+            break;
+    }
+
+    lcd_cursor_set(0, 0);
+    lcd_printf("%d", result);
+    sprintf(opString, "%d", result);
+
+    return result;
+}
+
+// Types an operand as digit actions
+// @ param digits - the operand's digits
+// @ return void
+static void bench_type(const char * digits) {
+    for (; * digits != '\0'; digits++) {
+        calc_handle(ACTION_DIGIT_0 + (* digits - '0'));
+    }
+}
+
+// Runs the benchmark
+// @ param void
+// @ return 0
+int main(void) {
+
+    host_init();
+    lcd_init();
+    calc_init();
+
+    int pairs = sizeof(benchOperands) / sizeof(benchOperands[0]);
+    uint64_t oldCycles = 0;
+    uint64_t newCycles = 0;
+    volatile int sink = 0;
+
+    for (int run = 0; run < BENCH_RUNS; run++) {
+
+        const char * const * pair = benchOperands[run % pairs];
+        int operator = (run / pairs) % 4;
+
+        // the old path re-parses everything that was typed
+        char opString[33];
+        snprintf(opString, sizeof(opString), "%s%c%s", pair[0], benchOperators[operator], pair[1]);
+
+        uint64_t start = host_cycles();
+        sink += bench_sscanf_equals(opString);
+        oldCycles += host_cycles() - start;
+
+        // the new path already holds both operands when equals is pressed
+        calc_handle(ACTION_CLEAR);
+        bench_type(pair[0]);
+        calc_handle(benchActions[operator]);
+        bench_type(pair[1]);
+
+        start = host_cycles();
+        calc_handle(ACTION_EQUALS);
+        newCycles += host_cycles() - start;
+    }
+
+    printf("equals to result, host cycles per calculation over %d runs\n", BENCH_RUNS);
+    printf("  sscanf re-parse   %8.1f\n", (double) oldCycles / BENCH_RUNS);
+    printf("  accumulator       %8.1f\n", (double) newCycles / BENCH_RUNS);
+    printf("  speedup           %8.2fx\n", (double) oldCycles / newCycles);
+
+    return sink == 0x7FFFFFFF;
+}
@@ -0,0 +1,144 @@
+// file: bench_fmt.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Checks the fmt conversions against sprintf and strtof and prints the kernel cycle benchmarks
+
+# include <inttypes.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "bench.h"
+# include "fmt.h"
+# include "host.h"
+
+// Benchmark Characteristics
+# define BENCH_CHECKS 10000000
+# define BENCH_FLOAT_CHECKS 2000000
+
+// Gets the next value of a 64-bit xorshift generator
+// @ param state - the generator state
+// @ return the next value
+static uint64_t bench_random(uint64_t * state) {
+    * state ^= * state << 13;
+    * state ^= * state >> 7;
+    * state ^= * state << 17;
+    return * state;
+}
+
+// Draws a float, mixing raw bit patterns, whole numbers, and short decimals like the keypad makes
+// @ param state - the generator state
+// @ return a finite float
+static float bench_float(uint64_t * state) {
+
+    uint64_t word = bench_random(state);
+    union { float f; uint32_t u; } pun;
+
+    switch (word & 3) {
+        case 0:
+            pun.u = (uint32_t) (word >> 32);
+            if (((pun.u >> 23) & 0xFF) == 0xFF) {
+                pun.u &= ~(1u << 30);
+            }
+            return pun.f;
+        case 1:
+            return (float) (int32_t) ((word >> 8) % 33554432) - 16777216.0f;
+        case 2:
+            return (float) ((word >> 8) % 100000) / 1000.0f;
+        default:
+            return (float) ((word >> 8) % 1000000) * 1.0e-9f * (float) (1u << ((word >> 40) % 30));
+    }
+}
+
+// Checks a float conversion reads back as the same float with the fewest digits that do
+// @ param value - the float
+// @ return 1 if it does, otherwise 0
+static int bench_check_float(float value) {
+
+    char mine[FMT_FLOAT_SIZE];
+    char theirs[32];
+
+    int length = fmt_float(value, mine, 9);
+    if (length != (int) strlen(mine) || strtof(mine, 0) != value) {
+        printf("fmt_float wrote %s for %.9g\n", mine, (double) value);
+        return 0;
+    }
+
+    // the shortest correctly rounded digits sprintf can give that still read back
+    int precision = 1;
+    for (; precision < 9; precision++) {
+        sprintf(theirs, "%.*g", precision, (double) value);
+        if (strtof(theirs, 0) == value) {
+            break;
+        }
+    }
+    sprintf(theirs, "%.*g", precision, (double) value);
+
+    if (strtod(mine, 0) != strtod(theirs, 0)) {
+        printf("fmt_float wrote %s for %.9g, the shortest is %s\n", mine, (double) value, theirs);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Runs the benchmark
+// @ param void
+// @ return 0 if every conversion matched sprintf, otherwise 1
+int main(void) {
+
+    host_init();
+
+    // every digit count and sign, drawn by shifting random words down a random amount
+    uint64_t seed = 88172645463325252u;
+    long mismatches = 0;
+
+    for (long i = 0; i < BENCH_CHECKS; i++) {
+
+        uint64_t word = bench_random(&seed);
+        int64_t value64 = (int64_t) (word >> (word & 63));
+        int32_t value32 = (int32_t) (value64 >> ((word >> 6) & 31));
+        if (word & (1 << 12)) {
+            value64 = -value64;
+        }
+
+        char mine[FMT_INT64_SIZE];
+        char theirs[32];
+
+        int length = fmt_int32(value32, mine);
+        sprintf(theirs, "%" PRId32, value32);
+        if (length != (int) strlen(theirs) || strcmp(mine, theirs) != 0) {
+            if (mismatches++ < 5) printf("fmt_int32 wrote %s for %s\n", mine, theirs);
+        }
+
+        length = fmt_int64(value64, mine);
+        sprintf(theirs, "%" PRId64, value64);
+        if (length != (int) strlen(theirs) || strcmp(mine, theirs) != 0) {
+            if (mismatches++ < 5) printf("fmt_int64 wrote %s for %s\n", mine, theirs);
+        }
+    }
+
+    printf("%d random values converted, %ld differ from sprintf\n", BENCH_CHECKS, mismatches);
+
+    long floatMismatches = 0;
+
+    for (long i = 0; i < BENCH_FLOAT_CHECKS; i++) {
+        if (!bench_check_float(bench_float(&seed)) && floatMismatches++ >= 5) {
+            break;
+        }
+    }
+
+    printf("%d random floats converted, %ld are not the shortest that reads back\n", BENCH_FLOAT_CHECKS, floatMismatches);
+    mismatches += floatMismatches;
+
+    bench_result_t results[BENCH_RESULTS_MAX];
+    int count = bench_run(results, BENCH_RESULTS_MAX);
+
+    printf("host cycles per call, fastest of 8 rounds\n");
+    for (int i = 0; i < count; i++) {
+        printf("  %-16s %6u\n", results[i].name, results[i].cycles);
+    }
+
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,438 @@
+// file: bench_sci.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Measures the worst error of the float and Q32.32 scientific kernels against libm and
+//              times them against it
+
+# include <float.h>
+# include <math.h>
+# include <stdint.h>
+# include <stdio.h>
+# include "host.h"
+# include "sci.h"
+
+// Benchmark Characteristics
+# define BENCH_SAMPLES 1000000
+# define BENCH_TIMED_SAMPLES 1024
+# define BENCH_ROUNDS 8
+# define BENCH_KERNELS (SCI_FUNCTIONS + 1)
+# define BENCH_POW SCI_FUNCTIONS
+
+// Fixed Point Scale
+# define BENCH_FIXED_SCALE 4294967296.0L
+
+// Applies a kernel to one sample, returning its SCI status
+typedef int (* bench_float_kernel_t)(int function, float x, float y, float * result);
+typedef int (* bench_fixed_kernel_t)(int function, int64_t x, int64_t y, int64_t * result);
+
+// A Sample
+// the arguments of one call, in both formats
+typedef struct {
+    float x;
+    float y;
+    int64_t fixedX;
+    int64_t fixedY;
+} bench_sample_t;
+
+// Error Bounds
+// the worst error each kernel is allowed over the arguments bench_float_sample and bench_fixed_sample
+// draw, f32 in float ulps, q32 in units of 2^-32 and relative to results of 1 or more, with HUGE_VAL
+// where results grow too large for the other measure to mean anything
+typedef struct {
+    double floatUlps;
+    double fixedUnits;
+    double fixedRelative;
+} bench_bound_t;
+
+// Kernel Names
+static const char * const benchNames[BENCH_KERNELS] = { "sqrt", "sin", "cos", "tan", "exp", "ln", "pow" };
+
+// Stated Bounds
+// sqrt rounds correctly, trig is bounded by its table and series once pi / 2 is carried to 96 bits, and
+// the pow error grows with y * ln(x), which the sampled arguments keep under 2^7
+static const bench_bound_t benchBounds[BENCH_KERNELS] = {
+    { 0.51, 1.0, 2e-10 },
+    { 3.0, 2.5, 1e-9 },
+    { 3.0, 2.5, 1e-9 },
+    { 4.0, HUGE_VAL, 1e-8 },
+    { 1.5, HUGE_VAL, 4e-9 },
+    { 1.5, 16.0, 1e-9 },
+    { 128.0, HUGE_VAL, 4e-9 }
+};
+
+// Timed Samples
+// visible outside the file so the compiler cannot drop the work that fills the results
+bench_sample_t benchSamples[BENCH_TIMED_SAMPLES];
+float benchFloatResults[BENCH_TIMED_SAMPLES];
+int64_t benchFixedResults[BENCH_TIMED_SAMPLES];
+
+// Gets the next value of a 64-bit xorshift generator
+// @ param state - the generator state
+// @ return the next value
+static uint64_t bench_random(uint64_t * state) {
+    * state ^= * state << 13;
+    * state ^= * state >> 7;
+    * state ^= * state << 17;
+    return * state;
+}
+
+// Draws a real number uniformly from a range
+// @ param state - the generator state
+// @ param low - the low end
+// @ param high - the high end
+// @ return the number
+static double bench_uniform(uint64_t * state, double low, double high) {
+    return low + (high - low) * (double) (bench_random(state) >> 11) / 9007199254740992.0;
+}
+
+// Draws a real number whose magnitude is spread evenly over a range of powers of two
+// @ param state - the generator state
+// @ param low - the smallest power of two
+// @ param high - the largest power of two
+// @ param isSigned - whether to pick a random sign
+// @ return the number
+static double bench_logarithmic(uint64_t * state, double low, double high, int isSigned) {
+    double magnitude = exp2(bench_uniform(state, low, high));
+    return (isSigned && (bench_random(state) & 1)) ? -magnitude : magnitude;
+}
+
+// Draws the arguments of a float kernel over the domain it is meant for
+// the trig kernels refuse 2^30 and up, so they go just short of it, and exp stops short of the float
+// range at both ends
+// @ param function - the kernel
+// @ param state - the generator state
+// @ param sample - where to store the arguments
+// @ return void
+static void bench_float_sample(int function, uint64_t * state, bench_sample_t * sample) {
+
+    sample->y = 0.0f;
+
+    switch (function) {
+        case SCI_SQRT:
+        case SCI_LN:
+            sample->x = (float) bench_logarithmic(state, -126.0, 127.0, 0);
+            break;
+        case SCI_SIN:
+        case SCI_COS:
+        case SCI_TAN:
+            sample->x = (float) bench_logarithmic(state, -20.0, 29.99, 1);
+            break;
+        case SCI_EXP:
+            sample->x = (float) bench_uniform(state, -87.0, 88.5);
+            break;
+        default:
+            sample->x = (float) bench_logarithmic(state, -12.0, 12.0, 0);
+            sample->y = (float) bench_uniform(state, -8.0, 8.0);
+            break;
+    }
+}
+
+// Draws the arguments of a Q32.32 kernel over the domain it is meant for
+// every result must fit 32 integer bits, so exp and pow stay below 2^31 and ln above 2^-32
+// @ param function - the kernel
+// @ param state - the generator state
+// @ param sample - where to store the arguments
+// @ return void
+static void bench_fixed_sample(int function, uint64_t * state, bench_sample_t * sample) {
+
+    long double x;
+    long double y = 0.0L;
+
+    switch (function) {
+        case SCI_SQRT:
+        case SCI_LN:
+            x = bench_logarithmic(state, -31.0, 30.9, 0);
+            break;
+        case SCI_SIN:
+        case SCI_COS:
+            x = bench_logarithmic(state, -20.0, 29.99, 1);
+            break;
+        case SCI_TAN:
+            x = bench_uniform(state, -1.5, 1.5);
+            break;
+        case SCI_EXP:
+            x = bench_uniform(state, -22.0, 21.4);
+            break;
+        default:
+            x = bench_logarithmic(state, -4.0, 4.0, 0);
+            y = bench_uniform(state, -4.0, 4.0);
+            break;
+    }
+
+    sample->fixedX = (int64_t) (x * BENCH_FIXED_SCALE);
+    sample->fixedY = (int64_t) (y * BENCH_FIXED_SCALE);
+}
+
+// Applies a float kernel
+// @ param function - the kernel
+// @ param x - the argument or base
+// @ param y - the exponent, for pow
+// @ param result - where to store the result
+// @ return the SCI status
+static int bench_float_mine(int function, float x, float y, float * result) {
+    return function == BENCH_POW ? sci_float_pow(x, y, result) : sci_float(function, x, result);
+}
+
+// Applies libm in single precision, the alternative the float kernels replace
+// @ param function - the kernel
+// @ param x - the argument or base
+// @ param y - the exponent, for pow
+// @ param result - where to store the result
+// @ return SCI_OK
+static int bench_float_theirs(int function, float x, float y, float * result) {
+
+    switch (function) {
+        case SCI_SQRT: * result = sqrtf(x); break;
+        case SCI_SIN: * result = sinf(x); break;
+        case SCI_COS: * result = cosf(x); break;
+        case SCI_TAN: * result = tanf(x); break;
+        case SCI_EXP: * result = expf(x); break;
+        case SCI_LN: * result = logf(x); break;
+        default: * result = powf(x, y); break;
+    }
+
+    return SCI_OK;
+}
+
+// Applies a Q32.32 kernel
+// @ param function - the kernel
+// @ param x - the argument or base
+// @ param y - the exponent, for pow
+// @ param result - where to store the result
+// @ return the SCI status
+static int bench_fixed_mine(int function, int64_t x, int64_t y, int64_t * result) {
+    return function == BENCH_POW ? sci_fixed_pow(x, y, result) : sci_fixed(function, x, result);
+}
+
+// Computes the exact value a kernel approximates
+// @ param function - the kernel
+// @ param x - the argument or base
+// @ param y - the exponent, for pow
+// @ return the value
+static long double bench_reference(int function, long double x, long double y) {
+
+    switch (function) {
+        case SCI_SQRT: return sqrtl(x);
+        case SCI_SIN: return sinl(x);
+        case SCI_COS: return cosl(x);
+        case SCI_TAN: return tanl(x);
+        case SCI_EXP: return expl(x);
+        case SCI_LN: return logl(x);
+        default: return powl(x, y);
+    }
+}
+
+// Gets the spacing of floats around a value, the unit a float result's error is measured in
+// @ param value - the exact value
+// @ return the distance between the two floats around it, subnormal spacing below FLT_MIN
+static double bench_float_ulp(double value) {
+
+    int exponent;
+    frexp(value, &exponent);
+
+    // a float holds 24 significant bits, so the last one weighs 2^(exponent - 24)
+    if (exponent - 24 < FLT_MIN_EXP - 24) {
+        return ldexp(1.0, FLT_MIN_EXP - 24);
+    }
+
+    return ldexp(1.0, exponent - 24);
+}
+
+// Finds the worst float kernel error, in float ulps of the libm value rounded to double
+// a result libm puts past the float range is skipped, and a refusal inside it counts as a failure
+// @ param function - the kernel
+// @ param state - the generator state
+// @ param worst - where to store the sample that gave the worst error
+// @ param failures - the number of refusals, added to
+// @ return the worst error
+static double bench_float_error(int function, uint64_t * state, bench_sample_t * worst, long * failures) {
+
+    double maximum = 0.0;
+
+    for (long i = 0; i < BENCH_SAMPLES; i++) {
+
+        bench_sample_t sample;
+        bench_float_sample(function, state, &sample);
+
+        double expected = (double) bench_reference(function, sample.x, sample.y);
+        if (!isfinite(expected) || fabs(expected) > FLT_MAX) {
+            continue;
+        }
+
+        float actual;
+        if (bench_float_mine(function, sample.x, sample.y, &actual) != SCI_OK) {
+            if ((* failures)++ < 10) {
+                printf("  %s f32 refused %.9g %.9g\n", benchNames[function], sample.x, sample.y);
+            }
+            continue;
+        }
+
+        double error = fabs((double) actual - expected) / bench_float_ulp(expected);
+
+        if (error > maximum) {
+            maximum = error;
+            * worst = sample;
+        }
+    }
+
+    return maximum;
+}
+
+// Finds the worst Q32.32 kernel error, in units of the last place, 2^-32, and relative to the result,
+// which says more where a large result keeps fewer of its bits than it has
+// double holds too few bits for a 63-bit result, so the reference is libm in long double
+// @ param function - the kernel
+// @ param state - the generator state
+// @ param worst - where to store the sample that gave the worst error
+// @ param relative - where to store the worst relative error
+// @ param failures - the number of refusals, added to
+// @ return the worst error
+static double bench_fixed_error(int function, uint64_t * state, bench_sample_t * worst, double * relative,
+                                long * failures) {
+
+    long double maximum = 0.0L;
+    long double maximumRelative = 0.0L;
+
+    for (long i = 0; i < BENCH_SAMPLES; i++) {
+
+        bench_sample_t sample;
+        bench_fixed_sample(function, state, &sample);
+
+        // every Q32.32 value is exact in a 64-bit long double significand
+        long double x = sample.fixedX / BENCH_FIXED_SCALE;
+        long double y = sample.fixedY / BENCH_FIXED_SCALE;
+        long double expected = bench_reference(function, x, y) * BENCH_FIXED_SCALE;
+
+        // a result past the format is refused by design
+        if (fabsl(expected) >= 0x1p62L) {
+            continue;
+        }
+
+        int64_t actual;
+        if (bench_fixed_mine(function, sample.fixedX, sample.fixedY, &actual) != SCI_OK) {
+            if ((* failures)++ < 10) {
+                printf("  %s q32 refused %.12Lg %.12Lg\n", benchNames[function], x, y);
+            }
+            continue;
+        }
+
+        long double error = fabsl((long double) actual - expected);
+
+        if (error > maximum) {
+            maximum = error;
+            * worst = sample;
+        }
+
+        // results of a few units carry only a few bits, so only those of 1 or more count here
+        if (fabsl(expected) >= BENCH_FIXED_SCALE && error / fabsl(expected) > maximumRelative) {
+            maximumRelative = error / fabsl(expected);
+        }
+    }
+
+    * relative = (double) maximumRelative;
+
+    return (double) maximum;
+}
+
+// Times a float kernel over the timed samples
+// @ param kernel - the kernel
+// @ param function - the function it applies
+// @ return the fewest cycles per call over BENCH_ROUNDS passes, so an interrupt landing in one does not count
+static uint64_t bench_time_float(bench_float_kernel_t kernel, int function) {
+
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+
+        uint64_t start = host_cycles();
+        for (int i = 0; i < BENCH_TIMED_SAMPLES; i++) {
+            kernel(function, benchSamples[i].x, benchSamples[i].y, &benchFloatResults[i]);
+        }
+        uint64_t cycles = host_cycles() - start;
+
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+
+    return best / BENCH_TIMED_SAMPLES;
+}
+
+// Times a Q32.32 kernel over the timed samples
+// @ param kernel - the kernel
+// @ param function - the function it applies
+// @ return the fewest cycles per call over BENCH_ROUNDS passes
+static uint64_t bench_time_fixed(bench_fixed_kernel_t kernel, int function) {
+
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+
+        uint64_t start = host_cycles();
+        for (int i = 0; i < BENCH_TIMED_SAMPLES; i++) {
+            kernel(function, benchSamples[i].fixedX, benchSamples[i].fixedY, &benchFixedResults[i]);
+        }
+        uint64_t cycles = host_cycles() - start;
+
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+
+    return best / BENCH_TIMED_SAMPLES;
+}
+
+// Runs the benchmark
+// @ param void
+// @ return 0 if no kernel refused an argument inside its domain or went past its stated bound, otherwise 1
+int main(void) {
+
+    host_init();
+
+    uint64_t seed = 0x9E3779B97F4A7C15u;
+    long failures = 0;
+
+    printf("worst error over %d samples, f32 in float ulps, q32 in units of 2^-32 and relative to results of 1 or more\n",
+           BENCH_SAMPLES);
+
+    for (int function = 0; function < BENCH_KERNELS; function++) {
+
+        bench_sample_t floatWorst = { 0 };
+        bench_sample_t fixedWorst = { 0 };
+        double floatError = bench_float_error(function, &seed, &floatWorst, &failures);
+        double fixedRelative;
+        double fixedError = bench_fixed_error(function, &seed, &fixedWorst, &fixedRelative, &failures);
+
+        printf("  %-4s  f32 %8.2f at %-15.9g  q32 %13.2f at %-15.9g  %.2e\n", benchNames[function],
+               floatError, floatWorst.x, fixedError, (double) fixedWorst.fixedX / SCI_FIXED_ONE, fixedRelative);
+
+        const bench_bound_t * bound = &benchBounds[function];
+
+        if (floatError > bound->floatUlps || fixedError > bound->fixedUnits || fixedRelative > bound->fixedRelative) {
+            printf("  %-4s  past its bound of f32 %.2f, q32 %.2f and %.2e\n", benchNames[function],
+                   bound->floatUlps, bound->fixedUnits, bound->fixedRelative);
+            failures++;
+        }
+    }
+
+    printf("%ld arguments refused inside their domain or kernels past their bound\n", failures);
+    printf("host cycles per call, f32 / libm f32 / q32\n");
+
+    for (int function = 0; function < BENCH_KERNELS; function++) {
+
+        for (int i = 0; i < BENCH_TIMED_SAMPLES; i++) {
+            bench_float_sample(function, &seed, &benchSamples[i]);
+            bench_fixed_sample(function, &seed, &benchSamples[i]);
+        }
+
+        uint64_t mine = bench_time_float(bench_float_mine, function);
+        uint64_t theirs = bench_time_float(bench_float_theirs, function);
+        uint64_t fixed = bench_time_fixed(bench_fixed_mine, function);
+
+        printf("  %-4s  %6llu / %6llu / %6llu\n", benchNames[function],
+               (unsigned long long) mine, (unsigned long long) theirs, (unsigned long long) fixed);
+    }
+
+    return failures ? 1 : 0;
+}
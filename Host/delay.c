@@ -0,0 +1,20 @@
+// file: delay.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the host stand-in for the SysTick delays, which return at once
+
+# include "delay.h"
+
+// Delays for some number of milliseconds
+// the stand-in LCD needs no time to settle, so host builds do not wait
+// @ param milliseconds - the number of milliseconds to delay for
+// @ return void
+void delay_ms(int milliseconds) {
+}
+
+// Delays for some number of microseconds
+// @ param microseconds - the number of microseconds to delay for
+// @ return void
+void delay_us(int microseconds) {
+}
@@ -0,0 +1,175 @@
+// file: flash.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the host stand-in for the flash driver, backed by a file-mapped flash image
+
+# include <fcntl.h>
+# include <stdint.h>
+# include <stdlib.h>
+# include <string.h>
+# include <sys/mman.h>
+# include <unistd.h>
+# include "flash.h"
+# include "host.h"
+
+// Flash Memory
+// the image is mapped where the STM32F446 maps its flash, so storage.c reads it at the same addresses
+# define FLASH_MEMORY_BASE 0x08000000
+# define FLASH_MEMORY_SIZE 0x80000
+
+static const uint32_t flashSectorSizes[FLASH_SECTORS] = {
+    0x4000, 0x4000, 0x4000, 0x4000, 0x10000, 0x20000, 0x20000, 0x20000
+};
+
+// Power Loss
+// every programmed word and erased sector is one operation, and the one the budget runs out on is
+// left half done before the handler is called
+static long flashOperations = 0;
+static long flashBudget = -1;
+static void (* flashLost)(void) = 0;
+
+// Static Function Prototypes
+static void flash_operation(void);
+
+// Opens a file as the flash image and maps it over the flash memory
+// a new image starts erased, an existing one keeps what the last run left in it
+// @ param path - the image file
+// @ return FLASH_OK, or FLASH_ERROR if the file could not be opened or mapped
+int host_flash_open(const char * path) {
+
+    int file = open(path, O_RDWR | O_CREAT, 0644);
+
+    if (file < 0) {
+        return FLASH_ERROR;
+    }
+
+    off_t size = lseek(file, 0, SEEK_END);
+
+    if (size != FLASH_MEMORY_SIZE && ftruncate(file, FLASH_MEMORY_SIZE) != 0) {
+        close(file);
+        return FLASH_ERROR;
+    }
+
+    void * image = mmap((void *) FLASH_MEMORY_BASE, FLASH_MEMORY_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_FIXED, file, 0);
+    close(file);
+
+    if (image == MAP_FAILED) {
+        return FLASH_ERROR;
+    }
+
+    if (size != FLASH_MEMORY_SIZE) {
+        memset(image, 0xFF, FLASH_MEMORY_SIZE);
+    }
+
+    flashOperations = 0;
+
+    return FLASH_OK;
+}
+
+// Starts counting flash operations and cuts the power when the count runs out
+// @ param operations - how many more operations complete, or -1 to never cut the power
+// @ param lost - the function called when the power is cut, which must not return
+// @ return void
+void host_flash_power_loss(long operations, void (* lost)(void)) {
+    flashBudget = operations;
+    flashLost = lost;
+}
+
+// Gets the number of words programmed and sectors erased since the image was opened
+// @ param void
+// @ return the operation count
+long host_flash_operations(void) {
+    return flashOperations;
+}
+
+// Gets the memory-mapped address a flash sector starts at
+// @ param sector - the sector, 0-7
+// @ return the address of the sector's first word
+const uint32_t * flash_sector_address(int sector) {
+
+    uintptr_t address = FLASH_MEMORY_BASE;
+
+    for (int i = 0; i < sector; i++) {
+        address += flashSectorSizes[i];
+    }
+
+    return (const uint32_t *) address;
+}
+
+// Gets the size of a flash sector in bytes
+// @ param sector - the sector, 0-7
+// @ return the size of the sector
+uint32_t flash_sector_size(int sector) {
+    return flashSectorSizes[sector];
+}
+
+// Erases a flash sector to all ones
+// a cut erase leaves a random half of the sector's words erased
+// @ param sector - the sector, 0-7
+// @ return FLASH_OK, or FLASH_ERROR if the sector is out of range
+int flash_erase_sector(int sector) {
+
+    if (sector < 0 || sector >= FLASH_SECTORS) {
+        return FLASH_ERROR;
+    }
+
+    uint32_t * words = (uint32_t *) flash_sector_address(sector);
+    int count = flashSectorSizes[sector] / sizeof(uint32_t);
+
+    if (flashBudget == 0) {
+        for (int i = 0; i < count; i++) {
+            if (rand() & 1) {
+                words[i] = 0xFFFFFFFF;
+            }
+        }
+        flash_operation();
+    }
+
+    memset(words, 0xFF, flashSectorSizes[sector]);
+    flash_operation();
+
+    return FLASH_OK;
+}
+
+// Programs words into erased flash
+// like NOR flash, programming can only clear bits, and a cut program clears a random part of them
+// @ param address - the word-aligned flash address of the first word
+// @ param words - the words to program
+// @ param count - the number of words to program
+// @ return FLASH_OK
+int flash_program(const uint32_t * address, const uint32_t * words, int count) {
+
+    volatile uint32_t * cell = (volatile uint32_t *) address;
+
+    for (int i = 0; i < count; i++) {
+
+        if (flashBudget == 0) {
+            cell[i] &= words[i] | (uint32_t) rand();
+            flash_operation();
+        }
+
+        cell[i] &= words[i];
+        flash_operation();
+    }
+
+    return FLASH_OK;
+}
+
+// Counts a flash operation and cuts the power if the budget has run out
+// @ param void
+// @ return void
+static void flash_operation(void) {
+
+    if (flashBudget == 0) {
+        flashBudget = -1;
+        flashLost();
+    }
+
+    if (flashBudget > 0) {
+        flashBudget--;
+    }
+
+    flashOperations++;
+}
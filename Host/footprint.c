@@ -0,0 +1,63 @@
+// file: footprint.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Handles one calculation both ways for the target, to compare what each pulls into flash
+//
+// make footprint links this once with FOOTPRINT_SSCANF, parsing the op string with sscanf and
+// printing with sprintf as main used to, and once accumulating digits and printing with fmt.c
+
+# include <stdint.h>
+# include "fmt.h"
+
+# if defined(FOOTPRINT_SSCANF)
+# include <stdio.h>
+# endif
+
+// Typed Keys
+// volatile so neither build can fold the calculation away
+static volatile char footprintKeys[] = "12345+678";
+
+// Handles the keys and equals
+// @ param void
+// @ return the first character of the result
+int main(void) {
+
+    char opString[33];
+
+# if defined(FOOTPRINT_SSCANF)
+
+    int length = 0;
+    while (footprintKeys[length] != '\0') {
+        opString[length] = footprintKeys[length];
+        length++;
+    }
+    opString[length] = '\0';
+
+    int first;
+    char operator;
+    int second;
+    sscanf(opString, "%d%c%d", &first, &operator, &second);
+    sprintf(opString, "%d", (operator == '+') ? first + second : first - second);
+
+# else
+
+    int32_t operands[2] = { 0, 0 };
+    int index = 0;
+    char operator = 0;
+
+    for (int i = 0; footprintKeys[i] != '\0'; i++) {
+        if (footprintKeys[i] >= '0' && footprintKeys[i] <= '9') {
+            operands[index] = operands[index] * 10 + (footprintKeys[i] - '0');
+        } else {
+            operator = footprintKeys[i];
+            index = 1;
+        }
+    }
+
+    fmt_int32((operator == '+') ? operands[0] + operands[1] : operands[0] - operands[1], opString);
+
+# endif
+
+    return opString[0];
+}
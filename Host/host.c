@@ -0,0 +1,62 @@
+// file: host.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the host stand-in for the STM32F446 register windows used by the tests and benchmarks
+
+# include <stdint.h>
+# include <stdio.h>
+# include <stdlib.h>
+# include <sys/mman.h>
+# include <time.h>
+# include "host.h"
+
+// Register Windows
+// the APB and AHB1 peripherals from TIM2 to the flash interface, and the private peripheral bus
+# define HOST_PERIPHERAL_BASE 0x40000000
+# define HOST_PERIPHERAL_SIZE 0x24000
+# define HOST_CORE_BASE 0xE0000000
+# define HOST_CORE_SIZE 0x10000
+
+// Static Function Prototypes
+static void host_map(uintptr_t base, size_t size);
+
+// Maps memory over the peripheral and core register windows so the drivers run unmodified
+// the registers read back whatever was last written to them, so nothing polls a status bit
+// that a peripheral would have to set
+// @ param void
+// @ return void
+void host_init(void) {
+    host_map(HOST_PERIPHERAL_BASE, HOST_PERIPHERAL_SIZE);
+    host_map(HOST_CORE_BASE, HOST_CORE_SIZE);
+}
+
+// Reads a cycle counter for benchmarks
+// x86 hosts count reference cycles, anything else falls back to nanoseconds
+// @ param void
+// @ return the counter value
+uint64_t host_cycles(void) {
+
+# if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+# else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+# endif
+}
+
+// Maps zeroed memory at a fixed address, exiting if the host has something there already
+// @ param base - the address of the window
+// @ param size - the size of the window in bytes
+// @ return void
+static void host_map(uintptr_t base, size_t size) {
+
+    void * window = mmap((void *) base, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (window == MAP_FAILED || window != (void *) base) {
+        fprintf(stderr, "host: cannot map the register window at 0x%08lx\n", (unsigned long) base);
+        exit(1);
+    }
+}
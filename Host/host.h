@@ -0,0 +1,36 @@
+// file: host.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for host.c
+
+# ifndef HOST_H
+# define HOST_H
+
+# include <stdint.h>
+
+// Maps memory over the peripheral and core register windows so the drivers run unmodified
+void host_init(void);
+
+// Gets the characters a row of the stand-in LCD shows
+const char * host_lcd_row(int y);
+
+// Gets the column and row of the stand-in LCD's cursor
+void host_lcd_cursor(int * x, int * y);
+
+// Gets the number of characters written to the stand-in LCD
+uint32_t host_lcd_writes(void);
+
+// Opens a file as the flash image and maps it over the flash memory
+int host_flash_open(const char * path);
+
+// Starts counting flash operations and cuts the power when the count runs out
+void host_flash_power_loss(long operations, void (* lost)(void));
+
+// Gets the number of words programmed and sectors erased since the image was opened
+long host_flash_operations(void);
+
+// Reads a cycle counter for benchmarks
+uint64_t host_cycles(void);
+
+# endif
@@ -0,0 +1,209 @@
+// file: lcd_driver.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the host stand-in for the LCD driver, which keeps the display as text to inspect
+
+# include <stdarg.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <string.h>
+# include "host.h"
+# include "latency.h"
+# include "lcd_driver.h"
+
+// LCD Characteristics
+# define LCD_ROWS 2
+# define LCD_ROW_LENGTH 40
+# define LCD_INSTRUCTION_US_DEFAULT 37
+# define LCD_CLEAR_US_DEFAULT 1520
+
+// Display
+// each row is kept terminated so tests can compare it as a string
+static char lcdRows[LCD_ROWS][LCD_ROW_LENGTH + 1];
+static int lcdCursorX;
+static int lcdCursorY;
+static uint32_t lcdWrites;
+
+// Timing State
+static int lcdInstructionUs = LCD_INSTRUCTION_US_DEFAULT;
+static int lcdClearUs = LCD_CLEAR_US_DEFAULT;
+
+// Static Function Prototypes
+static void lcd_write_char(char character);
+
+// Initializes the LCD
+// @ param void
+// @ return void
+void lcd_init(void) {
+    lcd_clear();
+}
+
+// Clears the display of the LCD
+// @ param void
+// @ return void
+void lcd_clear(void) {
+
+    for (int y = 0; y < LCD_ROWS; y++) {
+        memset(lcdRows[y], ' ', LCD_ROW_LENGTH);
+        lcdRows[y][LCD_ROW_LENGTH] = '\0';
+    }
+
+    lcdCursorX = 0;
+    lcdCursorY = 0;
+}
+
+// Moves the cursor back to its home position
+// @ param void
+// @ return void
+void lcd_cursor_home(void) {
+    lcdCursorX = 0;
+    lcdCursorY = 0;
+}
+
+// Sets the cursor to a specific (x, y) position on the LCD
+// @ param x - the zero-based x-position
+// @ param y - the zero-based y-position
+// @ return void
+void lcd_cursor_set(int x, int y) {
+    lcdCursorX = x;
+    lcdCursorY = y;
+}
+
+// Shows the blinking cursor on the LCD
+// @ param void
+// @ return void
+void lcd_cursor_show(void) {
+}
+
+// Hides the blinking cursor on the LCD
+// @ param void
+// @ return void
+void lcd_cursor_hide(void) {
+}
+
+// Prints a formatted string to the LCD
+// @ param format - the format string, followed by its arguments
+// @ return void
+void lcd_printf(const char * format, ...) {
+
+    char buffer[LCD_ROWS * LCD_ROW_LENGTH + 1];
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    lcd_write(buffer, (length < (int) sizeof(buffer)) ? length : (int) sizeof(buffer) - 1);
+}
+
+// Writes a buffer of known length to the LCD
+// @ param buffer - the characters to write
+// @ param length - the number of characters to write
+// @ return void
+void lcd_write(const char * buffer, int length) {
+    for (int i = 0; i < length; i++) {
+        lcd_write_char(buffer[i]);
+    }
+}
+
+// Writes a buffer of known length to a position on the LCD, skipping the characters it already shows
+// @ param x - the zero-based x-position of the first character
+// @ param y - the zero-based y-position of the first character
+// @ param buffer - the characters to write
+// @ param length - the number of characters to write
+// @ return void
+void lcd_update(int x, int y, const char * buffer, int length) {
+
+    for (int i = 0; i < length; i++) {
+        if (lcdRows[y][x + i] != buffer[i]) {
+            lcd_cursor_set(x + i, y);
+            lcd_write_char(buffer[i]);
+        }
+    }
+}
+
+// Writes a character to a position on the LCD if it shows a different one, leaving the cursor where it was
+// @ param x - the zero-based x-position of the character
+// @ param y - the zero-based y-position of the character
+// @ param character - the character to write
+// @ return void
+void lcd_update_cell(int x, int y, char character) {
+
+    int cursorX = lcdCursorX;
+    int cursorY = lcdCursorY;
+
+    if (lcdRows[y][x] != character) {
+        lcd_cursor_set(x, y);
+        lcd_write_char(character);
+        lcd_cursor_set(cursorX, cursorY);
+    }
+}
+
+// Sets how long the LCD is given to finish each instruction
+// @ param instructionUs - microseconds for writes and most instructions, at least 37
+// @ param clearUs - microseconds for clearing the display and returning home, at least 1520
+// @ return void
+void lcd_set_timing(int instructionUs, int clearUs) {
+
+    if (instructionUs < LCD_INSTRUCTION_US_DEFAULT || clearUs < LCD_CLEAR_US_DEFAULT) {
+        return;
+    }
+
+    lcdInstructionUs = instructionUs;
+    lcdClearUs = clearUs;
+}
+
+// Gets how long the LCD is given to finish a write or most instructions
+// @ param void
+// @ return the time in microseconds
+int lcd_get_instruction_us(void) {
+    return lcdInstructionUs;
+}
+
+// Gets how long the LCD is given to clear the display or return home
+// @ param void
+// @ return the time in microseconds
+int lcd_get_clear_us(void) {
+    return lcdClearUs;
+}
+
+// Gets the characters a row of the stand-in LCD shows
+// @ param y - the zero-based row
+// @ return the row, terminated after its last column
+const char * host_lcd_row(int y) {
+    return lcdRows[y];
+}
+
+// Gets the column and row of the stand-in LCD's cursor
+// @ param x - where to store the zero-based column
+// @ param y - where to store the zero-based row
+// @ return void
+void host_lcd_cursor(int * x, int * y) {
+    * x = lcdCursorX;
+    * y = lcdCursorY;
+}
+
+// Gets the number of characters written to the stand-in LCD
+// @ param void
+// @ return the write count since the program started
+uint32_t host_lcd_writes(void) {
+    return lcdWrites;
+}
+
+// Writes a character at the cursor and moves the cursor right, as the controller does
+// a write past the end of a row lands on the next row, like the controller's DDRAM addressing
+// @ param character - the character to write
+// @ return void
+static void lcd_write_char(char character) {
+
+    if (lcdCursorX >= LCD_ROW_LENGTH) {
+        lcdCursorX = 0;
+        lcdCursorY = (lcdCursorY + 1) % LCD_ROWS;
+    }
+
+    lcdRows[lcdCursorY][lcdCursorX++] = character;
+    lcdWrites++;
+
+    latency_mark_output();
+}
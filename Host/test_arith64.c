@@ -0,0 +1,187 @@
+// file: test_arith64.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Checks the integer arithmetic of both word sizes against 128-bit reference arithmetic
+//              over millions of random operand pairs
+
+# include <stdint.h>
+# include <stdio.h>
+# include "arith.h"
+# include "host.h"
+
+// Test Characteristics
+# define TEST_PAIRS 4000000
+# define TEST_OPERATORS 11
+
+// Operators
+static const char testOperators[TEST_OPERATORS] = { '+', '-', '*', '/', '%', '^', '&', '|', 'x', '<', '>' };
+
+// Edge Values
+// the values most likely to break an overflow check, narrowed to the word when it is 32 bits
+static const int64_t testEdges[] = {
+    0, 1, -1, 2, -2, INT64_MAX, INT64_MIN, INT64_MAX - 1, INT64_MIN + 1,
+    INT32_MAX, INT32_MIN, INT32_MAX - 1, INT32_MIN + 1, 3037000499, -3037000499, 3037000500, 46340, 46341
+};
+
+// Gets the next value of a 64-bit xorshift generator
+// @ param state - the generator state
+// @ return the next value
+static uint64_t test_random(uint64_t * state) {
+    * state ^= * state << 13;
+    * state ^= * state >> 7;
+    * state ^= * state << 17;
+    return * state;
+}
+
+// Draws an operand, mixing full-width values, values of random width, edge values, and small values
+// @ param type - the word size
+// @ param state - the generator state
+// @ return the operand, within the word size
+static int64_t test_operand(int type, uint64_t * state) {
+
+    uint64_t value = test_random(state);
+    int64_t operand;
+
+    switch (value & 3) {
+        case 0:
+            operand = (int64_t) test_random(state);
+            break;
+        case 1:
+            operand = (int64_t) (test_random(state) >> (value >> 2) % 64);
+            operand = (value & 0x100) ? -operand : operand;
+            break;
+        case 2:
+            operand = testEdges[(value >> 2) % (sizeof(testEdges) / sizeof(testEdges[0]))];
+            break;
+        default:
+            operand = (int64_t) ((value >> 2) % 141) - 70;
+            break;
+    }
+
+    return type == ARITH_TYPE_INT32 ? (int32_t) operand : operand;
+}
+
+// Computes what an operator should give, in 128 bits so that nothing can overflow unnoticed
+// @ param type - the word size
+// @ param operator - the operator
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the result
+// @ return the expected arith status
+static int test_reference(int type, char operator, int64_t a, int64_t b, int64_t * result) {
+
+    int bits = type == ARITH_TYPE_INT32 ? 32 : 64;
+    __int128 max = type == ARITH_TYPE_INT32 ? INT32_MAX : INT64_MAX;
+    __int128 min = -max - 1;
+    __int128 wide;
+
+    switch (operator) {
+
+        case '+': wide = (__int128) a + b; break;
+        case '-': wide = (__int128) a - b; break;
+        case '*': wide = (__int128) a * b; break;
+
+        case '/':
+        case '%':
+            if (b == 0) {
+                return ARITH_ERROR_DIVIDE;
+            }
+            wide = operator == '/' ? (__int128) a / b : (__int128) a % b;
+            break;
+
+        case '^':
+            if (b < 0) {
+                if (a == 0) {
+                    return ARITH_ERROR_DIVIDE;
+                }
+                wide = a == 1 ? 1 : a == -1 ? ((b & 1) ? -1 : 1) : 0;
+                break;
+            }
+            if (a == 0 || a == 1 || a == -1) {
+                wide = b == 0 ? 1 : a == -1 && !(b & 1) ? 1 : a;
+                break;
+            }
+            // any other base leaves the word within 64 multiplications
+            wide = 1;
+            for (int64_t i = 0; i < b; i++) {
+                wide *= a;
+                if (wide > max || wide < min) {
+                    return ARITH_ERROR_OVERFLOW;
+                }
+            }
+            break;
+
+        case '&': wide = a & b; break;
+        case '|': wide = a | b; break;
+        case 'x': wide = a ^ b; break;
+
+        case '<':
+        case '>': {
+            if (b < 0 || b >= bits) {
+                return ARITH_ERROR_DOMAIN;
+            }
+            uint64_t mask = bits == 32 ? UINT32_MAX : UINT64_MAX;
+            uint64_t word = (uint64_t) a & mask;
+            word = (operator == '<' ? word << b : word >> b) & mask;
+            wide = bits == 32 ? (int32_t) word : (int64_t) word;
+            break;
+        }
+
+        default:
+            return ARITH_ERROR_OVERFLOW;
+    }
+
+    if (wide > max || wide < min) {
+        return ARITH_ERROR_OVERFLOW;
+    }
+
+    * result = (int64_t) wide;
+
+    return ARITH_OK;
+}
+
+// Runs the test
+// @ param void
+// @ return 0 if every result matched the reference, otherwise 1
+int main(void) {
+
+    host_init();
+
+    uint64_t seed = 0x2545F4914F6CDD1Du;
+    long checked = 0;
+    long failures = 0;
+
+    for (int type = ARITH_TYPE_INT32; type <= ARITH_TYPE_INT64; type++) {
+        for (long pair = 0; pair < TEST_PAIRS; pair++) {
+
+            int64_t a = test_operand(type, &seed);
+            int64_t b = test_operand(type, &seed);
+
+            for (int i = 0; i < TEST_OPERATORS; i++) {
+
+                char operator = testOperators[i];
+
+                // a result left untouched on error shows up as the sentinel
+                int64_t expected = INT64_MIN;
+                int64_t actual = INT64_MIN;
+                int expectedStatus = test_reference(type, operator, a, b, &expected);
+                int actualStatus = arith_int(type, operator, a, b, &actual);
+
+                checked++;
+
+                if (actualStatus != expectedStatus || actual != expected) {
+                    if (failures++ < 10) {
+                        printf("int%d %lld %c %lld gave %lld (status %d), expected %lld (status %d)\n",
+                               type == ARITH_TYPE_INT32 ? 32 : 64, (long long) a, operator, (long long) b,
+                               (long long) actual, actualStatus, (long long) expected, expectedStatus);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%ld operations checked, %ld failures\n", checked, failures);
+
+    return failures ? 1 : 0;
+}
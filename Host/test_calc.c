@@ -0,0 +1,383 @@
+// file: test_calc.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Sends every action through the calculator in every state and checks the display it leaves
+
+# include <stdint.h>
+# include <stdio.h>
+# include <string.h>
+# include "calc.h"
+# include "host.h"
+# include "keymap.h"
+# include "lcd_driver.h"
+
+// Test Characteristics
+# define TEST_LCD_ROWS 2
+# define TEST_LCD_COLUMNS 40
+# define TEST_CALC_COLUMNS 16
+# define TEST_MEMORY_ROW 1
+# define TEST_MEMORY_COLUMN 14
+# define TEST_WALK_STEPS 200000
+# define TEST_FILL_PAIRS 120
+
+// A Calculator Configuration
+// the mode, entry, and base that together select a state of the transition table
+typedef struct {
+    int mode;
+    int rpn;
+    int base;
+} test_config_t;
+
+// An Expected Display
+// keys typed into a configuration and the text a field of the display should then show
+typedef struct {
+    test_config_t config;
+    const char * keys;
+    const char * expected;
+} test_display_t;
+
+// An Expected Stack View
+// keys typed into a configuration and the value columns of both rows they should then show
+typedef struct {
+    test_config_t config;
+    const char * keys;
+    const char * rows[TEST_LCD_ROWS];
+} test_stack_t;
+
+// Configurations
+// every infix and stack state, and the bitwise states the 32 and 64-bit modes take in another base
+static const test_config_t testConfigs[] = {
+    { CALC_MODE_INT, 0, 10 }, { CALC_MODE_INT64, 0, 10 }, { CALC_MODE_FLOAT, 0, 10 },
+    { CALC_MODE_DECIMAL, 0, 10 }, { CALC_MODE_BIG, 0, 10 },
+    { CALC_MODE_INT, 1, 10 }, { CALC_MODE_INT64, 1, 10 }, { CALC_MODE_FLOAT, 1, 10 },
+    { CALC_MODE_DECIMAL, 1, 10 }, { CALC_MODE_BIG, 1, 10 },
+    { CALC_MODE_INT, 0, 16 }, { CALC_MODE_INT64, 0, 16 }, { CALC_MODE_INT, 1, 16 }, { CALC_MODE_INT64, 1, 16 }
+};
+
+// Prefixes
+// what the calculator holds when the swept actions arrive: nothing, an operand, a pending operator,
+// open parentheses, a result, and an error, plus the full expression text filled in at run time
+static const char * const testPrefixes[] = { "", "12", "12+", "((1", "7*6=", "1/0=", "2.5s" };
+
+static char testFill[2 * TEST_FILL_PAIRS + 1];
+
+// Expected Displays
+// a few calculations in each mode, with results checked from the keys up
+static const test_display_t testDisplays[] = {
+    { { CALC_MODE_INT, 0, 10 }, "7*6=", "42" },
+    { { CALC_MODE_INT, 0, 10 }, "2+3*4=", "14" },
+    { { CALC_MODE_INT, 0, 10 }, "(2+3)*4=", "20" },
+    { { CALC_MODE_INT, 0, 10 }, "7/2=", "3" },
+    { { CALC_MODE_INT, 0, 10 }, "2^10=", "1024" },
+    { { CALC_MODE_INT, 0, 10 }, "1/0=", "Error" },
+    { { CALC_MODE_INT64, 0, 10 }, "3000000000*3=", "9000000000" },
+    { { CALC_MODE_INT64, 0, 10 }, "0-9=", "-9" },
+    { { CALC_MODE_FLOAT, 0, 10 }, "1/4=", "0.25" },
+    { { CALC_MODE_FLOAT, 0, 10 }, "1.5*1.5=", "2.25" },
+    { { CALC_MODE_FLOAT, 0, 10 }, "16s", "4" },
+    { { CALC_MODE_DECIMAL, 0, 10 }, "1/3=", "0.33" },
+    { { CALC_MODE_DECIMAL, 0, 10 }, "0.1+0.2=", "0.30" },
+    { { CALC_MODE_BIG, 0, 10 }, "99999999999*9=", "899999999991" },
+    { { CALC_MODE_INT, 1, 10 }, "7=6*", "42" },
+    { { CALC_MODE_INT, 1, 10 }, "2=3=4*+", "14" },
+    { { CALC_MODE_INT, 1, 10 }, "1=0/", "Error" },
+    { { CALC_MODE_INT64, 1, 10 }, "3000000000=3*", "9000000000" },
+    { { CALC_MODE_FLOAT, 1, 10 }, "1=4/", "0.25" },
+    { { CALC_MODE_DECIMAL, 1, 10 }, "2=3/", "0.67" },
+    { { CALC_MODE_INT, 0, 16 }, "F+1=", "00000010" },
+    { { CALC_MODE_INT, 1, 16 }, "A=5&", "00000000" },
+    { { CALC_MODE_INT, 0, 10 }, "12+30=u", "12+30=42" },
+    { { CALC_MODE_INT, 0, 10 }, "2+3*4=u", "2+12=14" },
+    { { CALC_MODE_INT, 0, 10 }, "7*6=k8-9=uu", "7*6=42" },
+    { { CALC_MODE_INT, 0, 10 }, "7*6=k8-9=uuv", "8-9=-1" },
+    { { CALC_MODE_INT, 0, 10 }, "12+30=u+", "42+" },
+    { { CALC_MODE_INT, 0, 10 }, "12+30=k5*u=", "210" },
+    { { CALC_MODE_FLOAT, 0, 10 }, "1/4=u", "1/4=0.25" },
+    { { CALC_MODE_INT, 1, 10 }, "6=0=4--u", "6-(-4)=10" },
+    { { CALC_MODE_INT, 1, 10 }, "7=6*u=", "42" },
+    { { CALC_MODE_INT, 0, 10 }, "x5=pm2=pmmmmr=", "5" },
+    { { CALC_MODE_INT, 0, 10 }, "x5=pm2=nxpr=", "2" },
+    { { CALC_MODE_FLOAT, 1, 10 }, "x1=4/pm3=pmmmmr", "0.25" }
+};
+
+// Expected Stack Views
+// a value as wide as the columns after a level's label keeps the label, and a wider one gives up the
+// whole label for the marker, at each level
+static const test_stack_t testStacks[] = {
+    { { CALC_MODE_INT64, 1, 10 }, "1234567890123=999999999999=", { "<1234567890123", "1:999999999999" } },
+    { { CALC_MODE_INT64, 1, 10 }, "999999999999=1234567890123=", { "2:999999999999", "<1234567890123" } },
+    { { CALC_MODE_INT64, 1, 10 }, "12345678901234=99999999999999=", { "<2345678901234", "<9999999999999" } }
+};
+
+// Gets the action a test key stands for
+// digits and A-F are digits, operators are themselves, '=' is equals, and the rest are one letter each
+// @ param key - the key
+// @ return the action, or ACTION_NONE if the key stands for none
+static int test_action(char key) {
+
+    if (key >= '0' && key <= '9') {
+        return ACTION_DIGIT_0 + (key - '0');
+    }
+
+    if (key >= 'A' && key <= 'F') {
+        return ACTION_DIGIT_A + (key - 'A');
+    }
+
+    switch (key) {
+        case '+': return ACTION_ADD;
+        case '-': return ACTION_SUBTRACT;
+        case '*': return ACTION_MULTIPLY;
+        case '/': return ACTION_DIVIDE;
+        case '%': return ACTION_MODULO;
+        case '^': return ACTION_POWER;
+        case '&': return ACTION_AND;
+        case '|': return ACTION_OR;
+        case '=': return ACTION_EQUALS;
+        case '(': return ACTION_OPEN;
+        case ')': return ACTION_CLOSE;
+        case '.': return ACTION_POINT;
+        case 's': return ACTION_SQRT;
+        case 'k': return ACTION_CLEAR;
+        case 'u': return ACTION_HISTORY_UP;
+        case 'v': return ACTION_HISTORY_DOWN;
+        case 'm': return ACTION_MODE;
+        case 'p': return ACTION_MEMORY_ADD;
+        case 'n': return ACTION_MEMORY_SUBTRACT;
+        case 'r': return ACTION_MEMORY_RECALL;
+        case 'x': return ACTION_MEMORY_CLEAR;
+        default: return ACTION_NONE;
+    }
+}
+
+// Puts the calculator in a configuration, cleared
+// @ param config - the configuration
+// @ return void
+static void test_enter(const test_config_t * config) {
+    calc_set_mode(config->mode);
+    calc_set_base(config->base);
+    calc_set_rpn(config->rpn);
+}
+
+// Types keys into the calculator
+// @ param keys - the keys
+// @ return void
+static void test_keys(const char * keys) {
+    for (; * keys != '\0'; keys++) {
+        calc_handle(test_action(* keys));
+    }
+}
+
+// Checks that the LCD holds only characters it can show and that its cursor is on it
+// @ param void
+// @ return 1 if it does not, otherwise 0
+static int test_display_sane(void) {
+
+    for (int y = 0; y < TEST_LCD_ROWS; y++) {
+
+        const char * row = host_lcd_row(y);
+
+        if (strlen(row) != TEST_LCD_COLUMNS) {
+            return 1;
+        }
+
+        for (int x = 0; x < TEST_LCD_COLUMNS; x++) {
+            if (row[x] < ' ' || row[x] > '~') {
+                return 1;
+            }
+        }
+    }
+
+    int x;
+    int y;
+    host_lcd_cursor(&x, &y);
+
+    return x < 0 || x >= TEST_LCD_COLUMNS || y < 0 || y >= TEST_LCD_ROWS;
+}
+
+// Checks whether a row of the LCD shows some text as a whole field within the columns the calculator draws
+// a field is a run of characters between spaces, less a stack level's number and the mark of a value
+// scrolled off to the left, which leaves only its end showing, and the bottom row stops at the memory indicator
+// @ param expected - the text
+// @ return 1 if a row does, otherwise 0
+static int test_row_shows(const char * expected) {
+
+    int length = (int) strlen(expected);
+
+    for (int y = 0; y < TEST_LCD_ROWS; y++) {
+
+        char row[TEST_CALC_COLUMNS + 1];
+        memcpy(row, host_lcd_row(y), TEST_CALC_COLUMNS);
+        row[TEST_CALC_COLUMNS] = '\0';
+
+        if (y == TEST_MEMORY_ROW) {
+            row[TEST_MEMORY_COLUMN] = '\0';
+        }
+
+        for (char * field = strtok(row, " "); field != 0; field = strtok(0, " ")) {
+
+            char * colon = strchr(field, ':');
+            field = colon ? colon + 1 : field;
+
+            int scrolled = (* field == '<');
+            field += scrolled;
+
+            int fieldLength = (int) strlen(field);
+
+            if (fieldLength == length || (scrolled && fieldLength < length)) {
+                if (fieldLength > 0 && strcmp(field, expected + length - fieldLength) == 0) {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Checks that a configuration still calculates, so no action left it stuck
+// @ param config - the configuration
+// @ return 1 if it does not, otherwise 0
+static int test_still_calculates(const test_config_t * config) {
+
+    const char * expected = "5";
+
+    if (config->mode == CALC_MODE_DECIMAL) {
+        expected = "5.00";
+    } else if (config->base != 10) {
+        expected = config->mode == CALC_MODE_INT64 ? "0000000000000005" : "00000005";
+    }
+
+    test_enter(config);
+    test_keys(config->rpn && config->mode != CALC_MODE_BIG ? "2=3+" : "2+3=");
+
+    return !test_row_shows(expected);
+}
+
+// Runs the test
+// @ param void
+// @ return 0 if every action in every state left a sane display and every calculation showed
+// what it should, otherwise 1
+int main(void) {
+
+    int failures = 0;
+    long sequences = 0;
+    const int configs = sizeof(testConfigs) / sizeof(testConfigs[0]);
+    const int prefixes = sizeof(testPrefixes) / sizeof(testPrefixes[0]);
+
+    host_init();
+    lcd_init();
+    keymap_reset();
+    calc_init();
+
+    // an expression long enough to fill the text, after which only equals, clear, and scrolling take
+    for (int i = 0; i < TEST_FILL_PAIRS; i++) {
+        testFill[2 * i] = '9';
+        testFill[2 * i + 1] = '+';
+    }
+
+    // every pair of actions, including the ones out of range, after every prefix in every state
+    for (int c = 0; c < configs; c++) {
+
+        const test_config_t * config = &testConfigs[c];
+
+        for (int p = 0; p <= prefixes; p++) {
+
+            const char * prefix = p < prefixes ? testPrefixes[p] : testFill;
+
+            for (int first = -1; first <= ACTION_COUNT; first++) {
+                for (int second = -1; second <= ACTION_COUNT; second++) {
+
+                    test_enter(config);
+                    test_keys(prefix);
+                    calc_handle(first);
+                    calc_handle(second);
+                    sequences++;
+
+                    if (test_display_sane()) {
+                        if (failures++ < 10) {
+                            printf("mode %d rpn %d base %d: \"%.20s\" then actions %d and %d left \"%.16s\"\n",
+                                   config->mode, config->rpn, config->base, prefix, first, second, host_lcd_row(0));
+                        }
+                    }
+                }
+            }
+        }
+
+        if (test_still_calculates(config)) {
+            printf("mode %d rpn %d base %d: 2+3 shows \"%.16s\" / \"%.16s\"\n", config->mode, config->rpn, config->base,
+                   host_lcd_row(0), host_lcd_row(1));
+            failures++;
+        }
+    }
+
+    printf("%ld action sequences over %d configurations\n", sequences, configs);
+
+    // long random walks, where the mode, entry, and base keys carry the walk through every state
+    uint32_t seed = 0x2545F491u;
+
+    for (int c = 0; c < configs; c++) {
+
+        test_enter(&testConfigs[c]);
+
+        for (long step = 0; step < TEST_WALK_STEPS; step++) {
+
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+
+            int action = 1 + (int) (seed % (ACTION_COUNT - 1));
+            calc_handle(action);
+
+            if (test_display_sane()) {
+                if (failures++ < 10) {
+                    printf("walk from configuration %d: step %ld, action %d left \"%.16s\"\n", c, step, action,
+                           host_lcd_row(0));
+                }
+                break;
+            }
+        }
+
+        if (test_still_calculates(&testConfigs[c])) {
+            printf("walk from configuration %d: 2+3 shows \"%.16s\" / \"%.16s\"\n", c, host_lcd_row(0), host_lcd_row(1));
+            failures++;
+        }
+    }
+
+    printf("%d random walks of %d actions\n", configs, TEST_WALK_STEPS);
+
+    // the results each mode should show
+    for (size_t i = 0; i < sizeof(testDisplays) / sizeof(testDisplays[0]); i++) {
+
+        const test_display_t * display = &testDisplays[i];
+
+        test_enter(&display->config);
+        test_keys(display->keys);
+
+        if (!test_row_shows(display->expected)) {
+            printf("mode %d rpn %d base %d: \"%s\" shows \"%.16s\" / \"%.16s\", expected \"%s\"\n",
+                   display->config.mode, display->config.rpn, display->config.base, display->keys,
+                   host_lcd_row(0), host_lcd_row(1), display->expected);
+            failures++;
+        }
+    }
+
+    // the stack levels and their labels, column for column
+    for (size_t i = 0; i < sizeof(testStacks) / sizeof(testStacks[0]); i++) {
+
+        const test_stack_t * stack = &testStacks[i];
+
+        test_enter(&stack->config);
+        test_keys(stack->keys);
+
+        for (int y = 0; y < TEST_LCD_ROWS; y++) {
+            if (strncmp(host_lcd_row(y), stack->rows[y], TEST_MEMORY_COLUMN) != 0) {
+                printf("\"%s\" shows \"%.14s\" on row %d, expected \"%s\"\n", stack->keys, host_lcd_row(y), y,
+                       stack->rows[y]);
+                failures++;
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+// file: test_key_queue.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Pushes bursts of simulated keypresses through the key event queue from a producer thread
+
+# include <pthread.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <stdlib.h>
+# include <time.h>
+# include "host.h"
+# include "keypad_driver.h"
+# include "timebase.h"
+
+// Test Characteristics
+// the producer stands in for the keypad interrupts and the main thread for the calculator loop
+# define TEST_PRESSES 1000000
+# define TEST_BURST_MAX 256
+# define TEST_QUEUE_SIZE 64
+
+// Producer Log
+// the events the queue accepted, in order, for the consumer's to be checked against
+static key_event_t testAccepted[TEST_PRESSES];
+static int testAcceptedCount = 0;
+static volatile int testProducing = 1;
+
+// Consumer Log
+static key_event_t testReceived[TEST_PRESSES];
+static int testReceivedCount = 0;
+
+// Gets the next value of a small linear congruential generator
+// @ param state - the generator state
+// @ return the next value
+static uint32_t test_random(uint32_t * state) {
+    * state = * state * 1664525 + 1013904223;
+    return * state >> 8;
+}
+
+// Injects bursts of presses, as a fast typist or a bouncing matrix would, with pauses between
+// @ param argument - unused
+// @ return 0
+static void * test_producer(void * argument) {
+
+    uint32_t seed = 12345;
+    int pressed = 0;
+
+    while (pressed < TEST_PRESSES) {
+
+        int burst = 1 + test_random(&seed) % TEST_BURST_MAX;
+
+        for (int i = 0; i < burst && pressed < TEST_PRESSES; i++, pressed++) {
+
+            uint32_t value = test_random(&seed);
+            int key = 1 + value % 16;
+            int type = KEY_EVENT_PRESS + (value >> 4) % 4;
+
+            // the producer owns the overflow counter, so a change means this event was dropped
+            uint32_t overflows = key_get_overflow_count();
+            key_inject(key, type);
+
+            if (key_get_overflow_count() == overflows) {
+                testAccepted[testAcceptedCount].key = key;
+                testAccepted[testAcceptedCount].type = type;
+                testAcceptedCount++;
+            }
+        }
+
+        struct timespec pause = { 0, test_random(&seed) % 20000 };
+        nanosleep(&pause, 0);
+    }
+
+    testProducing = 0;
+
+    return 0;
+}
+
+// Runs the test
+// @ param void
+// @ return 0 if every accepted event arrived once and in order, otherwise 1
+int main(void) {
+
+    host_init();
+    key_clear();
+
+    int failures = 0;
+
+    // a timed wait ends at its timeout with nothing queued, and at once with an event waiting
+    uint32_t start = timebase_now_us();
+    if (key_wait_timeout(5) != 0 || timebase_elapsed_us(start) < 5000) {
+        printf("a 5 ms wait on an empty queue returned after %u us\n", timebase_elapsed_us(start));
+        failures++;
+    }
+
+    key_inject(1, KEY_EVENT_PRESS);
+    start = timebase_now_us();
+    if (key_wait_timeout(1000) != 1 || timebase_elapsed_us(start) >= 1000000) {
+        printf("a wait with an event queued did not return at once\n");
+        failures++;
+    }
+
+    key_clear();
+    key_reset_queue_stats();
+
+    pthread_t producer;
+    pthread_create(&producer, 0, test_producer, 0);
+
+    // drain the queue, now and then stalling like a slow LCD update so the queue fills up
+    uint32_t seed = 678;
+    int deepest = 0;
+    key_event_t event;
+
+    while (testProducing || key_available() != 0) {
+
+        int available = key_available();
+        if (available > deepest) {
+            deepest = available;
+        }
+
+        if (test_random(&seed) % 1000 == 0) {
+            for (volatile int i = 0; i < 20000; i++);
+        }
+
+        if (key_get_event(&event) && testReceivedCount < TEST_PRESSES) {
+            testReceived[testReceivedCount++] = event;
+        }
+    }
+
+    pthread_join(producer, 0);
+
+    uint32_t overflows = key_get_overflow_count();
+
+    if (testReceivedCount != testAcceptedCount) {
+        printf("received %d events but the queue accepted %d\n", testReceivedCount, testAcceptedCount);
+        failures++;
+    }
+
+    if (testAcceptedCount + overflows != TEST_PRESSES) {
+        printf("%d accepted and %u dropped do not add up to %d pressed\n", testAcceptedCount, overflows, TEST_PRESSES);
+        failures++;
+    }
+
+    for (int i = 0; i < testReceivedCount && i < testAcceptedCount; i++) {
+        if (testReceived[i].key != testAccepted[i].key || testReceived[i].type != testAccepted[i].type) {
+            printf("event %d arrived as key %d type %d, expected key %d type %d\n", i,
+                   testReceived[i].key, testReceived[i].type, testAccepted[i].key, testAccepted[i].type);
+            failures++;
+            break;
+        }
+    }
+
+    if (deepest > TEST_QUEUE_SIZE || key_get_queue_peak() > TEST_QUEUE_SIZE) {
+        printf("the queue held %d events, more than its %d slots\n", deepest, TEST_QUEUE_SIZE);
+        failures++;
+    }
+
+    printf("%d presses, %d delivered in order, %u dropped while full, peak depth %u\n",
+           TEST_PRESSES, testReceivedCount, overflows, key_get_queue_peak());
+
+    return failures ? 1 : 0;
+}
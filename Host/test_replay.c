@@ -0,0 +1,317 @@
+// file: test_replay.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Drives the calculator from replay scripts through the keypad timer interrupt on the host
+
+# include <stdint.h>
+# include <stdio.h>
+# include <string.h>
+# include "calc.h"
+# include "host.h"
+# include "keymap.h"
+# include "keypad_driver.h"
+# include "lcd_driver.h"
+# include "replay.h"
+# include "timebase.h"
+
+// Test Characteristics
+# define TEST_MAX_STEPS 64
+# define TEST_MAX_EVENTS 64
+# define TEST_QUEUE_SIZE 64
+# define TEST_LOOPS 10000
+# define TEST_STACK_COLUMNS 14
+
+// Keypad Timer Interrupt
+void TIM6_DAC_IRQHandler(void);
+
+// Received Events
+// each event as its key character, upper case for a press and lower case for a release
+static char testEvents[TEST_MAX_EVENTS + 1];
+static int testEventCount;
+
+// Resolved Actions
+// each action the keymap resolved an event to, as the character of its key on the base layer or,
+// for actions only on the other layers, as a character of its own
+static const char testActionChars[ACTION_COUNT + 1] = "?0123456789abcdef+-*/%^&|${}=CR()<>.MQSOTEL!PWDKUVABNXYG";
+static char testActions[TEST_MAX_EVENTS + 1];
+static int testActionCount;
+
+// Runs a replay to the end, taking the keypad timer interrupt once per millisecond and handing
+// every queued event to the keymap and the calculator as the main loop would
+// @ param script - the replay script
+// @ param loops - how many times to run the script
+// @ param ticks - where to store the number of timer interrupts taken
+// @ return the number of events drained, or -1 if the script did not parse
+static long test_run(const char * script, uint32_t loops, long * ticks) {
+
+    static replay_step_t steps[TEST_MAX_STEPS];
+    int count = replay_parse(script, steps, TEST_MAX_STEPS);
+
+    if (count <= 0) {
+        return -1;
+    }
+
+    long events = 0;
+    * ticks = 0;
+    testEventCount = 0;
+    testActionCount = 0;
+
+    replay_start(steps, count, loops);
+
+    while (replay_is_running() || key_available() != 0) {
+
+        TIM6_DAC_IRQHandler();
+        (* ticks)++;
+
+        key_event_t event;
+        while (key_get_event(&event)) {
+
+            if (testEventCount < TEST_MAX_EVENTS) {
+                char c = key_to_char(event.key);
+                testEvents[testEventCount++] = (event.type == KEY_EVENT_RELEASE) ? c | 0x20 : c;
+            }
+
+            int action = keymap_resolve(&event);
+            if (action != ACTION_NONE) {
+                if (testActionCount < TEST_MAX_EVENTS) {
+                    testActions[testActionCount++] = testActionChars[action];
+                }
+                calc_handle(action);
+            }
+
+            events++;
+        }
+    }
+
+    testEvents[testEventCount] = 0;
+    testActions[testActionCount] = 0;
+
+    return events;
+}
+
+// Checks that a script reaches the queue as a sequence of events and resolves to a sequence of actions
+// @ param script - the replay script
+// @ param events - the events, upper case for a press and lower case for a release
+// @ param actions - the actions, as the characters of their keys on the base layer
+// @ return 1 if it does not, otherwise 0
+static int test_expect(const char * script, const char * events, const char * actions) {
+
+    long ticks;
+
+    if (test_run(script, 1, &ticks) < 0) {
+        printf("\"%s\" did not parse\n", script);
+        return 1;
+    }
+
+    if (strcmp(testEvents, events) != 0) {
+        printf("\"%s\" queued \"%s\", expected \"%s\"\n", script, testEvents, events);
+        return 1;
+    }
+
+    if (strcmp(testActions, actions) != 0) {
+        printf("\"%s\" resolved to \"%s\", expected \"%s\"\n", script, testActions, actions);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Checks that the top row of the LCD starts with some text
+// @ param name - the name of the check
+// @ param expected - the text the row should start with
+// @ return 1 if it does not, otherwise 0
+static int test_expect_row(const char * name, const char * expected) {
+
+    if (strncmp(host_lcd_row(0), expected, strlen(expected)) != 0) {
+        printf("%s: the display shows \"%.16s\", expected \"%s\"\n", name, host_lcd_row(0), expected);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Checks that the bottom row of the LCD shows some text where the RPN stack right-aligns its top value,
+// just short of the memory indicator
+// @ param name - the name of the check
+// @ param expected - the text the value columns should end with
+// @ return 1 if it does not, otherwise 0
+static int test_expect_stack(const char * name, const char * expected) {
+
+    const char * row = host_lcd_row(1);
+    int length = strlen(expected);
+
+    if (strncmp(row + TEST_STACK_COLUMNS - length, expected, length) != 0) {
+        printf("%s: the stack shows \"%.16s\", expected it to end with \"%s\"\n", name, row, expected);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Runs the test
+// @ param void
+// @ return 0 if every replay behaved, otherwise 1
+int main(void) {
+
+    int failures = 0;
+    long ticks;
+
+    host_init();
+    lcd_init();
+    key_set_debounce(1);
+    keymap_reset();
+    calc_init();
+
+    // a script reaches the queue exactly like typed keys, a tap being a press and then a release,
+    // and a tapped modifier fires on its release
+    failures += test_expect("1 2 A 3 4 #", "1122Aa3344##", "12+34=");
+    failures += test_expect("* 9 C 9 D 3 #", "**99Cc99Dd33##", "C9*9/3=");
+
+    // a key pressed with a held modifier resolves on that modifier's layer, and the modifier does not
+    // fire when it is let go
+    failures += test_expect("+* 7 -*", "*77*", "");
+    failures += test_expect("+# 9 -# 1", "#99#11", "1");
+
+    // steps are separated by whitespace, so a run of characters is not a script
+    replay_step_t steps[TEST_MAX_STEPS];
+    if (replay_parse("12A34#", steps, TEST_MAX_STEPS) >= 0) {
+        printf("\"12A34#\" parsed without whitespace between its steps\n");
+        failures++;
+    }
+
+    // the boot script main.c gives as its example parses
+    if (replay_parse("1 2 A 3 4 # *", steps, TEST_MAX_STEPS) != 7) {
+        printf("\"1 2 A 3 4 # *\" did not parse into 7 steps\n");
+        failures++;
+    }
+
+    // a script reaches the calculator exactly like typed keys
+    test_run("* 1 2 A 3 4 #", 1, &ticks);
+    failures += test_expect_row("12+34=", "46");
+
+    test_run("* 9 C 9 D 3 #", 1, &ticks);
+    failures += test_expect_row("9*9/3=", "27");
+
+    test_run("* +* 1 -* 2 A 3 +* 2 -* C 4 #", 1, &ticks);
+    failures += test_expect_row("(2+3)*4=", "20");
+
+    // an operation with no result shows an error rather than a wrong number
+    test_run("* 1 D 0 #", 1, &ticks);
+    failures += test_expect_row("1/0=", "Error");
+
+    test_run("* 2 1 4 7 4 8 3 6 4 7 A 1 #", 1, &ticks);
+    failures += test_expect_row("2147483647+1=", "Error");
+
+    test_run("* 1 A 6 D 0 A 2 #", 1, &ticks);
+    failures += test_expect_row("1+6/0+2=", "Error");
+
+    // a lone zero takes no more zeros, and another digit replaces it
+    test_run("* 0 0 7 A 0 0 #", 1, &ticks);
+    failures += test_expect_row("007+00=", "7");
+
+    test_run("* 0 B 4 # +# 1 -#", 1, &ticks);
+    failures += test_expect_row("sqrt(0-4)", "Error");
+
+    // equals again repeats the last operation on the result, with the operand of the last reduction
+    test_run("* 2 C 3 # # #", 1, &ticks);
+    failures += test_expect_row("2*3===", "54");
+
+    test_run("* 2 C +* 1 -* 1 A 2 +* 2 -* # # #", 1, &ticks);
+    failures += test_expect_row("2*(1+2)===", "54");
+
+    test_run("* +* 1 -* 2 A 3 +* 2 -* # #", 1, &ticks);
+    failures += test_expect_row("(2+3)==", "8");
+
+    test_run("* 4 0 0 0 0 C 4 0 0 0 0 # #", 1, &ticks);
+    failures += test_expect_row("40000*40000==", "Error");
+
+    // the 64-bit mode goes past the int range and stops at its own
+    test_run("* +# D -# 2 1 4 7 4 8 3 6 4 7 A 1 #", 1, &ticks);
+    failures += test_expect_row("i64 2147483647+1=", "2147483648");
+
+    test_run("* 9 2 2 3 3 7 2 0 3 6 8 5 4 7 7 5 8 0 7 A 1 #", 1, &ticks);
+    failures += test_expect_row("i64 9223372036854775807+1=", "Error");
+
+    // the float mode takes a point and prints the shortest digits that give the result back
+    test_run("* +# D -# 1 +* 0 -* 5 A 2 #", 1, &ticks);
+    failures += test_expect_row("flt 1.5+2=", "3.5");
+
+    test_run("* 0 +* 0 -* 1 A 0 +* 0 -* 2 #", 1, &ticks);
+    failures += test_expect_row("flt 0.1+0.2=", "0.3");
+
+    test_run("* 1 D 0 #", 1, &ticks);
+    failures += test_expect_row("flt 1/0=", "Error");
+
+    // the decimal mode is exact to its places and rounds what does not fit them
+    test_run("* +# D -# 0 +* 0 -* 1 A 0 +* 0 -* 2 #", 1, &ticks);
+    failures += test_expect_row("dec 0.1+0.2=", "0.30");
+
+    test_run("* 2 D 3 #", 1, &ticks);
+    failures += test_expect_row("dec 2/3=", "0.67");
+
+    test_run("* 1 D 0 #", 1, &ticks);
+    failures += test_expect_row("dec 1/0=", "Error");
+
+    // bignum mode takes operands past any word, with the same errors and leading zeros
+    test_run("* +# D -# 9 9 9 9 9 9 9 9 9 9 9 C 9 9 9 9 9 9 9 9 9 9 9 #", 1, &ticks);
+    failures += test_expect_row("99999999999*99999999999=", "9999999999800000");
+
+    test_run("* 1 D 0 #", 1, &ticks);
+    failures += test_expect_row("big 1/0=", "Error");
+
+    test_run("* 0 0 7 A 0 0 #", 1, &ticks);
+    failures += test_expect_row("big 007+00=", "7");
+
+    test_run("+# D -#", 1, &ticks);
+
+    // in RPN mode equals enters a value and operators act on the stack at once
+    test_run("* +# 3 -# 1 2 # 3 4 A", 1, &ticks);
+    failures += test_expect_stack("rpn 12 34 +", "46");
+
+    test_run("* 0 0 7 # 0 0 1 A", 1, &ticks);
+    failures += test_expect_stack("rpn 007 001 +", "8");
+
+    // an operation with no result shows an error over the stack, which it leaves as it was
+    test_run("* 1 # 0 D", 1, &ticks);
+    failures += test_expect_stack("rpn 1 0 /", "Error");
+
+    test_run("A", 1, &ticks);
+    failures += test_expect_stack("rpn 1 0 / +", "1");
+
+    test_run("+# 3 -#", 1, &ticks);
+
+    // a script with no delays must not hold the keypad interrupt, it is spread over the ticks
+    // instead with the queue never overflowing
+    key_reset_queue_stats();
+    long events = test_run("1@0 2@0 3@0 *@0", 1000, &ticks);
+
+    if (events != 8000 || key_get_overflow_count() != 0 || key_get_queue_peak() > TEST_QUEUE_SIZE) {
+        printf("zero delay: %ld events, %u dropped, peak %u\n", events, key_get_overflow_count(), key_get_queue_peak());
+        failures++;
+    }
+
+    if (ticks < 4000 / 8) {
+        printf("zero delay: %ld steps ran in only %ld ticks\n", 4000L, ticks);
+        failures++;
+    }
+
+    printf("zero delay script: 4000 steps over %ld ticks, peak queue depth %u\n", ticks, key_get_queue_peak());
+
+    // end-to-end throughput of scripted calculations
+    uint32_t start = timebase_now_us();
+    events = test_run("*@1 1@1 2@1 3@1 A@1 4@1 5@1 6@1 C@1 7@1 #@1", TEST_LOOPS, &ticks);
+    uint32_t elapsed = timebase_elapsed_us(start);
+
+    if (events != 22L * TEST_LOOPS) {
+        printf("throughput: %ld events, expected %ld\n", events, 22L * TEST_LOOPS);
+        failures++;
+    }
+
+    failures += test_expect_row("123+456*7=", "3315");
+
+    printf("%d scripted calculations, %ld events in %u us, %.2f us per calculation\n",
+           TEST_LOOPS, events, elapsed, (double) elapsed / TEST_LOOPS);
+
+    return failures ? 1 : 0;
+}
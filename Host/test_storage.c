@@ -0,0 +1,314 @@
+// file: test_storage.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Cuts the power at every flash step of the record log and checks what it holds after a remount
+
+# include <setjmp.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <string.h>
+# include "flash.h"
+# include "host.h"
+# include "storage.h"
+
+// Test Characteristics
+# define TEST_IMAGE "test_storage.img"
+# define TEST_SECTOR_FIRST 6
+# define TEST_SECTORS_BYTES (2 * 0x20000)
+# define TEST_SWEPT_FIRST 40
+# define TEST_SWEPT_AROUND 4
+# define TEST_COMPACTIONS 2
+# define TEST_WRITES_MAX 4000
+
+// A Key's Records
+// the record a key is known to hold, and the one being written to it, which a cut may or may not keep
+typedef struct {
+    uint8_t data[STORAGE_RECORD_MAX];
+    int length;
+    int written;
+} test_record_t;
+
+// Model
+// what the log should hold for every key
+static test_record_t testCommitted[STORAGE_KEYS];
+
+// Flash Snapshot
+// both storage sectors as they were before the write being swept
+static uint8_t testSnapshot[TEST_SECTORS_BYTES];
+
+// Power Loss
+static jmp_buf testPowerLost;
+
+// Counts
+static long testCuts;
+static long testCompactionCuts;
+
+// Returns to the sweep when the flash stand-in cuts the power
+// @ param void
+// @ return does not return
+static void test_lost(void) {
+    longjmp(testPowerLost, 1);
+}
+
+// Gets the storage sectors of the flash image
+// @ param void
+// @ return the first byte of the first storage sector
+static uint8_t * test_sectors(void) {
+    return (uint8_t *) flash_sector_address(TEST_SECTOR_FIRST);
+}
+
+// Makes the next record of the workload, of a length that spreads from empty to the largest a key takes
+// every few records repeat the key's last one, which the log does not write again
+// @ param state - the generator state
+// @ param key - where to store the key
+// @ param record - where to store the record
+// @ return void
+static void test_next(uint32_t * state, int * key, test_record_t * record) {
+
+    * state ^= * state << 13;
+    * state ^= * state >> 17;
+    * state ^= * state << 5;
+
+    * key = * state % STORAGE_KEYS;
+
+    if ((* state >> 8) % 8 == 0 && testCommitted[* key].written) {
+        * record = testCommitted[* key];
+        return;
+    }
+
+    record->length = (* state >> 12) % (STORAGE_RECORD_MAX + 1);
+    record->written = 1;
+
+    for (int i = 0; i < record->length; i++) {
+        record->data[i] = (uint8_t) (* state >> (i % 24)) + i;
+    }
+}
+
+// Checks that a key reads back a record
+// @ param key - the key
+// @ param record - the record
+// @ return 1 if it does, otherwise 0
+static int test_reads(int key, const test_record_t * record) {
+
+    uint8_t buffer[STORAGE_RECORD_MAX];
+    int length;
+    int status = storage_read(key, buffer, sizeof(buffer), &length);
+
+    if (!record->written) {
+        return status == STORAGE_ERROR_NOT_FOUND;
+    }
+
+    return status == STORAGE_OK && length == record->length && memcmp(buffer, record->data, length) == 0;
+}
+
+// Checks the log after a remount, where the key being written may hold its old or its new record and
+// every other key its old one, then checks that it takes the new record and still holds the others
+// @ param name - what was cut, for the report
+// @ param cut - the operation the power was cut on
+// @ param key - the key being written, or -1 if none was
+// @ param record - the record being written
+// @ return 1 if the log lost or corrupted a record or refused one, otherwise 0
+static int test_remount(const char * name, long cut, int key, const test_record_t * record) {
+
+    int failures = 0;
+
+    if (storage_init() != STORAGE_OK) {
+        printf("%s, cut at operation %ld: the log could not be mounted\n", name, cut);
+        return 1;
+    }
+
+    for (int k = 0; k < STORAGE_KEYS; k++) {
+        if (!test_reads(k, &testCommitted[k]) && !(k == key && test_reads(k, record))) {
+            if (failures++ == 0) {
+                printf("%s, cut at operation %ld: key %d holds neither its old nor its new record\n", name, cut, k);
+            }
+        }
+    }
+
+    // the write is tried again, as the next save would, and every key must then read back
+    if (key >= 0) {
+
+        if (storage_write(key, record->data, record->length) != STORAGE_OK) {
+            printf("%s, cut at operation %ld: the log refused a write after the remount\n", name, cut);
+            return 1;
+        }
+
+        for (int k = 0; k < STORAGE_KEYS; k++) {
+            if (!test_reads(k, k == key ? record : &testCommitted[k])) {
+                if (failures++ == 0) {
+                    printf("%s, cut at operation %ld: key %d lost its record after the retried write\n", name, cut, k);
+                }
+            }
+        }
+    }
+
+    return failures != 0;
+}
+
+// Writes a record the way the sweep found it, with the power cut after a number of operations
+// @ param key - the key
+// @ param record - the record
+// @ param operations - how many operations complete before the cut, or -1 for none
+// @ return 1 if the power was cut, otherwise 0
+static int test_write(int key, const test_record_t * record, long operations) {
+
+    if (setjmp(testPowerLost)) {
+        return 1;
+    }
+
+    host_flash_power_loss(operations, test_lost);
+    storage_write(key, record->data, record->length);
+    host_flash_power_loss(-1, 0);
+
+    return 0;
+}
+
+// Cuts the power at every operation of a write, remounting from the flash as it was before each time
+// @ param key - the key
+// @ param record - the record
+// @ param operations - the operations the write takes
+// @ param compacts - whether the write compacts the log, for the counts
+// @ return the number of cuts the log did not survive
+static int test_sweep(int key, const test_record_t * record, long operations, int compacts) {
+
+    int failures = 0;
+
+    for (long cut = 0; cut < operations; cut++) {
+
+        memcpy(test_sectors(), testSnapshot, TEST_SECTORS_BYTES);
+        storage_init();
+
+        if (!test_write(key, record, cut)) {
+            printf("write to key %d: the power was never cut at operation %ld\n", key, cut);
+            failures++;
+            continue;
+        }
+
+        host_flash_power_loss(-1, 0);
+        failures += test_remount(compacts ? "compacting write" : "write", cut, key, record);
+        testCuts++;
+        testCompactionCuts += compacts;
+    }
+
+    return failures;
+}
+
+// Runs the test
+// @ param void
+// @ return 0 if the log survived every cut, otherwise 1
+int main(void) {
+
+    int failures = 0;
+
+    host_init();
+    remove(TEST_IMAGE);
+
+    if (host_flash_open(TEST_IMAGE) != FLASH_OK) {
+        printf("the flash image could not be opened\n");
+        return 1;
+    }
+
+    // an erased image is formatted by the first mount, which a cut must not leave unmountable
+    memcpy(testSnapshot, test_sectors(), TEST_SECTORS_BYTES);
+
+    long before = host_flash_operations();
+    storage_init();
+    long formatOperations = host_flash_operations() - before;
+
+    for (long cut = 0; cut < formatOperations; cut++) {
+
+        memcpy(test_sectors(), testSnapshot, TEST_SECTORS_BYTES);
+
+        if (setjmp(testPowerLost) == 0) {
+            host_flash_power_loss(cut, test_lost);
+            storage_init();
+        }
+
+        host_flash_power_loss(-1, 0);
+        failures += test_remount("format", cut, -1, 0);
+        testCuts++;
+    }
+
+    // start over on the formatted, empty log
+    memcpy(test_sectors(), testSnapshot, TEST_SECTORS_BYTES);
+    storage_init();
+
+    // the workload runs once uncut, and every write at the start, and every write from a few before
+    // to a few after one that compacts the log, is run again with the power cut at each of its steps
+    uint32_t seed = 0x6C078965u;
+    int compactions = 0;
+    int sweepUntil = TEST_SWEPT_FIRST;
+    int writes = 0;
+
+    static uint8_t history[TEST_SWEPT_AROUND][TEST_SECTORS_BYTES];
+    static test_record_t historyCommitted[TEST_SWEPT_AROUND][STORAGE_KEYS];
+    static uint32_t historySeeds[TEST_SWEPT_AROUND];
+
+    while (compactions < TEST_COMPACTIONS && writes < TEST_WRITES_MAX) {
+
+        // the log and the model as they were before this write, kept for the last few writes so the
+        // ones before a compaction can be swept once it is found
+        int slot = writes % TEST_SWEPT_AROUND;
+        memcpy(history[slot], test_sectors(), TEST_SECTORS_BYTES);
+        memcpy(historyCommitted[slot], testCommitted, sizeof(testCommitted));
+        historySeeds[slot] = seed;
+
+        int key;
+        test_record_t record;
+        test_next(&seed, &key, &record);
+
+        before = host_flash_operations();
+        test_write(key, &record, -1);
+        long operations = host_flash_operations() - before;
+
+        // an append programs the record's words, anything more is a compaction
+        int words = 1 + (record.length + 3) / 4;
+        int compacts = operations > words;
+
+        // a compaction found outside a sweep sends the workload back to the oldest kept write, and
+        // everything from there to a few writes after the compaction is swept
+        if (compacts && writes >= sweepUntil) {
+
+            int back = (writes < TEST_SWEPT_AROUND - 1) ? writes : TEST_SWEPT_AROUND - 1;
+            int first = writes - back;
+
+            memcpy(test_sectors(), history[first % TEST_SWEPT_AROUND], TEST_SECTORS_BYTES);
+            memcpy(testCommitted, historyCommitted[first % TEST_SWEPT_AROUND], sizeof(testCommitted));
+            seed = historySeeds[first % TEST_SWEPT_AROUND];
+            storage_init();
+
+            sweepUntil = writes + 1 + TEST_SWEPT_AROUND;
+            writes = first;
+            continue;
+        }
+
+        if (writes >= sweepUntil) {
+            testCommitted[key] = record;
+            writes++;
+            continue;
+        }
+
+        // sweep this write from the flash as it was before it, then make it for real
+        compactions += compacts;
+
+        memcpy(testSnapshot, history[slot], TEST_SECTORS_BYTES);
+        failures += test_sweep(key, &record, operations, compacts);
+
+        memcpy(test_sectors(), testSnapshot, TEST_SECTORS_BYTES);
+        storage_init();
+        test_write(key, &record, -1);
+        testCommitted[key] = record;
+        writes++;
+    }
+
+    // after every cut has been remounted, the workload's own log must still hold every key
+    failures += test_remount("workload", -1, -1, 0);
+
+    printf("%ld power cuts, %ld of them during compaction, over %d writes and %d compactions\n",
+           testCuts, testCompactionCuts, writes, compactions);
+
+    remove(TEST_IMAGE);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+// file: timebase.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the host stand-in for the TIM2 microsecond counter, read from the monotonic clock
+
+# include <stdint.h>
+# include <time.h>
+# include "host.h"
+# include "timebase.h"
+
+// Starts the free-running microsecond counter
+// @ param void
+// @ return void
+void timebase_init(void) {
+}
+
+// Gets the current value of the microsecond counter
+// the value wraps at 32 bits like TIM2 does
+// @ param void
+// @ return the counter value in microseconds
+uint32_t timebase_now_us(void) {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+// Gets the number of microseconds elapsed since an earlier counter value
+// @ param since - an earlier value from timebase_now_us
+// @ return the elapsed time in microseconds, correct across a single wrap
+uint32_t timebase_elapsed_us(uint32_t since) {
+    return timebase_now_us() - since;
+}
+
+// Gets the current value of the core cycle counter
+// the host counter is truncated to 32 bits like the DWT one
+// @ param void
+// @ return the counter value in host cycles
+uint32_t timebase_cycles(void) {
+    return (uint32_t) host_cycles();
+}
+
+// Arms the alarm
+// the host never sleeps, so there is nothing for the alarm to wake
+// @ param at - unused
+// @ return void
+void timebase_set_alarm(uint32_t at) {
+}
+
+// Disarms the alarm
+// @ param void
+// @ return void
+void timebase_cancel_alarm(void) {
+}
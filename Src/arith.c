@@ -0,0 +1,307 @@
+// file: arith.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains overflow-checked integer arithmetic for each calculator word size
+
+# include <stdint.h>
+# include "arith.h"
+# include "sci.h"
+
+// Function Prototypes
+static int arith_int32(char operator, int32_t a, int32_t b, int32_t * result);
+static int arith_int64(char operator, int64_t a, int64_t b, int64_t * result);
+static int arith_int_pow(int64_t a, int64_t b, int64_t * result);
+
+// Applies a binary operator to two integers of the given word size
+// overflow comes from the flags of the operation itself, never from a trial division
+// @ param type - ARITH_TYPE_INT32 or ARITH_TYPE_INT64
+// @ param operator - '+', '-', '*', '/', '%', '^', '&' for and, '|' for or, 'x' for exclusive or,
+//                    or '<' and '>' for logical shifts left and right
+// @ param a - the left operand, within the word size
+// @ param b - the right operand, within the word size
+// @ param result - where to store the result, untouched on error
+// @ return ARITH_OK, ARITH_ERROR_OVERFLOW, ARITH_ERROR_DIVIDE, or ARITH_ERROR_DOMAIN for a shift
+//          count outside of the word
+int arith_int(int type, char operator, int64_t a, int64_t b, int64_t * result) {
+
+    if (type == ARITH_TYPE_INT32) {
+
+        int32_t narrow;
+        int status = arith_int32(operator, (int32_t) a, (int32_t) b, &narrow);
+
+        if (status == ARITH_OK) {
+            * result = narrow;
+        }
+
+        return status;
+    }
+
+    return arith_int64(operator, a, b, result);
+}
+
+// Applies a binary operator to two floats on the FPU
+// @ param operator - '+', '-', '*', '/', '%', or '^'
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the result, untouched on error
+// @ return ARITH_OK, ARITH_ERROR_OVERFLOW if the result is not finite, ARITH_ERROR_DIVIDE, or
+//          ARITH_ERROR_DOMAIN for a power with no real result
+int arith_float(char operator, float a, float b, float * result) {
+
+    float r;
+
+    switch (operator) {
+
+        case '+':
+            r = a + b;
+            break;
+
+        case '-':
+            r = a - b;
+            break;
+
+        case '*':
+            r = a * b;
+            break;
+
+        case '/':
+            if (b == 0.0f) {
+                return ARITH_ERROR_DIVIDE;
+            }
+            r = a / b;
+            break;
+
+        // truncated remainder through a VCVT to integer, quotients past 32 bits have no useful remainder
+        case '%':
+            if (b == 0.0f) {
+                return ARITH_ERROR_DIVIDE;
+            }
+            r = a / b;
+            if (r >= 2147483648.0f || r <= -2147483648.0f) {
+                return ARITH_ERROR_OVERFLOW;
+            }
+            r = a - b * (float) (int32_t) r;
+            break;
+
+        case '^':
+            switch (sci_float_pow(a, b, &r)) {
+                case SCI_OK:
+                    break;
+                case SCI_ERROR_DOMAIN:
+                    return ARITH_ERROR_DOMAIN;
+                default:
+                    return ARITH_ERROR_OVERFLOW;
+            }
+            break;
+
+        default:
+            return ARITH_ERROR_OVERFLOW;
+    }
+
+    // infinities and NaNs are both out of range
+    if (r - r != 0.0f) {
+        return ARITH_ERROR_OVERFLOW;
+    }
+
+    * result = r;
+
+    return ARITH_OK;
+}
+
+// Gets the largest integer of the given word size
+// @ param type - ARITH_TYPE_INT32 or ARITH_TYPE_INT64
+// @ return the largest integer
+int64_t arith_int_max(int type) {
+    return type == ARITH_TYPE_INT32 ? INT32_MAX : INT64_MAX;
+}
+
+// Applies a binary operator to two 32-bit integers
+// add and subtract set the overflow flag directly and multiply is a single SMULL with a high word check
+// @ param operator - the operator
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the result
+// @ return ARITH_OK, ARITH_ERROR_OVERFLOW, ARITH_ERROR_DIVIDE, or ARITH_ERROR_DOMAIN
+static int arith_int32(char operator, int32_t a, int32_t b, int32_t * result) {
+
+    switch (operator) {
+
+        case '+':
+            return __builtin_add_overflow(a, b, result) ? ARITH_ERROR_OVERFLOW : ARITH_OK;
+
+        case '-':
+            return __builtin_sub_overflow(a, b, result) ? ARITH_ERROR_OVERFLOW : ARITH_OK;
+
+        case '*':
+            return __builtin_mul_overflow(a, b, result) ? ARITH_ERROR_OVERFLOW : ARITH_OK;
+
+        // the only quotient that overflows is INT32_MIN / -1
+        case '/':
+        case '%':
+            if (b == 0) {
+                return ARITH_ERROR_DIVIDE;
+            }
+            if (a == INT32_MIN && b == -1) {
+                if (operator == '/') {
+                    return ARITH_ERROR_OVERFLOW;
+                }
+                * result = 0;
+                return ARITH_OK;
+            }
+            * result = operator == '/' ? a / b : a % b;
+            return ARITH_OK;
+
+        // a 32-bit power is a 64-bit one that has to land back in range
+        case '^': {
+            int64_t wide;
+            int status = arith_int_pow(a, b, &wide);
+            if (status == ARITH_OK) {
+                if (wide > INT32_MAX || wide < INT32_MIN) {
+                    return ARITH_ERROR_OVERFLOW;
+                }
+                * result = (int32_t) wide;
+            }
+            return status;
+        }
+
+        // bitwise operators act on the bits of the word and never overflow
+        case '&':
+            * result = a & b;
+            return ARITH_OK;
+
+        case '|':
+            * result = a | b;
+            return ARITH_OK;
+
+        case 'x':
+            * result = a ^ b;
+            return ARITH_OK;
+
+        // shifts are logical on the unsigned word, bits shifted past either end are lost
+        case '<':
+        case '>':
+            if (b < 0 || b >= 32) {
+                return ARITH_ERROR_DOMAIN;
+            }
+            * result = (int32_t) (operator == '<' ? (uint32_t) a << b : (uint32_t) a >> b);
+            return ARITH_OK;
+
+        default:
+            return ARITH_ERROR_OVERFLOW;
+    }
+}
+
+// Applies a binary operator to two 64-bit integers
+// gcc expands the multiply check inline from 32-bit UMULL partial products, with no division
+// @ param operator - the operator
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the result
+// @ return ARITH_OK, ARITH_ERROR_OVERFLOW, ARITH_ERROR_DIVIDE, or ARITH_ERROR_DOMAIN
+static int arith_int64(char operator, int64_t a, int64_t b, int64_t * result) {
+
+    // the overflow builtins store the wrapped value, which must not reach the caller
+    int64_t wrapped;
+
+    switch (operator) {
+
+        case '+':
+            if (__builtin_add_overflow(a, b, &wrapped)) {
+                return ARITH_ERROR_OVERFLOW;
+            }
+            * result = wrapped;
+            return ARITH_OK;
+
+        case '-':
+            if (__builtin_sub_overflow(a, b, &wrapped)) {
+                return ARITH_ERROR_OVERFLOW;
+            }
+            * result = wrapped;
+            return ARITH_OK;
+
+        case '*':
+            if (__builtin_mul_overflow(a, b, &wrapped)) {
+                return ARITH_ERROR_OVERFLOW;
+            }
+            * result = wrapped;
+            return ARITH_OK;
+
+        // the only quotient that overflows is INT64_MIN / -1
+        case '/':
+        case '%':
+            if (b == 0) {
+                return ARITH_ERROR_DIVIDE;
+            }
+            if (a == INT64_MIN && b == -1) {
+                if (operator == '/') {
+                    return ARITH_ERROR_OVERFLOW;
+                }
+                * result = 0;
+                return ARITH_OK;
+            }
+            * result = operator == '/' ? a / b : a % b;
+            return ARITH_OK;
+
+        case '^':
+            return arith_int_pow(a, b, result);
+
+        case '&':
+            * result = a & b;
+            return ARITH_OK;
+
+        case '|':
+            * result = a | b;
+            return ARITH_OK;
+
+        case 'x':
+            * result = a ^ b;
+            return ARITH_OK;
+
+        case '<':
+        case '>':
+            if (b < 0 || b >= 64) {
+                return ARITH_ERROR_DOMAIN;
+            }
+            * result = (int64_t) (operator == '<' ? (uint64_t) a << b : (uint64_t) a >> b);
+            return ARITH_OK;
+
+        default:
+            return ARITH_ERROR_OVERFLOW;
+    }
+}
+
+// Raises a 64-bit integer to an integer power by repeated squaring
+// negative powers truncate toward zero like division does, so only a base of 1 or -1 survives them
+// @ param a - the base
+// @ param b - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return ARITH_OK, ARITH_ERROR_OVERFLOW, or ARITH_ERROR_DIVIDE for zero to a negative power
+static int arith_int_pow(int64_t a, int64_t b, int64_t * result) {
+
+    if (b < 0) {
+        if (a == 0) {
+            return ARITH_ERROR_DIVIDE;
+        }
+        * result = a == 1 || a == -1 ? ((b & 1) ? a : 1) : 0;
+        return ARITH_OK;
+    }
+
+    int64_t accumulator = 1;
+    int64_t base = a;
+
+    // a square only overflows when the power still needs it, so every overflow is a real one
+    while (b != 0) {
+        if ((b & 1) && __builtin_mul_overflow(accumulator, base, &accumulator)) {
+            return ARITH_ERROR_OVERFLOW;
+        }
+        b >>= 1;
+        if (b != 0 && __builtin_mul_overflow(base, base, &base)) {
+            return ARITH_ERROR_OVERFLOW;
+        }
+    }
+
+    * result = accumulator;
+
+    return ARITH_OK;
+}
@@ -0,0 +1,33 @@
+// file: arith.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for arith.c
+
+# ifndef ARITH_H
+# define ARITH_H
+
+# include <stdint.h>
+
+// Arithmetic Types
+# define ARITH_TYPE_INT32 0
+# define ARITH_TYPE_INT64 1
+# define ARITH_TYPE_FLOAT 2
+# define ARITH_TYPE_DECIMAL 3
+
+// Arithmetic Status Codes
+# define ARITH_OK 0
+# define ARITH_ERROR_OVERFLOW 1
+# define ARITH_ERROR_DIVIDE 2
+# define ARITH_ERROR_DOMAIN 3
+
+// Applies a binary operator to two integers of the given word size
+int arith_int(int type, char operator, int64_t a, int64_t b, int64_t * result);
+
+// Applies a binary operator to two floats on the FPU
+int arith_float(char operator, float a, float b, float * result);
+
+// Gets the largest integer of the given word size
+int64_t arith_int_max(int type);
+
+# endif
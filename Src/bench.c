@@ -0,0 +1,256 @@
+// file: bench.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains cycle-count benchmarks of the conversion and scientific kernels, for the target and the host
+
+# include <stdint.h>
+# include <stdio.h>
+# include "bench.h"
+# include "fmt.h"
+# include "sci.h"
+# include "timebase.h"
+
+// Benchmark Characteristics
+// every kernel is timed over BENCH_CALLS calls cycling through BENCH_VALUES inputs, and the fastest
+// of BENCH_ROUNDS rounds is kept so an interrupt landing in one round does not count
+# define BENCH_CALLS 256
+# define BENCH_ROUNDS 8
+# define BENCH_VALUES 16
+# define BENCH_VALUE_MASK (BENCH_VALUES - 1)
+
+// Fixed Point Inputs
+// a Q32.32 constant from a real one, exact for every input below
+# define BENCH_Q32(x) ((int64_t) ((x) * 4294967296.0))
+
+// A kernel under test, called with the index of the input to use
+typedef void (* bench_kernel_t)(int index);
+
+// Inputs
+// a spread of magnitudes, since the conversions cost more the more digits they write
+static const int32_t benchInt32[BENCH_VALUES] = {
+    0, 7, -42, 365, -1024, 65535, -100000, 3141592,
+    -27182818, 123456789, -987654321, 2147483647, -2147483647 - 1, 1000000000, -5, 99
+};
+
+static const int64_t benchInt64[BENCH_VALUES] = {
+    0, 7, -42, 65535, -100000, 2147483648, -27182818284, 123456789012,
+    -9876543210987, 100000000000000, -314159265358979, 12345678901234567,
+    -998877665544332211, INT64_MAX, INT64_MIN, 1000000000000000000
+};
+
+// half whole numbers and half fractions, the way calculator results come out
+static const float benchFloat[BENCH_VALUES] = {
+    0.0f, 7.0f, -42.0f, 365.0f, -1024.0f, 65535.0f, 3.14159265f, -2.71828183f,
+    0.1f, 1.0f / 3.0f, 12345.678f, -0.001f, 6.02214076e23f, 1.0e-7f, 123456789.0f, -100000.0f
+};
+
+// arguments every scientific function takes, kept clear of the tangent's poles, paired with
+// exponents that mix whole powers, which multiply, and fractional ones, which go through exp and ln
+static const float benchSciFloat[BENCH_VALUES] = {
+    0.001f, 0.1f, 0.5f, 0.75f, 1.0f, 1.25f, 2.0f, 2.5f,
+    3.14159265f, 4.0f, 5.5f, 7.0f, 9.75f, 12.0f, 16.5f, 20.0f
+};
+
+static const float benchSciExponent[BENCH_VALUES] = {
+    2.0f, 0.5f, -1.5f, 3.0f, 1.75f, -2.0f, 0.25f, 2.5f,
+    -0.5f, 1.5f, 2.0f, -0.75f, 0.5f, 1.25f, -1.0f, 2.25f
+};
+
+static const int64_t benchSciFixed[BENCH_VALUES] = {
+    BENCH_Q32(0.0009765625), BENCH_Q32(0.1), BENCH_Q32(0.5), BENCH_Q32(0.75),
+    BENCH_Q32(1.0), BENCH_Q32(1.25), BENCH_Q32(2.0), BENCH_Q32(2.5),
+    BENCH_Q32(3.14159265), BENCH_Q32(4.0), BENCH_Q32(5.5), BENCH_Q32(7.0),
+    BENCH_Q32(9.75), BENCH_Q32(12.0), BENCH_Q32(16.5), BENCH_Q32(20.0)
+};
+
+static const int64_t benchSciFixedExponent[BENCH_VALUES] = {
+    BENCH_Q32(2.0), BENCH_Q32(0.5), BENCH_Q32(-1.5), BENCH_Q32(3.0),
+    BENCH_Q32(1.75), BENCH_Q32(-2.0), BENCH_Q32(0.25), BENCH_Q32(2.5),
+    BENCH_Q32(-0.5), BENCH_Q32(1.5), BENCH_Q32(2.0), BENCH_Q32(-0.75),
+    BENCH_Q32(0.5), BENCH_Q32(1.25), BENCH_Q32(-1.0), BENCH_Q32(2.25)
+};
+
+// Scientific Kernel Names
+// one row per SCI function value, then the power, which is timed after them
+static const char * const benchSciNames[SCI_FUNCTIONS + 1][2] = {
+    { "sqrt f32", "sqrt q32" }, { "sin f32", "sin q32" }, { "cos f32", "cos q32" },
+    { "tan f32", "tan q32" }, { "exp f32", "exp q32" }, { "ln f32", "ln q32" },
+    { "pow f32", "pow q32" }
+};
+
+// Output
+// visible outside the file so the compiler cannot drop the work that fills it
+char benchBuffer[FMT_RADIX_SIZE];
+float benchFloatResult;
+int64_t benchFixedResult;
+
+// Scientific Function
+// the function the scientific kernels apply, chosen before each is timed
+static int benchSciFunction;
+
+// Static Function Prototypes
+static uint32_t bench_time(bench_kernel_t kernel);
+static int bench_add(bench_result_t * results, int count, int capacity, const char * name, bench_kernel_t kernel, uint32_t overhead);
+static void bench_empty(int index);
+static void bench_fmt_int32(int index);
+static void bench_sprintf_int32(int index);
+static void bench_fmt_int64(int index);
+static void bench_fmt_float(int index);
+static void bench_sprintf_float(int index);
+static void bench_sci_float(int index);
+static void bench_sci_fixed(int index);
+# if !defined(__arm__)
+static void bench_sprintf_int64(int index);
+# endif
+
+// Runs every benchmark and stores the results
+// the cost of calling an empty kernel is taken off every result
+// @ param results - where to store the results
+// @ param capacity - the number of results there is room for
+// @ return the number of results stored
+int bench_run(bench_result_t * results, int capacity) {
+
+    uint32_t overhead = bench_time(bench_empty);
+    int count = 0;
+
+    count = bench_add(results, count, capacity, "fmt_int32", bench_fmt_int32, overhead);
+    count = bench_add(results, count, capacity, "sprintf %ld", bench_sprintf_int32, overhead);
+    count = bench_add(results, count, capacity, "fmt_int64", bench_fmt_int64, overhead);
+
+    // newlib-nano's printf has no long long conversions, so only the host compares against one
+# if !defined(__arm__)
+    count = bench_add(results, count, capacity, "sprintf %lld", bench_sprintf_int64, overhead);
+# endif
+
+    count = bench_add(results, count, capacity, "fmt_float", bench_fmt_float, overhead);
+    count = bench_add(results, count, capacity, "sprintf %.9g", bench_sprintf_float, overhead);
+
+    // the float kernels run on the FPU, the Q32.32 kernels that decimal mode uses on the integer core
+    for (benchSciFunction = 0; benchSciFunction <= SCI_FUNCTIONS; benchSciFunction++) {
+        count = bench_add(results, count, capacity, benchSciNames[benchSciFunction][0], bench_sci_float, overhead);
+        count = bench_add(results, count, capacity, benchSciNames[benchSciFunction][1], bench_sci_fixed, overhead);
+    }
+
+    return count;
+}
+
+// Times a kernel
+// @ param kernel - the kernel
+// @ return the fewest cycles one round of BENCH_CALLS calls took
+static uint32_t bench_time(bench_kernel_t kernel) {
+
+    uint32_t best = UINT32_MAX;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+
+        uint32_t start = timebase_cycles();
+
+        for (int i = 0; i < BENCH_CALLS; i++) {
+            kernel(i & BENCH_VALUE_MASK);
+        }
+
+        uint32_t cycles = timebase_cycles() - start;
+
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+
+    return best;
+}
+
+// Times a kernel and stores its cost per call if there is room
+// @ param results - the results so far
+// @ param count - the number of results so far
+// @ param capacity - the number of results there is room for
+// @ param name - the name of the kernel
+// @ param kernel - the kernel
+// @ param overhead - the cycles a round of empty calls took
+// @ return the number of results after this one
+static int bench_add(bench_result_t * results, int count, int capacity, const char * name, bench_kernel_t kernel, uint32_t overhead) {
+
+    if (count >= capacity) {
+        return count;
+    }
+
+    uint32_t cycles = bench_time(kernel);
+
+    results[count].name = name;
+    results[count].cycles = (cycles > overhead) ? (cycles - overhead) / BENCH_CALLS : 0;
+
+    return count + 1;
+}
+
+// Does nothing, to time the cost of the calls themselves
+// @ param index - unused
+// @ return void
+static void bench_empty(int index) {
+    benchBuffer[0] = (char) index;
+}
+
+// Converts a 32-bit integer with fmt
+// @ param index - the input
+// @ return void
+static void bench_fmt_int32(int index) {
+    fmt_int32(benchInt32[index], benchBuffer);
+}
+
+// Converts a 32-bit integer with sprintf
+// @ param index - the input
+// @ return void
+static void bench_sprintf_int32(int index) {
+    sprintf(benchBuffer, "%ld", (long) benchInt32[index]);
+}
+
+// Converts a 64-bit integer with fmt
+// @ param index - the input
+// @ return void
+static void bench_fmt_int64(int index) {
+    fmt_int64(benchInt64[index], benchBuffer);
+}
+
+# if !defined(__arm__)
+// Converts a 64-bit integer with sprintf
+// @ param index - the input
+// @ return void
+static void bench_sprintf_int64(int index) {
+    sprintf(benchBuffer, "%lld", (long long) benchInt64[index]);
+}
+# endif
+
+// Converts a float with fmt at the default display precision
+// @ param index - the input
+// @ return void
+static void bench_fmt_float(int index) {
+    fmt_float(benchFloat[index], benchBuffer, 9);
+}
+
+// Converts a float with sprintf, which is not shortest but is what the display would use otherwise
+// @ param index - the input
+// @ return void
+static void bench_sprintf_float(int index) {
+    sprintf(benchBuffer, "%.9g", (double) benchFloat[index]);
+}
+
+// Applies the chosen scientific function to a float, or raises it to a power after the last function
+// @ param index - the input
+// @ return void
+static void bench_sci_float(int index) {
+    if (benchSciFunction == SCI_FUNCTIONS) {
+        sci_float_pow(benchSciFloat[index], benchSciExponent[index], &benchFloatResult);
+    } else {
+        sci_float(benchSciFunction, benchSciFloat[index], &benchFloatResult);
+    }
+}
+
+// Applies the chosen scientific function to a Q32.32 value, or raises it to a power after the last function
+// @ param index - the input
+// @ return void
+static void bench_sci_fixed(int index) {
+    if (benchSciFunction == SCI_FUNCTIONS) {
+        sci_fixed_pow(benchSciFixed[index], benchSciFixedExponent[index], &benchFixedResult);
+    } else {
+        sci_fixed(benchSciFunction, benchSciFixed[index], &benchFixedResult);
+    }
+}
@@ -0,0 +1,24 @@
+// file: bench.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for bench.c
+
+# ifndef BENCH_H
+# define BENCH_H
+
+# include <stdint.h>
+
+// Benchmark Limits
+# define BENCH_RESULTS_MAX 32
+
+// The cost of one call of a kernel
+typedef struct {
+    const char * name;
+    uint32_t cycles;
+} bench_result_t;
+
+// Runs every benchmark and stores the results
+int bench_run(bench_result_t * results, int capacity);
+
+# endif
@@ -0,0 +1,557 @@
+// file: bignum.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains fixed-capacity arbitrary-precision integer arithmetic
+
+# include <stdint.h>
+# include "bignum.h"
+# include "fmt.h"
+
+// Multiplication Characteristics
+// below this many limbs schoolbook multiplication beats the bookkeeping Karatsuba adds
+# define BIGNUM_KARATSUBA_THRESHOLD 24
+# define BIGNUM_SCRATCH_LIMBS (4 * BIGNUM_LIMBS + 64)
+
+// Conversion Characteristics
+// the magnitude is peeled into base 10^9 chunks, 1.07 chunks per limb
+# define BIGNUM_CHUNK 1000000000
+# define BIGNUM_CHUNK_DIGITS 9
+# define BIGNUM_CHUNKS (BIGNUM_LIMBS * 107 / 100 + 1)
+
+// Function Prototypes
+static void bignum_normalize(bignum_t * n);
+static void bignum_copy(bignum_t * result, const uint32_t * limbs, int length, int negative);
+static int bignum_compare_magnitude(const uint32_t * a, int aLength, const uint32_t * b, int bLength);
+static int bignum_add_signed(bignum_t * result, const bignum_t * a, const bignum_t * b, int bNegative);
+static void bignum_mul_schoolbook(uint32_t * result, const uint32_t * a, int aLength, const uint32_t * b, int bLength);
+static void bignum_mul_karatsuba(uint32_t * result, const uint32_t * a, const uint32_t * b, int length, uint32_t * scratch);
+static int bignum_divmod(bignum_t * quotient, bignum_t * remainder, const bignum_t * a, const bignum_t * b);
+static uint32_t bignum_div_small(uint32_t * limbs, int length, uint32_t divisor);
+
+// Working Storage
+// results are built here and copied out, so a result may alias either operand
+static uint32_t bignumProduct[2 * BIGNUM_LIMBS];
+static uint32_t bignumPadA[BIGNUM_LIMBS];
+static uint32_t bignumPadB[BIGNUM_LIMBS];
+static uint32_t bignumScratch[BIGNUM_SCRATCH_LIMBS];
+static uint32_t bignumDividend[BIGNUM_LIMBS + 1];
+static uint32_t bignumDivisor[BIGNUM_LIMBS];
+static uint32_t bignumQuotient[BIGNUM_LIMBS];
+static uint32_t bignumChunks[BIGNUM_CHUNKS];
+
+// Sets a bignum to a small integer
+// @ param n - the bignum to set
+// @ param value - the value
+// @ return void
+void bignum_set_int(bignum_t * n, int32_t value) {
+
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t) value : (uint32_t) value;
+
+    n->limbs[0] = magnitude;
+    n->length = magnitude != 0;
+    n->negative = value < 0;
+}
+
+// Multiplies a bignum by a small factor and adds a small value to it, used to enter digits
+// @ param n - the bignum to update
+// @ param factor - the factor to multiply by
+// @ param addend - the value to add to the magnitude
+// @ return BIGNUM_OK, or BIGNUM_ERROR_OVERFLOW if the result does not fit
+int bignum_mul_add_small(bignum_t * n, uint32_t factor, uint32_t addend) {
+
+    uint64_t carry = addend;
+
+    for (int i = 0; i < n->length; i++) {
+        uint64_t t = (uint64_t) n->limbs[i] * factor + carry;
+        n->limbs[i] = (uint32_t) t;
+        carry = t >> 32;
+    }
+
+    if (carry != 0) {
+        if (n->length == BIGNUM_LIMBS) {
+            return BIGNUM_ERROR_OVERFLOW;
+        }
+        n->limbs[n->length++] = (uint32_t) carry;
+    }
+
+    bignum_normalize(n);
+
+    return BIGNUM_OK;
+}
+
+// Adds two bignums
+// @ param result - where to store the sum, may be either operand, undefined on error
+// @ param a - the first operand
+// @ param b - the second operand
+// @ return BIGNUM_OK, or BIGNUM_ERROR_OVERFLOW if the sum does not fit
+int bignum_add(bignum_t * result, const bignum_t * a, const bignum_t * b) {
+    return bignum_add_signed(result, a, b, b->negative);
+}
+
+// Subtracts one bignum from another
+// @ param result - where to store the difference, may be either operand, undefined on error
+// @ param a - the minuend
+// @ param b - the subtrahend
+// @ return BIGNUM_OK, or BIGNUM_ERROR_OVERFLOW if the difference does not fit
+int bignum_sub(bignum_t * result, const bignum_t * a, const bignum_t * b) {
+    return bignum_add_signed(result, a, b, !b->negative && b->length != 0);
+}
+
+// Multiplies two bignums
+// schoolbook below BIGNUM_KARATSUBA_THRESHOLD limbs, Karatsuba above it
+// @ param result - where to store the product, may be either operand, undefined on error
+// @ param a - the first operand
+// @ param b - the second operand
+// @ return BIGNUM_OK, or BIGNUM_ERROR_OVERFLOW if the product does not fit
+int bignum_mul(bignum_t * result, const bignum_t * a, const bignum_t * b) {
+
+    int aLength = a->length;
+    int bLength = b->length;
+    int negative = a->negative != b->negative;
+
+    if (aLength == 0 || bLength == 0) {
+        bignum_set_int(result, 0);
+        return BIGNUM_OK;
+    }
+
+    int productLength;
+
+    if (aLength < BIGNUM_KARATSUBA_THRESHOLD || bLength < BIGNUM_KARATSUBA_THRESHOLD) {
+
+        bignum_mul_schoolbook(bignumProduct, a->limbs, aLength, b->limbs, bLength);
+        productLength = aLength + bLength;
+
+    } else {
+
+        // Karatsuba splits equal halves, so pad the shorter operand with zero limbs
+        int length = aLength > bLength ? aLength : bLength;
+
+        for (int i = 0; i < length; i++) {
+            bignumPadA[i] = i < aLength ? a->limbs[i] : 0;
+            bignumPadB[i] = i < bLength ? b->limbs[i] : 0;
+        }
+
+        bignum_mul_karatsuba(bignumProduct, bignumPadA, bignumPadB, length, bignumScratch);
+        productLength = 2 * length;
+    }
+
+    while (productLength > 0 && bignumProduct[productLength - 1] == 0) {
+        productLength--;
+    }
+
+    if (productLength > BIGNUM_LIMBS) {
+        return BIGNUM_ERROR_OVERFLOW;
+    }
+
+    bignum_copy(result, bignumProduct, productLength, negative);
+
+    return BIGNUM_OK;
+}
+
+// Divides one bignum by another, truncating toward zero
+// @ param result - where to store the quotient, may be either operand, undefined on error
+// @ param a - the dividend
+// @ param b - the divisor
+// @ return BIGNUM_OK, or BIGNUM_ERROR_DIVIDE if the divisor is zero
+int bignum_div(bignum_t * result, const bignum_t * a, const bignum_t * b) {
+    return bignum_divmod(result, 0, a, b);
+}
+
+// Gets the remainder of dividing one bignum by another, with the sign of the dividend
+// @ param result - where to store the remainder, may be either operand, undefined on error
+// @ param a - the dividend
+// @ param b - the divisor
+// @ return BIGNUM_OK, or BIGNUM_ERROR_DIVIDE if the divisor is zero
+int bignum_mod(bignum_t * result, const bignum_t * a, const bignum_t * b) {
+    return bignum_divmod(0, result, a, b);
+}
+
+// Writes a bignum to a buffer in decimal
+// @ param n - the bignum to write
+// @ param buffer - the buffer to write to, at least BIGNUM_STRING_SIZE characters
+// @ return the number of characters written, not counting the null terminator
+int bignum_to_string(const bignum_t * n, char * buffer) {
+
+    if (n->length == 0) {
+        buffer[0] = '0';
+        buffer[1] = '\0';
+        return 1;
+    }
+
+    // peel off base 10^9 chunks from the least significant end, one short division each
+    int length = n->length;
+    int chunkCount = 0;
+
+    for (int i = 0; i < length; i++) {
+        bignumDividend[i] = n->limbs[i];
+    }
+
+    while (length > 0) {
+        bignumChunks[chunkCount++] = bignum_div_small(bignumDividend, length, BIGNUM_CHUNK);
+        while (length > 0 && bignumDividend[length - 1] == 0) {
+            length--;
+        }
+    }
+
+    // the top chunk has no leading zeros, every chunk below it is zero padded
+    int offset = 0;
+
+    if (n->negative) {
+        buffer[offset++] = '-';
+    }
+
+    offset += fmt_uint32(bignumChunks[chunkCount - 1], buffer + offset);
+
+    for (int i = chunkCount - 2; i >= 0; i--) {
+        offset += fmt_uint32_padded(bignumChunks[i], buffer + offset, BIGNUM_CHUNK_DIGITS);
+    }
+
+    return offset;
+}
+
+// Drops zero limbs from the top of a bignum and clears the sign of zero
+// @ param n - the bignum to normalize
+// @ return void
+static void bignum_normalize(bignum_t * n) {
+
+    while (n->length > 0 && n->limbs[n->length - 1] == 0) {
+        n->length--;
+    }
+
+    if (n->length == 0) {
+        n->negative = 0;
+    }
+}
+
+// Copies a magnitude and sign into a bignum
+// @ param result - the bignum to copy to
+// @ param limbs - the magnitude to copy
+// @ param length - the number of limbs in the magnitude, at most BIGNUM_LIMBS
+// @ param negative - the sign
+// @ return void
+static void bignum_copy(bignum_t * result, const uint32_t * limbs, int length, int negative) {
+
+    for (int i = 0; i < length; i++) {
+        result->limbs[i] = limbs[i];
+    }
+
+    result->length = length;
+    result->negative = negative;
+    bignum_normalize(result);
+}
+
+// Compares two magnitudes
+// @ param a - the first magnitude
+// @ param aLength - the number of limbs in the first magnitude
+// @ param b - the second magnitude
+// @ param bLength - the number of limbs in the second magnitude
+// @ return a negative value, zero, or a positive value as a is less than, equal to, or greater than b
+static int bignum_compare_magnitude(const uint32_t * a, int aLength, const uint32_t * b, int bLength) {
+
+    if (aLength != bLength) {
+        return aLength - bLength;
+    }
+
+    for (int i = aLength - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i] ? 1 : -1;
+        }
+    }
+
+    return 0;
+}
+
+// Adds a bignum with the given sign to another, the shared body of add and subtract
+// each limb is read before it is written, so the result may alias either operand
+// @ param result - where to store the sum
+// @ param a - the first operand
+// @ param b - the second operand, whose sign is replaced by bNegative
+// @ param bNegative - the sign to give the second operand
+// @ return BIGNUM_OK, or BIGNUM_ERROR_OVERFLOW if the sum does not fit
+static int bignum_add_signed(bignum_t * result, const bignum_t * a, const bignum_t * b, int bNegative) {
+
+    int aNegative = a->negative;
+
+    // order the operands so the larger magnitude comes first
+    const bignum_t * large = a;
+    const bignum_t * small = b;
+    int largeNegative = aNegative;
+
+    if (bignum_compare_magnitude(a->limbs, a->length, b->limbs, b->length) < 0) {
+        large = b;
+        small = a;
+        largeNegative = bNegative;
+    }
+
+    int largeLength = large->length;
+    int smallLength = small->length;
+
+    if (aNegative == bNegative) {
+
+        // same signs add magnitudes
+        uint64_t carry = 0;
+
+        for (int i = 0; i < largeLength; i++) {
+            carry += (uint64_t) large->limbs[i] + (i < smallLength ? small->limbs[i] : 0);
+            result->limbs[i] = (uint32_t) carry;
+            carry >>= 32;
+        }
+
+        result->length = largeLength;
+
+        if (carry != 0) {
+            if (largeLength == BIGNUM_LIMBS) {
+                return BIGNUM_ERROR_OVERFLOW;
+            }
+            result->limbs[result->length++] = (uint32_t) carry;
+        }
+
+    } else {
+
+        // opposite signs subtract the smaller magnitude from the larger
+        uint32_t borrow = 0;
+
+        for (int i = 0; i < largeLength; i++) {
+            uint64_t t = (uint64_t) large->limbs[i] - (i < smallLength ? small->limbs[i] : 0) - borrow;
+            result->limbs[i] = (uint32_t) t;
+            borrow = (t >> 32) & 1;
+        }
+
+        result->length = largeLength;
+    }
+
+    result->negative = largeNegative;
+    bignum_normalize(result);
+
+    return BIGNUM_OK;
+}
+
+// Multiplies two magnitudes one limb at a time
+// @ param result - where to store the product, aLength + bLength limbs, must not overlap an operand
+// @ param a - the first magnitude
+// @ param aLength - the number of limbs in the first magnitude
+// @ param b - the second magnitude
+// @ param bLength - the number of limbs in the second magnitude
+// @ return void
+static void bignum_mul_schoolbook(uint32_t * result, const uint32_t * a, int aLength, const uint32_t * b, int bLength) {
+
+    for (int i = 0; i < aLength + bLength; i++) {
+        result[i] = 0;
+    }
+
+    for (int i = 0; i < aLength; i++) {
+
+        uint64_t carry = 0;
+        uint32_t ai = a[i];
+
+        for (int j = 0; j < bLength; j++) {
+            uint64_t t = (uint64_t) ai * b[j] + result[i + j] + carry;
+            result[i + j] = (uint32_t) t;
+            carry = t >> 32;
+        }
+
+        result[i + bLength] = (uint32_t) carry;
+    }
+}
+
+// Multiplies two equal length magnitudes with Karatsuba's three half size products
+// recursion depth is log2(BIGNUM_LIMBS / BIGNUM_KARATSUBA_THRESHOLD), four levels at most
+// @ param result - where to store the product, 2 * length limbs, must not overlap an operand
+// @ param a - the first magnitude
+// @ param b - the second magnitude
+// @ param length - the number of limbs in each magnitude
+// @ param scratch - working storage, about 4 * length limbs
+// @ return void
+static void bignum_mul_karatsuba(uint32_t * result, const uint32_t * a, const uint32_t * b, int length, uint32_t * scratch) {
+
+    if (length < BIGNUM_KARATSUBA_THRESHOLD) {
+        bignum_mul_schoolbook(result, a, length, b, length);
+        return;
+    }
+
+    // split each operand into a low half of m limbs and a high half of h limbs
+    int m = length / 2;
+    int h = length - m;
+
+    // z0 = a0 * b0 and z2 = a1 * b1 go straight into the low and high halves of the result
+    bignum_mul_karatsuba(result, a, b, m, scratch);
+    bignum_mul_karatsuba(result + 2 * m, a + m, b + m, h, scratch);
+
+    // (a0 + a1) and (b0 + b1), one limb wider than the high halves
+    uint32_t * aSum = scratch;
+    uint32_t * bSum = scratch + h + 1;
+    uint32_t * z1 = scratch + 2 * (h + 1);
+    uint64_t aCarry = 0;
+    uint64_t bCarry = 0;
+
+    for (int i = 0; i < h; i++) {
+        aCarry += (uint64_t) a[m + i] + (i < m ? a[i] : 0);
+        bCarry += (uint64_t) b[m + i] + (i < m ? b[i] : 0);
+        aSum[i] = (uint32_t) aCarry;
+        bSum[i] = (uint32_t) bCarry;
+        aCarry >>= 32;
+        bCarry >>= 32;
+    }
+
+    aSum[h] = (uint32_t) aCarry;
+    bSum[h] = (uint32_t) bCarry;
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    bignum_mul_karatsuba(z1, aSum, bSum, h + 1, scratch + 4 * (h + 1));
+
+    int64_t borrow = 0;
+    for (int i = 0; i < 2 * (h + 1); i++) {
+        borrow += (int64_t) z1[i] - (i < 2 * m ? result[i] : 0) - (i < 2 * h ? result[2 * m + i] : 0);
+        z1[i] = (uint32_t) borrow;
+        borrow >>= 32;
+    }
+
+    // add z1 in at the middle, the full product fits in 2 * length limbs
+    uint64_t carry = 0;
+    for (int i = m; i < 2 * length; i++) {
+        carry += (uint64_t) result[i] + (i - m < 2 * (h + 1) ? z1[i - m] : 0);
+        result[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+}
+
+// Divides one bignum by another with Knuth's algorithm D
+// @ param quotient - where to store the quotient, or 0 if it is not needed
+// @ param remainder - where to store the remainder, or 0 if it is not needed
+// @ param a - the dividend
+// @ param b - the divisor
+// @ return BIGNUM_OK, or BIGNUM_ERROR_DIVIDE if the divisor is zero
+static int bignum_divmod(bignum_t * quotient, bignum_t * remainder, const bignum_t * a, const bignum_t * b) {
+
+    int m = a->length;
+    int n = b->length;
+    int quotientNegative = a->negative != b->negative;
+    int remainderNegative = a->negative;
+
+    if (n == 0) {
+        return BIGNUM_ERROR_DIVIDE;
+    }
+
+    // a smaller dividend is all remainder
+    if (bignum_compare_magnitude(a->limbs, m, b->limbs, n) < 0) {
+        if (remainder != 0) {
+            bignum_copy(remainder, a->limbs, m, remainderNegative);
+        }
+        if (quotient != 0) {
+            bignum_set_int(quotient, 0);
+        }
+        return BIGNUM_OK;
+    }
+
+    // a single limb divisor only needs a short division
+    if (n == 1) {
+
+        for (int i = 0; i < m; i++) {
+            bignumDividend[i] = a->limbs[i];
+        }
+
+        uint32_t rest = bignum_div_small(bignumDividend, m, b->limbs[0]);
+
+        if (remainder != 0) {
+            bignum_copy(remainder, &rest, 1, remainderNegative);
+        }
+        if (quotient != 0) {
+            bignum_copy(quotient, bignumDividend, m, quotientNegative);
+        }
+        return BIGNUM_OK;
+    }
+
+    // normalize so the top divisor limb has its high bit set, which keeps each quotient estimate within two
+    int shift = __builtin_clz(b->limbs[n - 1]);
+    uint32_t * u = bignumDividend;
+    uint32_t * v = bignumDivisor;
+
+    for (int i = n - 1; i > 0; i--) {
+        v[i] = (b->limbs[i] << shift) | (shift ? b->limbs[i - 1] >> (32 - shift) : 0);
+    }
+    v[0] = b->limbs[0] << shift;
+
+    u[m] = shift ? a->limbs[m - 1] >> (32 - shift) : 0;
+    for (int i = m - 1; i > 0; i--) {
+        u[i] = (a->limbs[i] << shift) | (shift ? a->limbs[i - 1] >> (32 - shift) : 0);
+    }
+    u[0] = a->limbs[0] << shift;
+
+    for (int j = m - n; j >= 0; j--) {
+
+        // estimate the quotient limb from the top two dividend limbs and correct it
+        uint64_t top = ((uint64_t) u[j + n] << 32) | u[j + n - 1];
+        uint64_t qhat = top / v[n - 1];
+        uint64_t rhat = top - qhat * v[n - 1];
+
+        while (qhat > 0xFFFFFFFF || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            qhat--;
+            rhat += v[n - 1];
+            if (rhat > 0xFFFFFFFF) {
+                break;
+            }
+        }
+
+        // multiply and subtract
+        int64_t t;
+        int64_t k = 0;
+
+        for (int i = 0; i < n; i++) {
+            uint64_t p = qhat * v[i];
+            t = (int64_t) u[i + j] - k - (int64_t) (p & 0xFFFFFFFF);
+            u[i + j] = (uint32_t) t;
+            k = (int64_t) (p >> 32) - (t >> 32);
+        }
+
+        t = (int64_t) u[j + n] - k;
+        u[j + n] = (uint32_t) t;
+
+        // the estimate was one too large, add the divisor back
+        if (t < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (int i = 0; i < n; i++) {
+                carry += (uint64_t) u[i + j] + v[i];
+                u[i + j] = (uint32_t) carry;
+                carry >>= 32;
+            }
+            u[j + n] += (uint32_t) carry;
+        }
+
+        bignumQuotient[j] = (uint32_t) qhat;
+    }
+
+    // undo the normalization on the remainder
+    if (remainder != 0) {
+        for (int i = 0; i < n - 1; i++) {
+            u[i] = (u[i] >> shift) | (shift ? u[i + 1] << (32 - shift) : 0);
+        }
+        u[n - 1] >>= shift;
+        bignum_copy(remainder, u, n, remainderNegative);
+    }
+
+    if (quotient != 0) {
+        bignum_copy(quotient, bignumQuotient, m - n + 1, quotientNegative);
+    }
+
+    return BIGNUM_OK;
+}
+
+// Divides a magnitude in place by a single limb
+// @ param limbs - the magnitude to divide, replaced by the quotient
+// @ param length - the number of limbs in the magnitude
+// @ param divisor - the divisor, not zero
+// @ return the remainder
+static uint32_t bignum_div_small(uint32_t * limbs, int length, uint32_t divisor) {
+
+    uint64_t rest = 0;
+
+    for (int i = length - 1; i >= 0; i--) {
+        uint64_t t = (rest << 32) | limbs[i];
+        limbs[i] = (uint32_t) (t / divisor);
+        rest = t % divisor;
+    }
+
+    return (uint32_t) rest;
+}
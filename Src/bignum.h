@@ -0,0 +1,55 @@
+// file: bignum.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for bignum.c
+
+# ifndef BIGNUM_H
+# define BIGNUM_H
+
+# include <stdint.h>
+
+// Bignum Capacity
+// 216 limbs of 32 bits hold 2080 decimal digits, the product of two 1000 digit operands
+# define BIGNUM_LIMBS 216
+# define BIGNUM_MAX_DIGITS 1000
+# define BIGNUM_STRING_SIZE 2088
+
+// Bignum Status Codes
+# define BIGNUM_OK 0
+# define BIGNUM_ERROR_OVERFLOW 1
+# define BIGNUM_ERROR_DIVIDE 2
+
+// Bignum
+// sign and magnitude, the magnitude is little endian with no zero limbs above length
+typedef struct {
+    uint16_t length;
+    uint8_t negative;
+    uint32_t limbs[BIGNUM_LIMBS];
+} bignum_t;
+
+// Sets a bignum to a small integer
+void bignum_set_int(bignum_t * n, int32_t value);
+
+// Multiplies a bignum by a small factor and adds a small value to it
+int bignum_mul_add_small(bignum_t * n, uint32_t factor, uint32_t addend);
+
+// Adds two bignums
+int bignum_add(bignum_t * result, const bignum_t * a, const bignum_t * b);
+
+// Subtracts one bignum from another
+int bignum_sub(bignum_t * result, const bignum_t * a, const bignum_t * b);
+
+// Multiplies two bignums
+int bignum_mul(bignum_t * result, const bignum_t * a, const bignum_t * b);
+
+// Divides one bignum by another, truncating toward zero
+int bignum_div(bignum_t * result, const bignum_t * a, const bignum_t * b);
+
+// Gets the remainder of dividing one bignum by another, with the sign of the dividend
+int bignum_mod(bignum_t * result, const bignum_t * a, const bignum_t * b);
+
+// Writes a bignum to a buffer in decimal
+int bignum_to_string(const bignum_t * n, char * buffer);
+
+# endif
@@ -0,0 +1,1833 @@
+// file: calc.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the calculator front end that turns keymap actions into expressions on the LCD
+
+# include <stdint.h>
+# include "calc.h"
+# include "expr.h"
+# include "rpn.h"
+# include "history.h"
+# include "memory.h"
+# include "arith.h"
+# include "bignum.h"
+# include "decimal.h"
+# include "sci.h"
+# include "fmt.h"
+# include "keymap.h"
+# include "lcd_driver.h"
+# include "delay.h"
+
+// Display Characteristics
+# define CALC_LCD_COLUMNS 16
+# define CALC_SCROLL_STEP 8
+# define CALC_RPN_VALUE_COLUMNS 14
+# define CALC_RPN_ENTRY_COLUMNS 13
+# define CALC_MEMORY_COLUMN 14
+# define CALC_TAG_COLUMNS 7
+
+// Float Entry
+// a float operand holds at most 9 significant digits, as many as a float can tell apart
+# define CALC_FLOAT_DIGITS_MAX 999999999
+# define CALC_FLOAT_FRACTION_MAX 9
+
+// Value Text
+// the widest text of a single value, a 64-bit word in binary
+# define CALC_VALUE_SIZE FMT_RADIX_SIZE
+
+// Expression Text
+// the expression as typed, kept so the top row can scroll over it, large enough for a chained
+// bignum result, an operator, and a full bignum operand
+# define CALC_TEXT_SIZE (BIGNUM_STRING_SIZE + BIGNUM_MAX_DIGITS + 2)
+
+// History Entry Text
+// a recalled calculation as its operands, its operator, and its result, with a negative right
+// operand in parentheses, which a stack entry holds in place of the text it would be typed as
+# define CALC_ENTRY_SIZE (3 * CALC_VALUE_SIZE + 4)
+
+_Static_assert(CALC_ENTRY_SIZE <= CALC_TEXT_SIZE, "a history entry does not fit in the text");
+
+// Function Prototypes
+static int calc_arith_type(void);
+static int calc_radix(void);
+static void calc_clear(int action);
+static void calc_next_mode(int action);
+static void calc_toggle_rpn(int action);
+static void calc_scroll_key(int action);
+static void calc_next_base(int action);
+static void calc_step_base(void);
+static void calc_digit(int action);
+static void calc_operator(int action);
+static void calc_open(int action);
+static void calc_close(int action);
+static void calc_point(int action);
+static void calc_equals(int action);
+static void calc_result(expr_value_t left, expr_value_t result);
+static void calc_error(void);
+static void calc_function(int action);
+static void calc_recall(int action);
+static int calc_recall_find(int action, expr_value_t * value);
+static void calc_place_operand(int index, expr_value_t value);
+static int calc_recall_format(char * buffer);
+static void calc_recall_draw(void);
+static void calc_memory_update(int action);
+static void calc_memory_recall(int action);
+static void calc_memory_clear(int action);
+static void calc_memory_slot(int action);
+static void calc_memory_apply(int action, expr_value_t value);
+static void calc_memory_indicator(char * cells);
+static void calc_memory_draw(void);
+static int calc_push_operand(void);
+static int calc_operand_digit(int digit);
+static int calc_operand_point(void);
+static int calc_operand_is_zero(void);
+static expr_value_t calc_operand_value(void);
+static void calc_operand_reset(void);
+static void calc_operand_recall(int index, expr_value_t value);
+static int calc_format(expr_value_t value, char * buffer);
+static void calc_big_digit(int action);
+static void calc_big_operator(int action);
+static void calc_big_equals(int action);
+static int calc_big_apply(void);
+static void calc_rpn_digit(int action);
+static void calc_rpn_point(int action);
+static void calc_rpn_clear(int action);
+static void calc_rpn_enter(int action);
+static void calc_rpn_operator(int action);
+static void calc_rpn_function(int action);
+static void calc_rpn_swap(int action);
+static void calc_rpn_drop(int action);
+static void calc_rpn_roll(int action);
+static void calc_rpn_recall(int action);
+static void calc_rpn_next_base(int action);
+static void calc_rpn_memory_update(int action);
+static void calc_rpn_memory_recall(int action);
+static void calc_rpn_place_entry(int index, expr_value_t value);
+static void calc_rpn_record(char operator, expr_value_t left, expr_value_t right);
+static void calc_rpn_push_entry(void);
+static void calc_rpn_draw(void);
+static void calc_rpn_level_row(int level, char * row);
+static void calc_chain(void);
+static void calc_clear_display(void);
+static void calc_tag_draw(void);
+static void calc_show_result(void);
+static void calc_append(char character);
+static void calc_redraw(void);
+static void calc_view_update(int offset);
+static void calc_scroll(int step);
+static void calc_view_draw(int offset);
+static void calc_easter_egg(void);
+
+// Mode Tags
+// shown on the bottom row in every mode but the default one
+static const char * const calcModeTags[CALC_MODES] = { "", "I64", "FLT", "DEC", "BIG" };
+
+// Base Tags
+// shown after the mode tag while integers are shown in a base other than decimal
+static const char * const calcBaseTags[] = { [2] = "BIN", [8] = "OCT", [16] = "HEX" };
+
+// Error Text
+// shown in place of a result the arithmetic type cannot hold or that has no value
+static const char calcErrorText[] = "Error";
+
+// Operator Characters
+// indexed by (action - ACTION_ADD), the bitwise ones as arith_int takes them
+static const char calcOperators[] = { '+', '-', '*', '/', '%', '^', '&', '|', 'x', '<', '>' };
+
+// Powers of Ten
+// every power up to 10^9 is exact in a float, so scaling an operand rounds only once
+static const float calcPowersOfTen[CALC_FLOAT_FRACTION_MAX + 1] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f
+};
+
+// Calculator States
+// infix entry in each mode, then stack entry in each mode that has a stack, so the state of an
+// infix mode is the mode itself and the state of a stack mode is CALC_STATE_RPN_INT + the mode
+enum calc_state {
+    CALC_STATE_INT,
+    CALC_STATE_INT64,
+    CALC_STATE_FLOAT,
+    CALC_STATE_DECIMAL,
+    CALC_STATE_BIG,
+    CALC_STATE_RPN_INT,
+    CALC_STATE_RPN_INT64,
+    CALC_STATE_RPN_FLOAT,
+    CALC_STATE_RPN_DECIMAL,
+    CALC_STATES
+};
+
+// Action Handlers
+// every handler takes the action that triggered it, so one handler can serve a group of keys
+typedef void (* calc_handler_t)(int action);
+
+// Transition Table Groups
+// the handlers a group of states share, used to build the rows of the transition table
+# define CALC_DIGIT_EVENTS(handler) \
+    [ACTION_DIGIT_0] = handler, [ACTION_DIGIT_1] = handler, [ACTION_DIGIT_2] = handler, \
+    [ACTION_DIGIT_3] = handler, [ACTION_DIGIT_4] = handler, [ACTION_DIGIT_5] = handler, \
+    [ACTION_DIGIT_6] = handler, [ACTION_DIGIT_7] = handler, [ACTION_DIGIT_8] = handler, \
+    [ACTION_DIGIT_9] = handler
+
+# define CALC_BITWISE_EVENTS(digit, operator, function, base) \
+    [ACTION_DIGIT_A] = digit, [ACTION_DIGIT_B] = digit, [ACTION_DIGIT_C] = digit, \
+    [ACTION_DIGIT_D] = digit, [ACTION_DIGIT_E] = digit, [ACTION_DIGIT_F] = digit, \
+    [ACTION_AND] = operator, [ACTION_OR] = operator, [ACTION_XOR] = operator, \
+    [ACTION_SHIFT_LEFT] = operator, [ACTION_SHIFT_RIGHT] = operator, \
+    [ACTION_NOT] = function, [ACTION_BASE] = base
+
+# define CALC_OPERATOR_EVENTS(handler) \
+    [ACTION_ADD] = handler, [ACTION_SUBTRACT] = handler, [ACTION_MULTIPLY] = handler, \
+    [ACTION_DIVIDE] = handler, [ACTION_MODULO] = handler
+
+# define CALC_FRACTION_EVENTS(function, point) \
+    [ACTION_SIN] = function, [ACTION_COS] = function, [ACTION_TAN] = function, \
+    [ACTION_EXP] = function, [ACTION_LN] = function, [ACTION_POINT] = point
+
+# define CALC_MODE_EVENTS \
+    [ACTION_MODE] = calc_next_mode, [ACTION_RPN] = calc_toggle_rpn
+
+# define CALC_MEMORY_EVENTS(update, recall) \
+    [ACTION_MEMORY_ADD] = update, [ACTION_MEMORY_SUBTRACT] = update, [ACTION_MEMORY_RECALL] = recall, \
+    [ACTION_MEMORY_CLEAR] = calc_memory_clear, [ACTION_MEMORY_SLOT] = calc_memory_slot
+
+# define CALC_INFIX_EVENTS \
+    CALC_DIGIT_EVENTS(calc_digit), CALC_OPERATOR_EVENTS(calc_operator), CALC_MODE_EVENTS, \
+    [ACTION_POWER] = calc_operator, [ACTION_SQRT] = calc_function, \
+    [ACTION_EQUALS] = calc_equals, [ACTION_CLEAR] = calc_clear, \
+    [ACTION_OPEN] = calc_open, [ACTION_CLOSE] = calc_close, \
+    [ACTION_SCROLL_LEFT] = calc_scroll_key, [ACTION_SCROLL_RIGHT] = calc_scroll_key, \
+    [ACTION_HISTORY_UP] = calc_recall, [ACTION_HISTORY_DOWN] = calc_recall, \
+    CALC_MEMORY_EVENTS(calc_memory_update, calc_memory_recall)
+
+# define CALC_RPN_EVENTS \
+    CALC_DIGIT_EVENTS(calc_rpn_digit), CALC_OPERATOR_EVENTS(calc_rpn_operator), CALC_MODE_EVENTS, \
+    [ACTION_POWER] = calc_rpn_operator, [ACTION_SQRT] = calc_rpn_function, \
+    [ACTION_EQUALS] = calc_rpn_enter, [ACTION_CLEAR] = calc_rpn_clear, \
+    [ACTION_SWAP] = calc_rpn_swap, [ACTION_DROP] = calc_rpn_drop, [ACTION_ROLL] = calc_rpn_roll, \
+    [ACTION_HISTORY_UP] = calc_rpn_recall, [ACTION_HISTORY_DOWN] = calc_rpn_recall, \
+    CALC_MEMORY_EVENTS(calc_rpn_memory_update, calc_rpn_memory_recall)
+
+// Transition Table
+// the handler of every action in every state, an action with no handler does nothing in that state,
+// so a mode's restrictions live here: integers only have a square root and no point but have the
+// bitwise operators and other bases, and bignum mode has no powers, functions, parentheses, stack, or memory
+static const calc_handler_t calcTransitions[CALC_STATES][ACTION_COUNT] =
+{
+    [CALC_STATE_INT] = { CALC_INFIX_EVENTS, CALC_BITWISE_EVENTS(calc_digit, calc_operator, calc_function, calc_next_base) },
+    [CALC_STATE_INT64] = { CALC_INFIX_EVENTS, CALC_BITWISE_EVENTS(calc_digit, calc_operator, calc_function, calc_next_base) },
+    [CALC_STATE_FLOAT] = { CALC_INFIX_EVENTS, CALC_FRACTION_EVENTS(calc_function, calc_point) },
+    [CALC_STATE_DECIMAL] = { CALC_INFIX_EVENTS, CALC_FRACTION_EVENTS(calc_function, calc_point) },
+
+    [CALC_STATE_BIG] = {
+        CALC_DIGIT_EVENTS(calc_big_digit), CALC_OPERATOR_EVENTS(calc_big_operator), CALC_MODE_EVENTS,
+        [ACTION_EQUALS] = calc_big_equals, [ACTION_CLEAR] = calc_clear,
+        [ACTION_SCROLL_LEFT] = calc_scroll_key, [ACTION_SCROLL_RIGHT] = calc_scroll_key
+    },
+
+    [CALC_STATE_RPN_INT] = {
+        CALC_RPN_EVENTS, CALC_BITWISE_EVENTS(calc_rpn_digit, calc_rpn_operator, calc_rpn_function, calc_rpn_next_base)
+    },
+    [CALC_STATE_RPN_INT64] = {
+        CALC_RPN_EVENTS, CALC_BITWISE_EVENTS(calc_rpn_digit, calc_rpn_operator, calc_rpn_function, calc_rpn_next_base)
+    },
+    [CALC_STATE_RPN_FLOAT] = { CALC_RPN_EVENTS, CALC_FRACTION_EVENTS(calc_rpn_function, calc_rpn_point) },
+    [CALC_STATE_RPN_DECIMAL] = { CALC_RPN_EVENTS, CALC_FRACTION_EVENTS(calc_rpn_function, calc_rpn_point) }
+};
+
+// Calculator State
+static uint8_t calcState = CALC_STATE_INT;
+static int calcMode = CALC_MODE_INT;
+static int calcFloatPrecision = CALC_FLOAT_PRECISION;
+static int calcBase = 10;
+static char calcText[CALC_TEXT_SIZE];
+static int calcTextLength;
+static int calcViewOffset;
+static char calcResultDisplayed;
+
+// Integer Mode State
+// the operator and right operand of the last calculation are kept so equals can repeat it
+static expr_t calcExpr;
+static char calcRepeatOperator;
+static expr_value_t calcRepeatOperand;
+static int64_t calcOperand;
+static int calcOperandLength;
+static int calcOperandFraction;
+static char calcOperandPoint;
+
+// Recalled Operand
+// an operand recalled from the history keeps its binary value, so it is used exactly rather than
+// parsed back from its text, and remembers which entry it is so the recall keys can step from it
+static char calcRecalled;
+static int calcRecallIndex = -1;
+static expr_value_t calcRecallValue;
+
+// Recalled Entry Display
+// whether the top row shows a recalled calculation in place of the text, until the next key
+static char calcRecallShown;
+
+// Operand Text
+// where the text of the operand the expression ends with begins, so a function can replace it
+// with its result, and where the text of each open parenthesis begins
+static int calcValueStart;
+static int calcOpenStarts[EXPR_MAX_DEPTH];
+
+// Bignum Mode State
+// bignum mode executes each operator as soon as its right operand is complete
+static bignum_t calcBigAccumulator;
+static bignum_t calcBigOperand;
+static char calcBigOperator;
+static char calcBigHasAccumulator;
+static char calcBigRepeatOperator;
+
+// RPN Mode State
+// the stack replaces the expression in every mode but bignum, and the text holds only the entry
+static rpn_t calcStack;
+static char calcRpn;
+static int calcRpnDepth = RPN_DEPTH_DEFAULT;
+static char calcRpnError;
+
+// Memory State
+// the register the memory keys act on, and whether the last update to it failed
+static int calcMemorySlot;
+static char calcMemoryError;
+
+// Clears the calculator and the LCD
+// @ param void
+// @ return void
+void calc_init(void) {
+
+    expr_init(&calcExpr, calc_arith_type());
+    calc_operand_reset();
+    calcValueStart = 0;
+    calcBigOperator = 0;
+    calcBigHasAccumulator = 0;
+    calcBigRepeatOperator = 0;
+    calcRepeatOperator = 0;
+    calcTextLength = 0;
+    calcViewOffset = 0;
+    calcResultDisplayed = 0;
+    calcMemoryError = 0;
+    calcRpnError = 0;
+    calcRecallShown = 0;
+
+    // bignum mode has no stack and keeps its infix entry either way
+    calcState = (calcRpn && calcMode != CALC_MODE_BIG) ? CALC_STATE_RPN_INT + calcMode : calcMode;
+
+    // the bitwise layer takes the place of the functions, which integers in other bases have no use for
+    keymap_set_func_layer(calc_radix() != 10 ? KEYMAP_LAYER_BITS : KEYMAP_LAYER_FUNC);
+
+    if (calcState >= CALC_STATE_RPN_INT) {
+        rpn_init(&calcStack, calc_arith_type(), calcRpnDepth);
+        lcd_clear();
+        calc_rpn_draw();
+    } else {
+        calc_clear_display();
+    }
+}
+
+// Selects the number mode and clears the calculator
+// @ param mode - one of the CALC_MODE values
+// @ return void
+void calc_set_mode(int mode) {
+
+    if (mode < 0 || mode >= CALC_MODES) {
+        return;
+    }
+
+    calcMode = mode;
+    calc_init();
+}
+
+// Gets the number mode
+// @ param void
+// @ return the number mode
+int calc_get_mode(void) {
+    return calcMode;
+}
+
+// Sets how many significant digits float results show
+// @ param digits - the number of digits, 1-9
+// @ return void
+void calc_set_float_precision(int digits) {
+
+    if (digits < 1 || digits > 9) {
+        return;
+    }
+
+    calcFloatPrecision = digits;
+}
+
+// Gets how many significant digits float results show
+// @ param void
+// @ return the number of digits
+int calc_get_float_precision(void) {
+    return calcFloatPrecision;
+}
+
+// Selects the base integers are typed and shown in and clears the calculator
+// the 32 and 64-bit modes show other bases as the zero padded bits of the word, every other mode
+// stays in decimal
+// @ param base - 2, 8, 10, or 16
+// @ return void
+void calc_set_base(int base) {
+
+    if (base != 2 && base != 8 && base != 10 && base != 16) {
+        return;
+    }
+
+    calcBase = base;
+    calc_init();
+}
+
+// Gets the base integers are typed and shown in
+// @ param void
+// @ return 2, 8, 10, or 16
+int calc_get_base(void) {
+    return calcBase;
+}
+
+// Switches reverse polish notation entry on or off and clears the calculator
+// bignum mode has no stack and keeps its infix entry either way
+// @ param enabled - 1 for reverse polish notation, 0 for infix
+// @ return void
+void calc_set_rpn(int enabled) {
+    calcRpn = (enabled != 0);
+    calc_init();
+}
+
+// Checks whether reverse polish notation entry is selected
+// @ param void
+// @ return 1 if it is selected, otherwise 0
+int calc_get_rpn(void) {
+    return calcRpn;
+}
+
+// Sets how many values the reverse polish notation stack holds and clears the calculator
+// @ param depth - the number of values, 2-RPN_DEPTH_MAX
+// @ return void
+void calc_set_rpn_depth(int depth) {
+
+    if (depth < 2 || depth > RPN_DEPTH_MAX) {
+        return;
+    }
+
+    calcRpnDepth = depth;
+    calc_init();
+}
+
+// Gets how many values the reverse polish notation stack holds
+// @ param void
+// @ return the number of values
+int calc_get_rpn_depth(void) {
+    return calcRpnDepth;
+}
+
+// Performs a keymap action on the calculator
+// tokens that do not fit the expression so far, or that the mode has no use for, are ignored
+// @ param action - the action to perform
+// @ return void
+void calc_handle(int action) {
+
+    // the expression text is full, only evaluating, clearing, and scrolling are accepted
+    if (calcTextLength == CALC_TEXT_SIZE && action != ACTION_EQUALS && action != ACTION_CLEAR &&
+        action != ACTION_SCROLL_LEFT && action != ACTION_SCROLL_RIGHT) {
+        return;
+    }
+
+    if (action < 0 || action >= ACTION_COUNT) {
+        return;
+    }
+
+    // a recalled calculation covers the top row until any key but another recall puts the text back
+    if (calcRecallShown && action != ACTION_HISTORY_UP && action != ACTION_HISTORY_DOWN) {
+        calcRecallShown = 0;
+        calc_redraw();
+    }
+
+    // one lookup finds what the action does in the current state
+    calc_handler_t handler = calcTransitions[calcState][action];
+
+    if (handler != 0) {
+        handler(action);
+    }
+}
+
+// Gets the arithmetic type the expression evaluates in for the current mode
+// @ param void
+// @ return the type for the 64-bit, float, and decimal modes, otherwise ARITH_TYPE_INT32
+static int calc_arith_type(void) {
+
+    switch (calcMode) {
+        case CALC_MODE_INT64:
+            return ARITH_TYPE_INT64;
+        case CALC_MODE_FLOAT:
+            return ARITH_TYPE_FLOAT;
+        case CALC_MODE_DECIMAL:
+            return ARITH_TYPE_DECIMAL;
+        default:
+            return ARITH_TYPE_INT32;
+    }
+}
+
+// Gets the base values are typed and shown in for the current mode
+// @ param void
+// @ return the selected base in the 32 and 64-bit modes, otherwise 10
+static int calc_radix(void) {
+    return (calcMode == CALC_MODE_INT || calcMode == CALC_MODE_INT64) ? calcBase : 10;
+}
+
+// Clears the calculator
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_clear(int action) {
+    calc_init();
+}
+
+// Selects the next number mode
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_next_mode(int action) {
+    calc_set_mode((calcMode + 1) % CALC_MODES);
+}
+
+// Switches between infix and reverse polish notation entry
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_toggle_rpn(int action) {
+    calc_set_rpn(!calcRpn);
+}
+
+// Scrolls the top row by a step in the direction of a scroll key
+// @ param action - ACTION_SCROLL_LEFT or ACTION_SCROLL_RIGHT
+// @ return void
+static void calc_scroll_key(int action) {
+    calc_scroll(action == ACTION_SCROLL_LEFT ? -CALC_SCROLL_STEP : CALC_SCROLL_STEP);
+}
+
+// Shows integers in the next base, converting a displayed result in place
+// typed text cannot change base, so the key is ignored once anything but a result is on the top row
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_next_base(int action) {
+
+    if (!calcResultDisplayed && calcTextLength != 0) {
+        return;
+    }
+
+    calc_step_base();
+
+    // the result keeps its binary value, so only the cells whose digits differ are rewritten
+    expr_value_t value;
+    if (calcResultDisplayed && expr_get_last_value(&calcExpr, &value) == EXPR_OK) {
+        calcTextLength = calc_format(value, calcText);
+    }
+
+    calc_tag_draw();
+    calc_view_update(0);
+}
+
+// Selects the next base, decimal then hexadecimal, octal, and binary
+// @ param void
+// @ return void
+static void calc_step_base(void) {
+
+    calcBase = (calcBase == 10) ? 16 : (calcBase == 16) ? 8 : (calcBase == 8) ? 2 : 10;
+
+    keymap_set_func_layer(calcBase != 10 ? KEYMAP_LAYER_BITS : KEYMAP_LAYER_FUNC);
+}
+
+// Adds a digit to the operand being typed
+// @ param action - the digit's action, ACTION_DIGIT_0 to ACTION_DIGIT_F
+// @ return void
+static void calc_digit(int action) {
+
+    int digit = action - ACTION_DIGIT_0;
+
+    // do not accept new number inputs if the result is being displayed or an operator is due
+    if (calcResultDisplayed || !expr_expects_value(&calcExpr)) {
+        return;
+    }
+
+    int start = calcTextLength;
+    int zero = calc_operand_is_zero();
+
+    // a lone zero takes no more zeros, and any other digit replaces it
+    if ((zero && digit == 0) || !calc_operand_digit(digit)) {
+        return;
+    }
+
+    if (zero) {
+        calcOperandLength = 1;
+        calcText[calcTextLength - 1] = fmt_digit(digit);
+        calc_redraw();
+        return;
+    }
+
+    if (calcOperandLength == 1) {
+        calcValueStart = start;
+    }
+
+    calc_append(fmt_digit(digit));
+}
+
+// Ends the operand being typed and adds an operator
+// @ param action - the operator's action, ACTION_ADD to ACTION_SHIFT_RIGHT
+// @ return void
+static void calc_operator(int action) {
+
+    char operator = calcOperators[action - ACTION_ADD];
+
+    if (calc_push_operand() != EXPR_OK) {
+        return;
+    }
+
+    int status = expr_push_operator(&calcExpr, operator);
+
+    if (status == EXPR_ERROR_ARITH) {
+        calc_error();
+        return;
+    } else if (status != EXPR_OK) {
+        return;
+    }
+
+    calc_chain();
+    calc_append(operator);
+}
+
+// Opens a parenthesis
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_open(int action) {
+
+    // a parenthesis cannot follow digits, there is no implied multiply, or start on a result or an error
+    if (calcOperandLength != 0 || calcResultDisplayed) {
+        return;
+    }
+
+    if (expr_open(&calcExpr) == EXPR_OK) {
+        calcOpenStarts[expr_get_open_count(&calcExpr) - 1] = calcTextLength;
+        calc_append('(');
+    }
+}
+
+// Ends the operand being typed and closes a parenthesis
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_close(int action) {
+
+    if (calc_push_operand() != EXPR_OK) {
+        return;
+    }
+
+    int status = expr_close(&calcExpr);
+
+    // the parenthesized group is now the operand the expression ends with
+    if (status == EXPR_OK) {
+        calcValueStart = calcOpenStarts[expr_get_open_count(&calcExpr)];
+        calc_append(')');
+    } else if (status == EXPR_ERROR_ARITH) {
+        calc_error();
+    }
+}
+
+// Adds a decimal point to the float operand being typed
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_point(int action) {
+
+    // a point with no digits before it takes two characters
+    int width = (calcOperandLength == 0) ? 2 : 1;
+
+    // do not accept a point if the result is being displayed, an operator is due, or the text is full
+    if (calcResultDisplayed || !expr_expects_value(&calcExpr) || CALC_TEXT_SIZE - calcTextLength < width ||
+        !calc_operand_point()) {
+        return;
+    }
+
+    // a point with no digits before it gets a leading zero
+    if (calcOperandLength == 0) {
+        calcValueStart = calcTextLength;
+        calcOperandLength++;
+        calc_append('0');
+    }
+
+    calc_append('.');
+}
+
+// Ends the operand being typed and displays the result of the expression
+// equals on a displayed result applies the last operator and operand to it again, so a constant
+// growth or scaling takes one key per step
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_equals(int action) {
+
+    expr_value_t result;
+
+    // the repeat works on the binary result, never on its text
+    if (calcResultDisplayed) {
+        if (calcRepeatOperator != 0 && expr_get_last_value(&calcExpr, &result) == EXPR_OK) {
+            expr_value_t left = result;
+            if (expr_apply(calc_arith_type(), calcRepeatOperator, left, calcRepeatOperand, &result) != EXPR_OK) {
+                calc_error();
+            } else {
+                calc_result(left, result);
+            }
+        }
+        return;
+    }
+
+    if (calc_push_operand() != EXPR_OK) {
+        return;
+    }
+
+    int status = expr_finish(&calcExpr, &result);
+
+    if (status == EXPR_ERROR_ARITH) {
+        calc_error();
+        return;
+    } else if (status != EXPR_OK) {
+        return;
+    }
+
+    // an expression with no operator, such as a lone operand, has nothing to repeat
+    expr_value_t left = result;
+
+    if (expr_get_last_operation(&calcExpr, &left, &calcRepeatOperator, &calcRepeatOperand) != EXPR_OK) {
+        calcRepeatOperator = 0;
+    }
+
+    calc_result(left, result);
+}
+
+// Displays a result and carries it forward as the first operand of a chained calculation
+// the history keeps it with the last operation that gave it, the one equals would repeat
+// @ param left - the left operand of that operation
+// @ param result - the result
+// @ return void
+static void calc_result(expr_value_t left, expr_value_t result) {
+
+    history_add(calc_arith_type(), calcRepeatOperator, left, calcRepeatOperand, result);
+
+    // convert the result once for both the display and the chained expression text
+    calcTextLength = calc_format(result, calcText);
+    calcValueStart = 0;
+
+    calc_show_result();
+
+    if (calcTextLength == 2 && calcText[0] == '6' && calcText[1] == '9') {
+        calc_easter_egg();
+    }
+
+    expr_init(&calcExpr, calc_arith_type());
+    expr_push_value(&calcExpr, result);
+}
+
+// Shows an error in place of a result, only clearing or recalling a value leaves it
+// @ param void
+// @ return void
+static void calc_error(void) {
+
+    for (calcTextLength = 0; calcErrorText[calcTextLength] != '\0'; calcTextLength++) {
+        calcText[calcTextLength] = calcErrorText[calcTextLength];
+    }
+
+    calcValueStart = 0;
+    calc_show_result();
+
+    // with an empty expression and a result displayed, no operator, digit, or repeat is accepted
+    expr_init(&calcExpr, calc_arith_type());
+    calc_operand_reset();
+    calcRepeatOperator = 0;
+
+    // and with no accumulator, the same holds in bignum mode
+    calcBigHasAccumulator = 0;
+    calcBigOperator = 0;
+    calcBigRepeatOperator = 0;
+}
+
+// Applies a scientific function to the operand the expression ends with
+// the operand's text is replaced by the function's result, which the expression goes on with
+// @ param action - the function's action, ACTION_SQRT to ACTION_NOT
+// @ return void
+static void calc_function(int action) {
+
+    int function = action - ACTION_SQRT;
+
+    // the result has to fit where the operand's text begins
+    if (calcValueStart + CALC_VALUE_SIZE > CALC_TEXT_SIZE) {
+        return;
+    }
+
+    if (calc_push_operand() != EXPR_OK) {
+        return;
+    }
+
+    expr_value_t value;
+    int status = expr_apply_function(&calcExpr, function, &value);
+
+    if (status == EXPR_ERROR_ARITH) {
+        calc_error();
+        return;
+    } else if (status != EXPR_OK) {
+        return;
+    }
+
+    calcTextLength = calcValueStart + calc_format(value, calcText + calcValueStart);
+
+    if (calcResultDisplayed) {
+        calc_show_result();
+    } else {
+        calc_redraw();
+    }
+}
+
+// Replaces the operand being typed with the next older or newer result from the history
+// a displayed result is replaced too, starting a new expression with the recalled result
+// @ param action - ACTION_HISTORY_UP for an older result or ACTION_HISTORY_DOWN for a newer one
+// @ return void
+static void calc_recall(int action) {
+
+    expr_value_t value;
+    int index = calc_recall_find(action, &value);
+
+    if (index >= 0) {
+        calc_place_operand(index, value);
+    }
+}
+
+// Finds the next result a recall key steps to that was calculated in the current mode
+// @ param action - ACTION_HISTORY_UP to step to older results or ACTION_HISTORY_DOWN for newer ones
+// @ param value - where to store the result
+// @ return the result's history index, or -1 if there is none in that direction
+static int calc_recall_find(int action, expr_value_t * value) {
+
+    int step = (action == ACTION_HISTORY_UP) ? 1 : -1;
+    int type = calc_arith_type();
+    int count = history_get_count();
+
+    for (int index = calcRecallIndex + step; index >= 0 && index < count; index += step) {
+
+        int entryType;
+        history_get(index, &entryType, value);
+
+        if (entryType == type) {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+// Replaces the operand being typed, or a displayed result, with a recalled value
+// @ param index - the value's history index, or -1 if it is not from the history
+// @ param value - the value
+// @ return void
+static void calc_place_operand(int index, expr_value_t value) {
+
+    // a recalled value can only go where an operand can
+    if (!calcResultDisplayed && !expr_expects_value(&calcExpr)) {
+        return;
+    }
+
+    // the value's text starts where the text of the operand it replaces does
+    int start = calcResultDisplayed ? 0 : (calcOperandLength != 0 ? calcValueStart : calcTextLength);
+
+    if (start + CALC_VALUE_SIZE > CALC_TEXT_SIZE) {
+        return;
+    }
+
+    if (calcResultDisplayed) {
+        expr_init(&calcExpr, calc_arith_type());
+        calcResultDisplayed = 0;
+    }
+
+    calc_operand_reset();
+    calc_operand_recall(index, value);
+
+    calcValueStart = start;
+    calcTextLength = start + calc_format(value, calcText + start);
+
+    if (index >= 0) {
+        calc_recall_draw();
+    } else {
+        calc_redraw();
+    }
+}
+
+// Writes the recalled operand as the calculation that gave it, or as its value alone if no operation did
+// @ param buffer - where to write the text, at least CALC_ENTRY_SIZE characters
+// @ return the number of characters written
+static int calc_recall_format(char * buffer) {
+
+    char operator;
+    expr_value_t left;
+    expr_value_t right;
+    int length = 0;
+
+    if (history_get_operation(calcRecallIndex, &operator, &left, &right) == HISTORY_OK && operator != 0) {
+
+        char operand[CALC_VALUE_SIZE];
+        int operandLength = calc_format(right, operand);
+
+        // a negative right operand would read as two operators
+        int negative = (operand[0] == '-');
+
+        length = calc_format(left, buffer);
+        buffer[length++] = operator;
+
+        if (negative) {
+            buffer[length++] = '(';
+        }
+
+        for (int i = 0; i < operandLength; i++) {
+            buffer[length++] = operand[i];
+        }
+
+        if (negative) {
+            buffer[length++] = ')';
+        }
+
+        buffer[length++] = '=';
+    }
+
+    return length + calc_format(calcRecallValue, buffer + length);
+}
+
+// Shows the recalled calculation on the top row in one update, its end if it is wider than the LCD
+// the text keeps only the operand, so the next key puts the text back before it acts
+// @ param void
+// @ return void
+static void calc_recall_draw(void) {
+
+    char entry[CALC_ENTRY_SIZE];
+    char row[CALC_LCD_COLUMNS];
+    int length = calc_recall_format(entry);
+    int offset = (length > CALC_LCD_COLUMNS) ? length - CALC_LCD_COLUMNS : 0;
+
+    for (int i = 0; i < CALC_LCD_COLUMNS; i++) {
+        row[i] = (offset + i < length) ? entry[offset + i] : ' ';
+    }
+
+    lcd_update(0, 0, row, CALC_LCD_COLUMNS);
+    lcd_cursor_set(length - offset, 0);
+    calcRecallShown = 1;
+}
+
+// Adds the operand being typed, or the one the expression ends with, to or subtracts it from the
+// selected memory register, so a displayed result can be accumulated right after equals
+// @ param action - ACTION_MEMORY_ADD or ACTION_MEMORY_SUBTRACT
+// @ return void
+static void calc_memory_update(int action) {
+
+    expr_value_t value;
+
+    if (calcOperandLength != 0) {
+        value = calc_operand_value();
+    } else if (expr_get_last_value(&calcExpr, &value) != EXPR_OK) {
+        return;
+    }
+
+    calc_memory_apply(action, value);
+    calc_memory_draw();
+}
+
+// Replaces the operand being typed, or a displayed result, with the value of the selected memory register
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_memory_recall(int action) {
+
+    expr_value_t value;
+
+    if (memory_recall(calcMemorySlot, calc_arith_type(), &value) == MEMORY_OK) {
+        calc_place_operand(-1, value);
+    }
+}
+
+// Empties the selected memory register
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_memory_clear(int action) {
+    memory_clear(calcMemorySlot);
+    calcMemoryError = 0;
+    calc_memory_draw();
+}
+
+// Selects the next memory register
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_memory_slot(int action) {
+    calcMemorySlot = (calcMemorySlot + 1) % MEMORY_SLOTS;
+    calcMemoryError = 0;
+    calc_memory_draw();
+}
+
+// Adds a value to or subtracts it from the selected memory register
+// a result the register's type cannot hold, or a register that holds a value of another mode, leaves the
+// register as it was and flags the error
+// @ param action - ACTION_MEMORY_ADD or ACTION_MEMORY_SUBTRACT
+// @ param value - the value in the arithmetic type of the current mode
+// @ return void
+static void calc_memory_apply(int action, expr_value_t value) {
+
+    char operator = (action == ACTION_MEMORY_ADD) ? '+' : '-';
+
+    calcMemoryError = (memory_update(calcMemorySlot, calc_arith_type(), operator, value) != MEMORY_OK);
+}
+
+// Writes the two cells of the memory indicator, an M while the selected register holds a value of the
+// current mode or an E after an update failed, followed by the register's number unless it is the first
+// and holds nothing, so the default register leaves the corner blank until it is used
+// @ param cells - where to write the cells
+// @ return void
+static void calc_memory_indicator(char * cells) {
+
+    expr_value_t value;
+
+    cells[0] = ' ';
+    cells[1] = ' ';
+
+    if (calcState == CALC_STATE_BIG) {
+        return;
+    }
+
+    if (calcMemoryError) {
+        cells[0] = 'E';
+    } else if (memory_recall(calcMemorySlot, calc_arith_type(), &value) == MEMORY_OK) {
+        cells[0] = 'M';
+    }
+
+    if (cells[0] != ' ' || calcMemorySlot != 0) {
+        cells[1] = '1' + calcMemorySlot;
+    }
+}
+
+// Draws the memory indicator at the end of the bottom row without moving the cursor
+// @ param void
+// @ return void
+static void calc_memory_draw(void) {
+
+    char cells[2];
+    calc_memory_indicator(cells);
+
+    lcd_update_cell(CALC_MEMORY_COLUMN, 1, cells[0]);
+    lcd_update_cell(CALC_MEMORY_COLUMN + 1, 1, cells[1]);
+}
+
+// Hands the operand being typed, if any, to the expression
+// @ param void
+// @ return EXPR_OK, or the expression status if it refused the operand
+static int calc_push_operand(void) {
+
+    if (calcOperandLength == 0) {
+        return EXPR_OK;
+    }
+
+    int status = expr_push_value(&calcExpr, calc_operand_value());
+
+    if (status == EXPR_OK) {
+        calc_operand_reset();
+    }
+
+    return status;
+}
+
+// Adds a digit to the value of the operand being typed if the operand can hold it
+// @ param digit - the digit, 0-9
+// @ return 1 if the digit was added, otherwise 0
+static int calc_operand_digit(int digit) {
+
+    // a recalled operand is complete
+    if (calcRecalled || digit >= calc_radix()) {
+        return 0;
+    }
+
+    if (calc_radix() != 10) {
+
+        // do not accept new number inputs past the bits of the word, which is typed unsigned
+        uint64_t word = (calc_arith_type() == ARITH_TYPE_INT32) ? UINT32_MAX : UINT64_MAX;
+        if ((uint64_t) calcOperand > (word - digit) / calc_radix()) {
+            return 0;
+        }
+
+        calcOperand = (int64_t) ((uint64_t) calcOperand * calc_radix() + digit);
+        calcOperandLength++;
+
+        return 1;
+
+    } else if (calcMode == CALC_MODE_FLOAT) {
+
+        // do not accept new number inputs past the digits a float can hold
+        if (calcOperand > (CALC_FLOAT_DIGITS_MAX - digit) / 10 || calcOperandFraction == CALC_FLOAT_FRACTION_MAX) {
+            return 0;
+        }
+
+        if (calcOperandPoint) {
+            calcOperandFraction++;
+        }
+
+    } else if (calcMode == CALC_MODE_DECIMAL) {
+
+        // do not accept new number inputs past the decimal places or if the scaled operand would overflow
+        int64_t scaled;
+        if (calcOperand > (INT64_MAX - digit) / 10 ||
+            decimal_from_digits(calcOperand * 10 + digit, calcOperandFraction + calcOperandPoint, &scaled) != DECIMAL_OK) {
+            return 0;
+        }
+
+        if (calcOperandPoint) {
+            calcOperandFraction++;
+        }
+
+    } else {
+
+        // do not accept new number inputs if the operand would overflow the word size
+        if (calcOperand > (arith_int_max(calc_arith_type()) - digit) / 10) {
+            return 0;
+        }
+    }
+
+    calcOperand = calcOperand * 10 + digit;
+    calcOperandLength++;
+
+    return 1;
+}
+
+// Marks the operand being typed as having a decimal point if it can hold one
+// @ param void
+// @ return 1 if the point was added, otherwise 0
+static int calc_operand_point(void) {
+
+    // a recalled operand is complete, and decimals with no places have nowhere to put a fraction
+    if (calcRecalled || calcOperandPoint || (calcMode == CALC_MODE_DECIMAL && decimal_get_places() == 0)) {
+        return 0;
+    }
+
+    calcOperandPoint = 1;
+
+    return 1;
+}
+
+// Checks whether the operand being typed is a lone zero, which a leading zero would only repeat
+// @ param void
+// @ return 1 if the operand is a single zero digit with no point, otherwise 0
+static int calc_operand_is_zero(void) {
+    return calcOperandLength == 1 && calcOperand == 0 && !calcOperandPoint && !calcRecalled;
+}
+
+// Gets the value of the operand being typed
+// floats and decimals are typed as digits and a count of them after the point, scaled once here
+// @ param void
+// @ return the operand in the arithmetic type of the current mode
+static expr_value_t calc_operand_value(void) {
+
+    if (calcRecalled) {
+        return calcRecallValue;
+    }
+
+    expr_value_t value;
+
+    if (calcMode == CALC_MODE_FLOAT) {
+        value.f = (float) calcOperand / calcPowersOfTen[calcOperandFraction];
+    } else if (calcMode == CALC_MODE_DECIMAL) {
+        decimal_from_digits(calcOperand, calcOperandFraction, &value.i);
+    } else if (calc_arith_type() == ARITH_TYPE_INT32) {
+        // a word typed in another base with its top bit set is negative
+        value.i = (int32_t) (uint32_t) calcOperand;
+    } else {
+        value.i = calcOperand;
+    }
+
+    return value;
+}
+
+// Forgets the operand being typed
+// @ param void
+// @ return void
+static void calc_operand_reset(void) {
+    calcOperand = 0;
+    calcOperandLength = 0;
+    calcOperandFraction = 0;
+    calcOperandPoint = 0;
+    calcRecalled = 0;
+    calcRecallIndex = -1;
+}
+
+// Makes a recalled value the operand being typed
+// @ param index - the value's history index, or -1 if it is not from the history
+// @ param value - the value
+// @ return void
+static void calc_operand_recall(int index, expr_value_t value) {
+    calcRecalled = 1;
+    calcRecallIndex = index;
+    calcRecallValue = value;
+    calcOperandLength = 1;
+}
+
+// Writes an expression value to a buffer in the notation of the current mode
+// @ param value - the value
+// @ param buffer - where to write the value, at least CALC_VALUE_SIZE characters
+// @ return the number of characters written
+static int calc_format(expr_value_t value, char * buffer) {
+
+    if (calcMode == CALC_MODE_FLOAT) {
+        return fmt_float(value.f, buffer, calcFloatPrecision);
+    } else if (calcMode == CALC_MODE_DECIMAL) {
+        return decimal_to_string(value.i, buffer);
+    } else if (calc_radix() != 10) {
+        return fmt_radix(value.i, buffer, calc_radix(), calc_arith_type() == ARITH_TYPE_INT32 ? 32 : 64);
+    } else {
+        return fmt_int64(value.i, buffer);
+    }
+}
+
+// Adds a digit to the bignum operand being typed
+// @ param action - the digit's action, ACTION_DIGIT_0 to ACTION_DIGIT_9
+// @ return void
+static void calc_big_digit(int action) {
+
+    int digit = action - ACTION_DIGIT_0;
+
+    // do not accept new number inputs if the result is being displayed or the operand is full
+    if (calcResultDisplayed || calcOperandLength == BIGNUM_MAX_DIGITS) {
+        return;
+    }
+
+    // an accumulator with no operator pending needs an operator first
+    if (calcBigHasAccumulator && calcBigOperator == 0) {
+        return;
+    }
+
+    if (calcOperandLength == 0) {
+        bignum_set_int(&calcBigOperand, 0);
+    }
+
+    // a lone zero takes no more zeros, and any other digit replaces it
+    if (calcOperandLength == 1 && calcText[calcTextLength - 1] == '0') {
+        if (digit != 0) {
+            bignum_set_int(&calcBigOperand, digit);
+            calcText[calcTextLength - 1] = '0' + digit;
+            calc_redraw();
+        }
+        return;
+    }
+
+    bignum_mul_add_small(&calcBigOperand, 10, digit);
+    calcOperandLength++;
+
+    calc_append('0' + digit);
+}
+
+// Applies the pending operator, if any, and makes another one pending
+// @ param action - the operator's action, ACTION_ADD to ACTION_MODULO
+// @ return void
+static void calc_big_operator(int action) {
+
+    char operator = calcOperators[action - ACTION_ADD];
+
+    // an operator needs a left operand, either typed or carried from a result
+    if (calcOperandLength == 0 && (!calcBigHasAccumulator || calcBigOperator != 0)) {
+        return;
+    }
+
+    if (calc_big_apply() != BIGNUM_OK) {
+        calc_error();
+        return;
+    }
+
+    calcBigOperator = operator;
+
+    calc_chain();
+    calc_append(operator);
+}
+
+// Applies the pending operator and displays the result
+// equals on a displayed result applies the last operator and operand to it again
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_big_equals(int action) {
+
+    // the last operand is still held, so a repeat only has to make its operator pending again
+    if (calcOperandLength == 0) {
+
+        if (!calcResultDisplayed || calcBigRepeatOperator == 0) {
+            return;
+        }
+
+        calcBigOperator = calcBigRepeatOperator;
+        calcOperandLength = 1;
+    }
+
+    calcBigRepeatOperator = calcBigOperator;
+
+    if (calc_big_apply() != BIGNUM_OK) {
+        calc_error();
+        return;
+    }
+
+    calcTextLength = bignum_to_string(&calcBigAccumulator, calcText);
+    calc_show_result();
+}
+
+// Folds the operand being typed into the accumulator with the pending operator
+// @ param void
+// @ return BIGNUM_OK, or the bignum status if the operation failed
+static int calc_big_apply(void) {
+
+    if (calcOperandLength == 0) {
+        return BIGNUM_OK;
+    }
+
+    int status = BIGNUM_OK;
+    bignum_t * acc = &calcBigAccumulator;
+    const bignum_t * operand = &calcBigOperand;
+
+    switch (calcBigOperator) {
+
+        case '+':
+            status = bignum_add(acc, acc, operand);
+            break;
+
+        case '-':
+            status = bignum_sub(acc, acc, operand);
+            break;
+
+        case '*':
+            status = bignum_mul(acc, acc, operand);
+            break;
+
+        case '/':
+            status = bignum_div(acc, acc, operand);
+            break;
+
+        case '%':
+            status = bignum_mod(acc, acc, operand);
+            break;
+
+        // no operator pending, the operand becomes the accumulator
+        default:
+            * acc = * operand;
+            break;
+    }
+
+    calcBigOperator = 0;
+    calcBigHasAccumulator = 1;
+    calcOperandLength = 0;
+
+    return status;
+}
+
+// Adds a digit to the entry
+// @ param action - the digit's action, ACTION_DIGIT_0 to ACTION_DIGIT_F
+// @ return void
+static void calc_rpn_digit(int action) {
+
+    int digit = action - ACTION_DIGIT_0;
+    int zero = calc_operand_is_zero();
+
+    // a lone zero takes no more zeros, and any other digit replaces it
+    if ((zero && digit == 0) || !calc_operand_digit(digit)) {
+        return;
+    }
+
+    if (zero) {
+        calcOperandLength = 1;
+        calcTextLength--;
+    }
+
+    calcText[calcTextLength++] = fmt_digit(digit);
+    calc_rpn_draw();
+}
+
+// Adds a decimal point to the entry
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_point(int action) {
+
+    // a point with no digits before it takes two characters
+    int width = (calcOperandLength == 0) ? 2 : 1;
+
+    if (CALC_TEXT_SIZE - calcTextLength < width || !calc_operand_point()) {
+        return;
+    }
+
+    // a point with no digits before it gets a leading zero
+    if (calcOperandLength == 0) {
+        calcOperandLength++;
+        calcText[calcTextLength++] = '0';
+    }
+
+    calcText[calcTextLength++] = '.';
+    calc_rpn_draw();
+}
+
+// Discards the entry, or empties the stack if nothing is being typed
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_clear(int action) {
+
+    if (calcOperandLength != 0) {
+        calc_operand_reset();
+        calcTextLength = 0;
+    } else {
+        rpn_init(&calcStack, calc_arith_type(), calcRpnDepth);
+    }
+
+    calc_rpn_draw();
+}
+
+// Pushes the entry onto the stack, or duplicates the top value if nothing is being typed
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_enter(int action) {
+
+    expr_value_t x;
+
+    if (calcOperandLength != 0) {
+        calc_rpn_push_entry();
+    } else if (rpn_peek(&calcStack, 0, &x) == RPN_OK) {
+        rpn_push(&calcStack, x);
+    }
+
+    calc_rpn_draw();
+}
+
+// Pushes the entry, if any, and applies an operator to the top two values
+// an operation with no result leaves the stack as it was and shows an error until the next key
+// @ param action - the operator's action, ACTION_ADD to ACTION_SHIFT_RIGHT
+// @ return void
+static void calc_rpn_operator(int action) {
+
+    calc_rpn_push_entry();
+
+    char operator = calcOperators[action - ACTION_ADD];
+    expr_value_t left;
+    expr_value_t right;
+
+    rpn_peek(&calcStack, 1, &left);
+    rpn_peek(&calcStack, 0, &right);
+
+    int status = rpn_operator(&calcStack, operator);
+
+    if (status == RPN_OK) {
+        calc_rpn_record(operator, left, right);
+    } else if (status == RPN_ERROR_ARITH) {
+        calcRpnError = 1;
+    }
+
+    calc_rpn_draw();
+}
+
+// Pushes the entry, if any, and applies a unary function to the top value
+// a function with no result leaves the stack as it was and shows an error until the next key
+// @ param action - the function's action, ACTION_SQRT to ACTION_NOT
+// @ return void
+static void calc_rpn_function(int action) {
+
+    calc_rpn_push_entry();
+
+    int status = rpn_function(&calcStack, action - ACTION_SQRT);
+    expr_value_t none = { .i = 0 };
+
+    if (status == RPN_OK) {
+        calc_rpn_record(0, none, none);
+    } else if (status == RPN_ERROR_ARITH) {
+        calcRpnError = 1;
+    }
+
+    calc_rpn_draw();
+}
+
+// Pushes the entry, if any, and exchanges the top two values
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_swap(int action) {
+    calc_rpn_push_entry();
+    rpn_swap(&calcStack);
+    calc_rpn_draw();
+}
+
+// Pushes the entry, if any, and removes the top value
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_drop(int action) {
+    calc_rpn_push_entry();
+    rpn_drop(&calcStack);
+    calc_rpn_draw();
+}
+
+// Pushes the entry, if any, and rotates the stack down
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_roll(int action) {
+    calc_rpn_push_entry();
+    rpn_roll(&calcStack);
+    calc_rpn_draw();
+}
+
+// Replaces the entry with the next older or newer result from the history
+// @ param action - ACTION_HISTORY_UP for an older result or ACTION_HISTORY_DOWN for a newer one
+// @ return void
+static void calc_rpn_recall(int action) {
+
+    expr_value_t value;
+    int index = calc_recall_find(action, &value);
+
+    if (index >= 0) {
+        calc_rpn_place_entry(index, value);
+    }
+}
+
+// Shows the stack in the next base, redrawing only the digits that change
+// a typed entry cannot change base, so the key is ignored while one is being typed
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_next_base(int action) {
+
+    if (calcOperandLength != 0 && !calcRecalled) {
+        return;
+    }
+
+    calc_step_base();
+
+    if (calcRecalled) {
+        calcTextLength = calc_recall_format(calcText);
+    }
+
+    calc_rpn_draw();
+}
+
+// Pushes the entry, if any, and adds the top value to or subtracts it from the selected memory register
+// @ param action - ACTION_MEMORY_ADD or ACTION_MEMORY_SUBTRACT
+// @ return void
+static void calc_rpn_memory_update(int action) {
+
+    expr_value_t x;
+
+    calc_rpn_push_entry();
+
+    if (rpn_peek(&calcStack, 0, &x) == RPN_OK) {
+        calc_memory_apply(action, x);
+    }
+
+    calc_rpn_draw();
+}
+
+// Replaces the entry with the value of the selected memory register
+// @ param action - the action that triggered it, unused
+// @ return void
+static void calc_rpn_memory_recall(int action) {
+
+    expr_value_t value;
+
+    if (memory_recall(calcMemorySlot, calc_arith_type(), &value) == MEMORY_OK) {
+        calc_rpn_place_entry(-1, value);
+    }
+}
+
+// Replaces the entry with a recalled value
+// a recalled entry cannot be edited, so its text shows the calculation that gave it
+// @ param index - the value's history index, or -1 if it is not from the history
+// @ param value - the value
+// @ return void
+static void calc_rpn_place_entry(int index, expr_value_t value) {
+
+    calc_operand_reset();
+    calc_operand_recall(index, value);
+    calcTextLength = calc_recall_format(calcText);
+
+    calc_rpn_draw();
+}
+
+// Adds the value on top of the stack to the history with the operation that gave it
+// @ param operator - the operator, or 0 for a function, which the history does not keep
+// @ param left - the left operand
+// @ param right - the right operand
+// @ return void
+static void calc_rpn_record(char operator, expr_value_t left, expr_value_t right) {
+
+    expr_value_t x;
+
+    if (rpn_peek(&calcStack, 0, &x) == RPN_OK) {
+        history_add(calc_arith_type(), operator, left, right, x);
+    }
+}
+
+// Pushes the operand being typed, if any, onto the stack
+// @ param void
+// @ return void
+static void calc_rpn_push_entry(void) {
+
+    if (calcOperandLength == 0) {
+        return;
+    }
+
+    rpn_push(&calcStack, calc_operand_value());
+    calc_operand_reset();
+    calcTextLength = 0;
+}
+
+// Draws the stack view, the entry and the top value while typing, otherwise the top two values, with
+// the memory indicator at the end of the bottom row
+// only the cells that changed are written, so a keypress costs a few characters rather than two rows
+// @ param void
+// @ return void
+static void calc_rpn_draw(void) {
+
+    char row[CALC_LCD_COLUMNS];
+
+    // the cursor blinks after the entry, or waits past the end of the bottom row where it is not seen
+    int cursor = CALC_LCD_COLUMNS;
+
+    if (calcOperandLength != 0) {
+
+        calc_rpn_level_row(0, row);
+        lcd_update(0, 0, row, CALC_LCD_COLUMNS);
+
+        for (int i = 0; i < CALC_LCD_COLUMNS; i++) {
+            row[i] = ' ';
+        }
+
+        // an entry too wide for the row shows its end after a marker
+        const char * text = calcText;
+        int length = calcTextLength;
+        cursor = 0;
+
+        if (length > CALC_RPN_ENTRY_COLUMNS) {
+            row[cursor++] = '<';
+            text += length - (CALC_RPN_ENTRY_COLUMNS - 1);
+            length = CALC_RPN_ENTRY_COLUMNS - 1;
+        }
+
+        for (int i = 0; i < length; i++) {
+            row[cursor++] = text[i];
+        }
+
+    } else {
+
+        calc_rpn_level_row(1, row);
+        lcd_update(0, 0, row, CALC_LCD_COLUMNS);
+        calc_rpn_level_row(0, row);
+
+        // an error covers the top value until the next key draws the stack again
+        if (calcRpnError) {
+            for (int i = 2; i < CALC_RPN_VALUE_COLUMNS; i++) {
+                row[i] = ' ';
+            }
+            for (int i = 0; calcErrorText[i] != '\0'; i++) {
+                row[CALC_RPN_VALUE_COLUMNS - (int) sizeof(calcErrorText) + 1 + i] = calcErrorText[i];
+            }
+            calcRpnError = 0;
+        }
+    }
+
+    calc_memory_indicator(row + CALC_MEMORY_COLUMN);
+    lcd_update(0, 1, row, CALC_LCD_COLUMNS);
+    lcd_cursor_set(cursor, 1);
+}
+
+// Writes a row showing a stack level, its label on the left and its value on the right, short of the
+// memory indicator, a value too wide for its columns shows its end after a marker
+// @ param level - the level, 0 is the top
+// @ param row - where to write the row, CALC_LCD_COLUMNS characters
+// @ return void
+static void calc_rpn_level_row(int level, char * row) {
+
+    for (int i = 0; i < CALC_LCD_COLUMNS; i++) {
+        row[i] = ' ';
+    }
+
+    row[0] = '1' + level;
+    row[1] = ':';
+
+    expr_value_t value;
+    if (rpn_peek(&calcStack, level, &value) != RPN_OK) {
+        return;
+    }
+
+    char buffer[CALC_VALUE_SIZE];
+    int length = calc_format(value, buffer);
+
+    // a value wider than the columns after the label gives up the whole label, never just its colon
+    if (length > CALC_RPN_VALUE_COLUMNS - 2) {
+        row[0] = '<';
+        for (int i = 1; i < CALC_RPN_VALUE_COLUMNS; i++) {
+            row[i] = buffer[length - CALC_RPN_VALUE_COLUMNS + i];
+        }
+    } else {
+        for (int i = 0; i < length; i++) {
+            row[CALC_RPN_VALUE_COLUMNS - length + i] = buffer[i];
+        }
+    }
+}
+
+// Prepares the display to extend a result into a chained calculation
+// @ param void
+// @ return void
+static void calc_chain(void) {
+
+    // redraw the result alone in case anything was printed after it
+    if (calcResultDisplayed) {
+        calc_clear_display();
+        calc_view_draw(calcTextLength > CALC_LCD_COLUMNS ? calcTextLength - CALC_LCD_COLUMNS : 0);
+        calcResultDisplayed = 0;
+    }
+}
+
+// Clears the LCD, tags every mode but the default one and every base but decimal on the bottom row,
+// and draws the memory indicator
+// @ param void
+// @ return void
+static void calc_clear_display(void) {
+
+    lcd_clear();
+
+    if (calcMode != CALC_MODE_INT || calc_radix() != 10) {
+        calc_tag_draw();
+        lcd_cursor_home();
+    }
+
+    calc_memory_draw();
+}
+
+// Draws the mode and base tags at the start of the bottom row, leaving the cursor after them
+// @ param void
+// @ return void
+static void calc_tag_draw(void) {
+
+    char tag[CALC_TAG_COLUMNS];
+    int length = 0;
+
+    for (int i = 0; i < CALC_TAG_COLUMNS; i++) {
+        tag[i] = ' ';
+    }
+
+    for (const char * c = calcModeTags[calcMode]; * c != '\0'; c++) {
+        tag[length++] = * c;
+    }
+
+    if (calc_radix() != 10) {
+        length += (length != 0);
+        for (const char * c = calcBaseTags[calc_radix()]; * c != '\0'; c++) {
+            tag[length++] = * c;
+        }
+    }
+
+    lcd_update(0, 1, tag, CALC_TAG_COLUMNS);
+}
+
+// Replaces the top row with the text, which holds a result, from its first character
+// @ param void
+// @ return void
+static void calc_show_result(void) {
+
+    calc_clear_display();
+    calc_view_draw(0);
+    calcResultDisplayed = 1;
+}
+
+// Appends a character to the text and the top row of the LCD
+// once the text is wider than the LCD the row is redrawn to show its end
+// @ param character - the character to append
+// @ return void
+static void calc_append(char character) {
+
+    calcText[calcTextLength++] = character;
+
+    // while the text fits, the LCD cursor already sits at its end
+    if (calcTextLength <= CALC_LCD_COLUMNS) {
+        lcd_write(&character, 1);
+        calcViewOffset = 0;
+    } else {
+        lcd_cursor_home();
+        calc_view_draw(calcTextLength - CALC_LCD_COLUMNS);
+    }
+}
+
+// Redraws the top row to show the end of the text after it was rewritten rather than appended to
+// @ param void
+// @ return void
+static void calc_redraw(void) {
+    calc_view_update((calcTextLength > CALC_LCD_COLUMNS) ? calcTextLength - CALC_LCD_COLUMNS : 0);
+}
+
+// Redraws the top row to show the window of the text starting at an offset
+// the row is written in one update, so only the characters that changed are sent to the LCD
+// @ param offset - the first character to show
+// @ return void
+static void calc_view_update(int offset) {
+
+    char row[CALC_LCD_COLUMNS];
+    int length = calcTextLength - offset;
+
+    if (length > CALC_LCD_COLUMNS) {
+        length = CALC_LCD_COLUMNS;
+    }
+
+    // blank whatever the old text covered past the new end
+    for (int i = 0; i < CALC_LCD_COLUMNS; i++) {
+        row[i] = (i < length) ? calcText[offset + i] : ' ';
+    }
+
+    lcd_update(0, 0, row, CALC_LCD_COLUMNS);
+    lcd_cursor_set(length, 0);
+    calcViewOffset = offset;
+}
+
+// Scrolls the top row over text that is wider than the LCD
+// @ param step - the number of characters to scroll, negative to scroll left
+// @ return void
+static void calc_scroll(int step) {
+
+    if (calcTextLength <= CALC_LCD_COLUMNS) {
+        return;
+    }
+
+    int offset = calcViewOffset + step;
+    int last = calcTextLength - CALC_LCD_COLUMNS;
+
+    if (offset < 0) offset = 0;
+    if (offset > last) offset = last;
+
+    if (offset != calcViewOffset) {
+        lcd_cursor_home();
+        calc_view_draw(offset);
+    }
+}
+
+// Writes the window of the text starting at an offset to the top row
+// the cursor must be at the start of the top row
+// @ param offset - the first character to show
+// @ return void
+static void calc_view_draw(int offset) {
+
+    int length = calcTextLength - offset;
+
+    if (length > CALC_LCD_COLUMNS) {
+        length = CALC_LCD_COLUMNS;
+    }
+
+    lcd_write(calcText + offset, length);
+    calcViewOffset = offset;
+}
+
+// Prints a short message after a result of 69
+// @ param void
+// @ return void
+static void calc_easter_egg(void) {
+
+    lcd_cursor_hide();
+    delay_ms(1000);
+    lcd_write(" ", 1);
+
+    for (int i = 0; i < 3; i++) {
+        delay_ms(150);
+        lcd_write(".", 1);
+    }
+
+    delay_ms(800);
+    lcd_write(" nice.", 6);
+
+    delay_ms(1000);
+    lcd_cursor_show();
+}
@@ -0,0 +1,60 @@
+// file: calc.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for calc.c
+
+# ifndef CALC_H
+# define CALC_H
+
+// Calculator Modes
+# define CALC_MODE_INT 0
+# define CALC_MODE_INT64 1
+# define CALC_MODE_FLOAT 2
+# define CALC_MODE_DECIMAL 3
+# define CALC_MODE_BIG 4
+# define CALC_MODES 5
+
+// Float Display
+// the default number of significant digits float results show, 1-9
+# ifndef CALC_FLOAT_PRECISION
+# define CALC_FLOAT_PRECISION 9
+# endif
+
+// Clears the calculator and the LCD
+void calc_init(void);
+
+// Selects the number mode and clears the calculator
+void calc_set_mode(int mode);
+
+// Gets the number mode
+int calc_get_mode(void);
+
+// Sets how many significant digits float results show
+void calc_set_float_precision(int digits);
+
+// Gets how many significant digits float results show
+int calc_get_float_precision(void);
+
+// Selects the base integers are typed and shown in and clears the calculator
+void calc_set_base(int base);
+
+// Gets the base integers are typed and shown in
+int calc_get_base(void);
+
+// Switches reverse polish notation entry on or off and clears the calculator
+void calc_set_rpn(int enabled);
+
+// Checks whether reverse polish notation entry is selected
+int calc_get_rpn(void);
+
+// Sets how many values the reverse polish notation stack holds and clears the calculator
+void calc_set_rpn_depth(int depth);
+
+// Gets how many values the reverse polish notation stack holds
+int calc_get_rpn_depth(void);
+
+// Performs a keymap action on the calculator
+void calc_handle(int action);
+
+# endif
@@ -0,0 +1,324 @@
+// file: decimal.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains exact scaled decimal arithmetic with banker's rounding
+
+# include <stdint.h>
+# include "decimal.h"
+# include "fmt.h"
+
+// Function Prototypes
+static int decimal_mul(int64_t a, int64_t b, int64_t * result);
+static int decimal_div(int64_t a, int64_t b, int64_t * result);
+static uint64_t decimal_mul_full(uint64_t a, uint64_t b, uint64_t * low);
+static uint64_t decimal_div_pow10(uint64_t value, int places);
+static uint64_t decimal_div_wide(uint64_t high, uint64_t low, uint64_t divisor, uint64_t * remainder);
+static int decimal_round(uint64_t quotient, uint64_t remainder, uint64_t divisor, int negative, int64_t * result);
+
+// Powers of Ten
+static const uint64_t decimalPowers[DECIMAL_PLACES_MAX + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// Reciprocals of the Powers of Ten
+// ceil(2^(63 + l) / 10^p) with l = ceil(log2(10^p)), so for any value below 2^63 the high word of
+// value * reciprocal shifted right by l - 1 is exactly value / 10^p, generated offline
+static const uint64_t decimalReciprocals[DECIMAL_PLACES_MAX + 1] = {
+    0,
+    0xCCCCCCCCCCCCCCCD, 0xA3D70A3D70A3D70B, 0x83126E978D4FDF3C,
+    0xD1B71758E219652C, 0xA7C5AC471B478424, 0x8637BD05AF6C69B6,
+    0xD6BF94D5E57A42BD, 0xABCC77118461CEFD, 0x89705F4136B4A598
+};
+
+static const uint8_t decimalReciprocalShifts[DECIMAL_PLACES_MAX + 1] = {
+    0, 3, 6, 9, 13, 16, 19, 23, 26, 29
+};
+
+// Decimal State
+static int decimalPlaces = DECIMAL_PLACES_DEFAULT;
+
+// Sets the number of decimal places every decimal is scaled by
+// decimals made under a different number of places are not converted
+// @ param places - the number of places, 0-9
+// @ return void
+void decimal_set_places(int places) {
+
+    if (places < 0 || places > DECIMAL_PLACES_MAX) {
+        return;
+    }
+
+    decimalPlaces = places;
+}
+
+// Gets the number of decimal places every decimal is scaled by
+// @ param void
+// @ return the number of places
+int decimal_get_places(void) {
+    return decimalPlaces;
+}
+
+// Builds a decimal from typed digits and how many of them follow the point
+// @ param digits - the digits as an integer, not negative
+// @ param fraction - how many of the digits follow the point, at most the number of places
+// @ param result - where to store the decimal
+// @ return DECIMAL_OK, or DECIMAL_ERROR_OVERFLOW if it does not fit or has too many places
+int decimal_from_digits(int64_t digits, int fraction, int64_t * result) {
+
+    if (fraction > decimalPlaces) {
+        return DECIMAL_ERROR_OVERFLOW;
+    }
+
+    if (__builtin_mul_overflow(digits, (int64_t) decimalPowers[decimalPlaces - fraction], result)) {
+        return DECIMAL_ERROR_OVERFLOW;
+    }
+
+    return DECIMAL_OK;
+}
+
+// Applies a binary operator to two decimals
+// add, subtract, and modulo are exact on the mantissas, multiply and divide round half to even
+// @ param operator - '+', '-', '*', '/', or '%'
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the result, untouched on error
+// @ return DECIMAL_OK, DECIMAL_ERROR_OVERFLOW, or DECIMAL_ERROR_DIVIDE
+int decimal_apply(char operator, int64_t a, int64_t b, int64_t * result) {
+
+    // the overflow builtins store the wrapped value, so they store it here rather than in the result
+    int64_t sum;
+
+    switch (operator) {
+
+        case '+':
+            if (__builtin_add_overflow(a, b, &sum)) {
+                return DECIMAL_ERROR_OVERFLOW;
+            }
+            * result = sum;
+            return DECIMAL_OK;
+
+        case '-':
+            if (__builtin_sub_overflow(a, b, &sum)) {
+                return DECIMAL_ERROR_OVERFLOW;
+            }
+            * result = sum;
+            return DECIMAL_OK;
+
+        case '*':
+            return decimal_mul(a, b, result);
+
+        case '/':
+            return decimal_div(a, b, result);
+
+        // both mantissas share a scale, so their remainder is the remainder of the decimals
+        case '%':
+            if (b == 0) {
+                return DECIMAL_ERROR_DIVIDE;
+            }
+            * result = (a == INT64_MIN && b == -1) ? 0 : a % b;
+            return DECIMAL_OK;
+
+        default:
+            return DECIMAL_ERROR_OVERFLOW;
+    }
+}
+
+// Writes a decimal to a buffer with every decimal place shown
+// @ param value - the decimal
+// @ param buffer - the buffer to write to, at least DECIMAL_STRING_SIZE characters
+// @ return the number of characters written, not counting the null terminator
+int decimal_to_string(int64_t value, char * buffer) {
+
+    int length = 0;
+    uint64_t magnitude = value < 0 ? 0u - (uint64_t) value : (uint64_t) value;
+
+    if (value < 0) {
+        buffer[length++] = '-';
+    }
+
+    // the whole part and the places split with one reciprocal multiply
+    uint64_t whole = decimal_div_pow10(magnitude, decimalPlaces);
+    uint64_t places = magnitude - whole * decimalPowers[decimalPlaces];
+
+    length += fmt_uint64(whole, buffer + length);
+
+    if (decimalPlaces > 0) {
+        buffer[length++] = '.';
+        length += fmt_uint32_padded((uint32_t) places, buffer + length, decimalPlaces);
+    }
+
+    return length;
+}
+
+// Multiplies two decimals and rounds the product back to the scale
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the product
+// @ return DECIMAL_OK, or DECIMAL_ERROR_OVERFLOW
+static int decimal_mul(int64_t a, int64_t b, int64_t * result) {
+
+    int negative = (a < 0) != (b < 0);
+    uint64_t aMagnitude = a < 0 ? 0u - (uint64_t) a : (uint64_t) a;
+    uint64_t bMagnitude = b < 0 ? 0u - (uint64_t) b : (uint64_t) b;
+
+    // the full product is 128 bits, scaled by 10^(2 * places)
+    uint64_t low;
+    uint64_t high = decimal_mul_full(aMagnitude, bMagnitude, &low);
+    uint64_t divisor = decimalPowers[decimalPlaces];
+    uint64_t quotient;
+    uint64_t remainder;
+
+    if (high == 0 && low < ((uint64_t) 1 << 63)) {
+
+        // the common case, drop the extra scale with a reciprocal multiply and no division
+        quotient = decimal_div_pow10(low, decimalPlaces);
+        remainder = low - quotient * divisor;
+
+    } else {
+
+        // a product past 63 bits may still scale back down into range
+        if (high >= divisor) {
+            return DECIMAL_ERROR_OVERFLOW;
+        }
+        quotient = decimal_div_wide(high, low, divisor, &remainder);
+    }
+
+    return decimal_round(quotient, remainder, divisor, negative, result);
+}
+
+// Divides two decimals and rounds the quotient to the scale
+// @ param a - the dividend
+// @ param b - the divisor
+// @ param result - where to store the quotient
+// @ return DECIMAL_OK, DECIMAL_ERROR_OVERFLOW, or DECIMAL_ERROR_DIVIDE
+static int decimal_div(int64_t a, int64_t b, int64_t * result) {
+
+    if (b == 0) {
+        return DECIMAL_ERROR_DIVIDE;
+    }
+
+    int negative = (a < 0) != (b < 0);
+    uint64_t aMagnitude = a < 0 ? 0u - (uint64_t) a : (uint64_t) a;
+    uint64_t bMagnitude = b < 0 ? 0u - (uint64_t) b : (uint64_t) b;
+
+    // scale the dividend up once so the quotient keeps its places
+    uint64_t low;
+    uint64_t high = decimal_mul_full(aMagnitude, decimalPowers[decimalPlaces], &low);
+    uint64_t quotient;
+    uint64_t remainder;
+
+    if (high == 0) {
+
+        // a single hardware-assisted 64-bit division
+        quotient = low / bMagnitude;
+        remainder = low - quotient * bMagnitude;
+
+    } else {
+
+        if (high >= bMagnitude) {
+            return DECIMAL_ERROR_OVERFLOW;
+        }
+        quotient = decimal_div_wide(high, low, bMagnitude, &remainder);
+    }
+
+    return decimal_round(quotient, remainder, bMagnitude, negative, result);
+}
+
+// Multiplies two 64-bit values into a 128-bit product from four 32-bit UMULL partial products
+// @ param a - the first value
+// @ param b - the second value
+// @ param low - where to store the low 64 bits of the product
+// @ return the high 64 bits of the product
+static uint64_t decimal_mul_full(uint64_t a, uint64_t b, uint64_t * low) {
+
+    uint64_t aLow = (uint32_t) a;
+    uint64_t aHigh = a >> 32;
+    uint64_t bLow = (uint32_t) b;
+    uint64_t bHigh = b >> 32;
+
+    uint64_t lowLow = aLow * bLow;
+    uint64_t lowHigh = aLow * bHigh;
+    uint64_t highLow = aHigh * bLow;
+    uint64_t highHigh = aHigh * bHigh;
+
+    uint64_t middle = (lowLow >> 32) + (uint32_t) lowHigh + (uint32_t) highLow;
+
+    * low = (middle << 32) | (uint32_t) lowLow;
+
+    return highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+}
+
+// Divides a value by a power of ten with a reciprocal multiply
+// @ param value - the value
+// @ param places - the power of ten, 0-9
+// @ return the quotient
+static uint64_t decimal_div_pow10(uint64_t value, int places) {
+
+    if (places == 0) {
+        return value;
+    }
+
+    // only the magnitude of INT64_MIN reaches 2^63, leave it to a real division
+    if (value >> 63) {
+        return value / decimalPowers[places];
+    }
+
+    uint64_t low;
+    uint64_t high = decimal_mul_full(value, decimalReciprocals[places], &low);
+
+    return high >> decimalReciprocalShifts[places];
+}
+
+// Divides a 128-bit value by a 64-bit divisor one bit at a time, the rare wide path
+// @ param high - the high 64 bits of the dividend, less than the divisor
+// @ param low - the low 64 bits of the dividend
+// @ param divisor - the divisor, not zero
+// @ param remainder - where to store the remainder
+// @ return the quotient, which fits in 64 bits since high is less than the divisor
+static uint64_t decimal_div_wide(uint64_t high, uint64_t low, uint64_t divisor, uint64_t * remainder) {
+
+    uint64_t quotient = 0;
+
+    for (int i = 0; i < 64; i++) {
+
+        // shift the next dividend bit into the partial remainder, which may briefly need 65 bits
+        uint64_t carry = high >> 63;
+        high = (high << 1) | (low >> 63);
+        low <<= 1;
+        quotient <<= 1;
+
+        if (carry || high >= divisor) {
+            high -= divisor;
+            quotient |= 1;
+        }
+    }
+
+    * remainder = high;
+
+    return quotient;
+}
+
+// Rounds a quotient half to even and applies its sign
+// @ param quotient - the truncated magnitude
+// @ param remainder - what the truncation dropped
+// @ param divisor - what the remainder is a fraction of
+// @ param negative - whether the result is negative
+// @ param result - where to store the result
+// @ return DECIMAL_OK, or DECIMAL_ERROR_OVERFLOW if the magnitude does not fit
+static int decimal_round(uint64_t quotient, uint64_t remainder, uint64_t divisor, int negative, int64_t * result) {
+
+    // compare the remainder with half the divisor without overflowing either
+    uint64_t half = divisor - remainder;
+
+    if (remainder > half || (remainder == half && (quotient & 1))) {
+        quotient++;
+    }
+
+    if (quotient > (uint64_t) INT64_MAX + negative) {
+        return DECIMAL_ERROR_OVERFLOW;
+    }
+
+    * result = negative ? (int64_t) (0u - quotient) : (int64_t) quotient;
+
+    return DECIMAL_OK;
+}
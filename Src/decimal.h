@@ -0,0 +1,43 @@
+// file: decimal.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for decimal.c
+
+# ifndef DECIMAL_H
+# define DECIMAL_H
+
+# include <stdint.h>
+
+// Decimal Places
+// a decimal is a 64-bit mantissa scaled by 10^-places, two places suits money
+# define DECIMAL_PLACES_MAX 9
+# ifndef DECIMAL_PLACES_DEFAULT
+# define DECIMAL_PLACES_DEFAULT 2
+# endif
+
+// Decimal Buffer Size
+// large enough for the sign, every digit, the point, and the null terminator
+# define DECIMAL_STRING_SIZE 22
+
+// Decimal Status Codes
+# define DECIMAL_OK 0
+# define DECIMAL_ERROR_OVERFLOW 1
+# define DECIMAL_ERROR_DIVIDE 2
+
+// Sets the number of decimal places every decimal is scaled by
+void decimal_set_places(int places);
+
+// Gets the number of decimal places every decimal is scaled by
+int decimal_get_places(void);
+
+// Builds a decimal from typed digits and how many of them follow the point
+int decimal_from_digits(int64_t digits, int fraction, int64_t * result);
+
+// Applies a binary operator to two decimals
+int decimal_apply(char operator, int64_t a, int64_t b, int64_t * result);
+
+// Writes a decimal to a buffer with every decimal place shown
+int decimal_to_string(int64_t value, char * buffer);
+
+# endif
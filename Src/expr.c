@@ -0,0 +1,345 @@
+// file: expr.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains an incremental infix expression evaluator with precedence and parentheses
+
+# include <stdint.h>
+# include "expr.h"
+# include "arith.h"
+# include "decimal.h"
+# include "sci.h"
+
+// Operator Characters
+# define EXPR_OPEN '('
+
+// Build Time RAM Report
+# define EXPR_STRING(x) # x
+# define EXPR_VALUE_STRING(x) EXPR_STRING(x)
+# pragma message "expr worst-case RAM bytes: " EXPR_VALUE_STRING(EXPR_RAM_BYTES)
+_Static_assert(sizeof(expr_t) <= EXPR_RAM_BYTES, "expr_t exceeds its reported RAM bound");
+_Static_assert(EXPR_FUNCTION_NOT == SCI_FUNCTIONS, "bitwise not must follow the scientific functions");
+
+// Function Prototypes
+static int expr_precedence(char operator);
+static int expr_reduce(expr_t * expr);
+
+// Empties an expression and sets the arithmetic type it evaluates in
+// @ param expr - the expression to empty
+// @ param type - ARITH_TYPE_INT32, ARITH_TYPE_INT64, ARITH_TYPE_FLOAT, or ARITH_TYPE_DECIMAL
+// @ return void
+void expr_init(expr_t * expr, int type) {
+    expr->type = type;
+    expr->valueCount = 0;
+    expr->operatorCount = 0;
+    expr->openCount = 0;
+    expr->expectValue = 1;
+    expr->lastOperator = 0;
+}
+
+// Adds an operand to an expression
+// @ param expr - the expression
+// @ param value - the operand
+// @ return EXPR_OK, or EXPR_ERROR_SYNTAX if the expression expects an operator
+int expr_push_value(expr_t * expr, expr_value_t value) {
+
+    if (!expr->expectValue) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    // every operand follows an operator or the start, so there is always room for it
+    expr->values[expr->valueCount++] = value;
+    expr->expectValue = 0;
+
+    return EXPR_OK;
+}
+
+// Adds a binary operator to an expression, reducing everything it does not bind tighter than
+// this keeps the stacks as shallow as possible so finishing only reduces what is still pending
+// @ param expr - the expression
+// @ param operator - '+', '-', '*', '/', '%', '^', or one of the bitwise operators of arith_int
+// @ return EXPR_OK, EXPR_ERROR_SYNTAX if the expression expects an operand, EXPR_ERROR_DEPTH if it is full,
+// or EXPR_ERROR_ARITH if a reduction has no result
+int expr_push_operator(expr_t * expr, char operator) {
+
+    if (expr->expectValue || expr_precedence(operator) == 0) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    // operators of equal precedence are left associative, so reduce them too, except powers, which
+    // are right associative and only ever wait for the power to their right
+    int precedence = expr_precedence(operator) + (operator == '^');
+
+    while (expr->operatorCount > 0 &&
+           expr_precedence(expr->operators[expr->operatorCount - 1]) >= precedence) {
+        if (expr_reduce(expr) != EXPR_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    }
+
+    if (expr->operatorCount == EXPR_MAX_DEPTH) {
+        return EXPR_ERROR_DEPTH;
+    }
+
+    expr->operators[expr->operatorCount++] = operator;
+    expr->expectValue = 1;
+
+    return EXPR_OK;
+}
+
+// Opens a parenthesis in an expression
+// @ param expr - the expression
+// @ return EXPR_OK, EXPR_ERROR_SYNTAX if the expression expects an operator, or EXPR_ERROR_DEPTH if it is full
+int expr_open(expr_t * expr) {
+
+    if (!expr->expectValue) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    if (expr->operatorCount == EXPR_MAX_DEPTH) {
+        return EXPR_ERROR_DEPTH;
+    }
+
+    expr->operators[expr->operatorCount++] = EXPR_OPEN;
+    expr->openCount++;
+
+    return EXPR_OK;
+}
+
+// Closes the innermost open parenthesis in an expression
+// @ param expr - the expression
+// @ return EXPR_OK, EXPR_ERROR_SYNTAX if there is nothing to close or an operand is missing, or
+// EXPR_ERROR_ARITH if a reduction has no result
+int expr_close(expr_t * expr) {
+
+    if (expr->expectValue || expr->openCount == 0) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    // reduce the parenthesized operators, then drop the parenthesis itself
+    while (expr->operators[expr->operatorCount - 1] != EXPR_OPEN) {
+        if (expr_reduce(expr) != EXPR_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    }
+
+    expr->operatorCount--;
+    expr->openCount--;
+
+    return EXPR_OK;
+}
+
+// Applies a scientific function to the operand an expression ends with
+// the operand is replaced in place, so the function binds tighter than any operator before it
+// @ param expr - the expression
+// @ param function - one of the SCI function values, or EXPR_FUNCTION_NOT for an integer
+// @ param result - where to store the new operand
+// @ return EXPR_OK, EXPR_ERROR_SYNTAX if the expression expects an operand, or EXPR_ERROR_ARITH if the
+// function has no result for the operand, which is then left as it was
+int expr_apply_function(expr_t * expr, int function, expr_value_t * result) {
+
+    if (expr->expectValue) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    expr_value_t * value = &expr->values[expr->valueCount - 1];
+
+    if (expr_apply_unary(expr->type, function, * value, value) != EXPR_OK) {
+        return EXPR_ERROR_ARITH;
+    }
+
+    * result = * value;
+
+    return EXPR_OK;
+}
+
+// Closes any open parentheses and reduces an expression to its result
+// @ param expr - the expression
+// @ param result - where to store the result
+// @ return EXPR_OK, EXPR_ERROR_SYNTAX if an operand is missing, or EXPR_ERROR_ARITH if a reduction has no result
+int expr_finish(expr_t * expr, expr_value_t * result) {
+
+    if (expr->expectValue) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    // anything still pending is bound no tighter than the operators already reduced
+    while (expr->operatorCount > 0) {
+        if (expr->operators[expr->operatorCount - 1] == EXPR_OPEN) {
+            expr->operatorCount--;
+            expr->openCount--;
+        } else if (expr_reduce(expr) != EXPR_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    }
+
+    * result = expr->values[0];
+
+    return EXPR_OK;
+}
+
+// Gets the operand an expression ends with, which after a result is the result itself
+// @ param expr - the expression
+// @ param value - where to store the operand
+// @ return EXPR_OK, or EXPR_ERROR_SYNTAX if the expression expects an operand
+int expr_get_last_value(const expr_t * expr, expr_value_t * value) {
+
+    if (expr->expectValue) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    * value = expr->values[expr->valueCount - 1];
+
+    return EXPR_OK;
+}
+
+// Gets the operands and operator of the last operation an expression reduced
+// @ param expr - the expression
+// @ param left - where to store the left operand
+// @ param operator - where to store the operator
+// @ param operand - where to store the right operand
+// @ return EXPR_OK, or EXPR_ERROR_SYNTAX if the expression has not reduced an operation
+int expr_get_last_operation(const expr_t * expr, expr_value_t * left, char * operator, expr_value_t * operand) {
+
+    if (expr->lastOperator == 0) {
+        return EXPR_ERROR_SYNTAX;
+    }
+
+    * left = expr->lastLeft;
+    * operator = expr->lastOperator;
+    * operand = expr->lastOperand;
+
+    return EXPR_OK;
+}
+
+// Checks whether an expression is waiting for an operand
+// @ param expr - the expression
+// @ return 1 if the next token must be an operand or an open parenthesis, otherwise 0
+int expr_expects_value(const expr_t * expr) {
+    return expr->expectValue;
+}
+
+// Gets the number of parentheses open in an expression
+// @ param expr - the expression
+// @ return the number of unclosed parentheses
+int expr_get_open_count(const expr_t * expr) {
+    return expr->openCount;
+}
+
+// Applies a binary operator to two operands, reporting a result it cannot produce
+// @ param type - the arithmetic type
+// @ param operator - the operator
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the result, left unchanged on an error
+// @ return EXPR_OK, or EXPR_ERROR_ARITH if it overflows, divides by zero, or has no real value
+int expr_apply(int type, char operator, expr_value_t a, expr_value_t b, expr_value_t * result) {
+
+    if (type == ARITH_TYPE_FLOAT) {
+        if (arith_float(operator, a.f, b.f, &result->f) != ARITH_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    } else if (type == ARITH_TYPE_DECIMAL && operator == '^') {
+        if (sci_decimal_pow(a.i, b.i, &result->i) != SCI_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    } else if (type == ARITH_TYPE_DECIMAL) {
+        if (decimal_apply(operator, a.i, b.i, &result->i) != DECIMAL_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    } else {
+        if (arith_int(type, operator, a.i, b.i, &result->i) != ARITH_OK) {
+            return EXPR_ERROR_ARITH;
+        }
+    }
+
+    return EXPR_OK;
+}
+
+// Applies a scientific function to an operand, reporting a result it cannot produce
+// @ param type - the arithmetic type
+// @ param function - one of the SCI function values, or EXPR_FUNCTION_NOT for an integer
+// @ param value - the operand
+// @ param result - where to store the result, left unchanged on an error
+// @ return EXPR_OK, or EXPR_ERROR_ARITH if the operand is outside the function's domain or the
+// result overflows
+int expr_apply_unary(int type, int function, expr_value_t value, expr_value_t * result) {
+
+    expr_value_t unary;
+    int status;
+
+    // the complement of a sign extended word is still in the word's range
+    if (function == EXPR_FUNCTION_NOT) {
+        result->i = ~value.i;
+        return EXPR_OK;
+    }
+
+    if (type == ARITH_TYPE_FLOAT) {
+        status = sci_float(function, value.f, &unary.f);
+    } else if (type == ARITH_TYPE_DECIMAL) {
+        status = sci_decimal(function, value.i, &unary.i);
+    } else {
+        status = sci_int(function, value.i, &unary.i);
+    }
+
+    if (status != SCI_OK) {
+        return EXPR_ERROR_ARITH;
+    }
+
+    * result = unary;
+
+    return EXPR_OK;
+}
+
+// Gets how tightly an operator binds
+// the bitwise operators bind looser than arithmetic in the same order as they do in C
+// @ param operator - the operator
+// @ return the precedence, higher binds tighter, or 0 if the character is not a binary operator
+static int expr_precedence(char operator) {
+
+    switch (operator) {
+        case '|':
+            return 1;
+        case 'x':
+            return 2;
+        case '&':
+            return 3;
+        case '<':
+        case '>':
+            return 4;
+        case '+':
+        case '-':
+            return 5;
+        case '*':
+        case '/':
+        case '%':
+            return 6;
+        case '^':
+            return 7;
+        default:
+            return 0;
+    }
+}
+
+// Applies the operator on top of the operator stack to the top two operands
+// an expression with an operation that has no result has no result either, so it is left as it is
+// @ param expr - the expression
+// @ return EXPR_OK, or EXPR_ERROR_ARITH if it overflows, divides by zero, or has no real value
+static int expr_reduce(expr_t * expr) {
+
+    expr_value_t a = expr->values[expr->valueCount - 2];
+    expr_value_t b = expr->values[expr->valueCount - 1];
+    char operator = expr->operators[expr->operatorCount - 1];
+
+    if (expr_apply(expr->type, operator, a, b, &expr->values[expr->valueCount - 2]) != EXPR_OK) {
+        return EXPR_ERROR_ARITH;
+    }
+
+    expr->valueCount--;
+    expr->operatorCount--;
+    expr->lastLeft = a;
+    expr->lastOperator = operator;
+    expr->lastOperand = b;
+
+    return EXPR_OK;
+}
@@ -0,0 +1,92 @@
+// file: expr.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for expr.c
+
+# ifndef EXPR_H
+# define EXPR_H
+
+# include <stdint.h>
+
+// Expression Limits
+// the deepest nesting of pending operators and parentheses an expression may hold
+# define EXPR_MAX_DEPTH 16
+
+// Expression Status Codes
+# define EXPR_OK 0
+# define EXPR_ERROR_SYNTAX 1
+# define EXPR_ERROR_DEPTH 2
+# define EXPR_ERROR_ARITH 3
+
+// Bitwise Not
+// the one unary function beyond the scientific ones, numbered right after them
+# define EXPR_FUNCTION_NOT 6
+
+// Expression Value Type
+// the expression type decides which member is valid and which range it must stay in
+typedef union {
+    int64_t i;
+    float f;
+} expr_value_t;
+
+// Expression State
+// operands waiting for an operator to its right, and the operators and open parentheses
+// still waiting to be reduced, with the operands and operator of the last reduction
+typedef struct {
+    expr_value_t values[EXPR_MAX_DEPTH + 1];
+    expr_value_t lastLeft;
+    expr_value_t lastOperand;
+    char operators[EXPR_MAX_DEPTH];
+    char lastOperator;
+    uint8_t valueCount;
+    uint8_t operatorCount;
+    uint8_t openCount;
+    uint8_t expectValue;
+    uint8_t type;
+} expr_t;
+
+// Worst-Case RAM
+// everything the evaluator uses outside of a few locals, checked against expr_t in expr.c
+# define EXPR_RAM_BYTES ((EXPR_MAX_DEPTH + 3) * 8 + EXPR_MAX_DEPTH + 8)
+
+// Empties an expression and sets the arithmetic type it evaluates in
+void expr_init(expr_t * expr, int type);
+
+// Adds an operand to an expression
+int expr_push_value(expr_t * expr, expr_value_t value);
+
+// Adds a binary operator to an expression, reducing everything it does not bind tighter than
+int expr_push_operator(expr_t * expr, char operator);
+
+// Opens a parenthesis in an expression
+int expr_open(expr_t * expr);
+
+// Closes the innermost open parenthesis in an expression
+int expr_close(expr_t * expr);
+
+// Applies a scientific function to the operand an expression ends with
+int expr_apply_function(expr_t * expr, int function, expr_value_t * result);
+
+// Closes any open parentheses and reduces an expression to its result
+int expr_finish(expr_t * expr, expr_value_t * result);
+
+// Gets the operand an expression ends with
+int expr_get_last_value(const expr_t * expr, expr_value_t * value);
+
+// Gets the operands and operator of the last operation an expression reduced
+int expr_get_last_operation(const expr_t * expr, expr_value_t * left, char * operator, expr_value_t * operand);
+
+// Checks whether an expression is waiting for an operand
+int expr_expects_value(const expr_t * expr);
+
+// Gets the number of parentheses open in an expression
+int expr_get_open_count(const expr_t * expr);
+
+// Applies a binary operator to two operands, reporting a result it cannot produce
+int expr_apply(int type, char operator, expr_value_t a, expr_value_t b, expr_value_t * result);
+
+// Applies a scientific function to an operand, reporting a result it cannot produce
+int expr_apply_unary(int type, int function, expr_value_t value, expr_value_t * result);
+
+# endif
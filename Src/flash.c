@@ -0,0 +1,164 @@
+// file: flash.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains functions for erasing and programming the on-chip flash of the STM32F446
+
+# include <stdint.h>
+# include "flash.h"
+
+// FLASH Addresses
+# define FLASH_BASE 0x40023C00
+# define FLASH_ACR (FLASH_BASE + 0x00)
+# define FLASH_KEYR (FLASH_BASE + 0x04)
+# define FLASH_SR (FLASH_BASE + 0x0C)
+# define FLASH_CR (FLASH_BASE + 0x10)
+
+// FLASH Values
+# define FLASH_KEY1 0x45670123
+# define FLASH_KEY2 0xCDEF89AB
+# define FLASH_ACR_DCEN (1 << 10)
+# define FLASH_ACR_DCRST (1 << 12)
+# define FLASH_SR_OPERR (1 << 1)
+# define FLASH_SR_WRPERR (1 << 4)
+# define FLASH_SR_PGAERR (1 << 5)
+# define FLASH_SR_PGPERR (1 << 6)
+# define FLASH_SR_PGSERR (1 << 7)
+# define FLASH_SR_ERRORS (FLASH_SR_OPERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+# define FLASH_SR_BSY (1 << 16)
+# define FLASH_CR_PG (1 << 0)
+# define FLASH_CR_SER (1 << 1)
+# define FLASH_CR_SNB_SHIFT 3
+# define FLASH_CR_PSIZE_X32 (2 << 8)
+# define FLASH_CR_STRT (1 << 16)
+# define FLASH_CR_LOCK (1u << 31)
+
+// Flash Memory
+// sectors 0-3 are 16K, sector 4 is 64K, and sectors 5-7 are 128K
+# define FLASH_MEMORY_BASE 0x08000000
+
+static const uint32_t flashSectorSizes[FLASH_SECTORS] = {
+    0x4000, 0x4000, 0x4000, 0x4000, 0x10000, 0x20000, 0x20000, 0x20000
+};
+
+// Register Pointers
+static volatile uint32_t * const flashACR = (uint32_t *) FLASH_ACR;
+static volatile uint32_t * const flashKEYR = (uint32_t *) FLASH_KEYR;
+static volatile uint32_t * const flashSR = (uint32_t *) FLASH_SR;
+static volatile uint32_t * const flashCR = (uint32_t *) FLASH_CR;
+
+// Function Prototypes
+static void flash_unlock(void);
+static void flash_lock(void);
+static int flash_wait(void);
+
+// Gets the memory-mapped address a flash sector starts at
+// @ param sector - the sector, 0-7
+// @ return the address of the sector's first word
+const uint32_t * flash_sector_address(int sector) {
+
+    uint32_t address = FLASH_MEMORY_BASE;
+
+    for (int i = 0; i < sector; i++) {
+        address += flashSectorSizes[i];
+    }
+
+    return (const uint32_t *) address;
+}
+
+// Gets the size of a flash sector in bytes
+// @ param sector - the sector, 0-7
+// @ return the size of the sector
+uint32_t flash_sector_size(int sector) {
+    return flashSectorSizes[sector];
+}
+
+// Erases a flash sector to all ones
+// the core stalls on any flash read until the erase finishes, which takes up to two seconds for a 128K sector
+// @ param sector - the sector, 0-7
+// @ return FLASH_OK, or FLASH_ERROR if the sector is out of range or the erase failed
+int flash_erase_sector(int sector) {
+
+    if (sector < 0 || sector >= FLASH_SECTORS) {
+        return FLASH_ERROR;
+    }
+
+    flash_unlock();
+
+    * flashCR = FLASH_CR_PSIZE_X32 | FLASH_CR_SER | (sector << FLASH_CR_SNB_SHIFT);
+    * flashCR |= FLASH_CR_STRT;
+
+    int status = flash_wait();
+
+    * flashCR = 0;
+    flash_lock();
+
+    // the data cache may still hold words from before the erase
+    if (* flashACR & FLASH_ACR_DCEN) {
+        * flashACR &= ~FLASH_ACR_DCEN;
+        * flashACR |= FLASH_ACR_DCRST;
+        * flashACR &= ~FLASH_ACR_DCRST;
+        * flashACR |= FLASH_ACR_DCEN;
+    }
+
+    return status;
+}
+
+// Programs words into erased flash
+// programming can only clear bits, so the words must still be erased for them to read back as written
+// @ param address - the word-aligned flash address of the first word
+// @ param words - the words to program
+// @ param count - the number of words to program
+// @ return FLASH_OK, or FLASH_ERROR if any word failed to program
+int flash_program(const uint32_t * address, const uint32_t * words, int count) {
+
+    int status = FLASH_OK;
+
+    flash_unlock();
+
+    // program a full word at a time, which the 2.7-3.6V supply of the board allows
+    * flashCR = FLASH_CR_PSIZE_X32 | FLASH_CR_PG;
+
+    for (int i = 0; i < count && status == FLASH_OK; i++) {
+        * (volatile uint32_t *) (address + i) = words[i];
+        status = flash_wait();
+    }
+
+    * flashCR = 0;
+    flash_lock();
+
+    return status;
+}
+
+// Unlocks the flash control register
+// @ param void
+// @ return void
+static void flash_unlock(void) {
+
+    if (* flashCR & FLASH_CR_LOCK) {
+        * flashKEYR = FLASH_KEY1;
+        * flashKEYR = FLASH_KEY2;
+    }
+}
+
+// Locks the flash control register until the next unlock
+// @ param void
+// @ return void
+static void flash_lock(void) {
+    * flashCR |= FLASH_CR_LOCK;
+}
+
+// Waits for the flash operation in progress to finish and clears its error flags
+// @ param void
+// @ return FLASH_OK, or FLASH_ERROR if the operation set an error flag
+static int flash_wait(void) {
+
+    while (* flashSR & FLASH_SR_BSY);
+
+    uint32_t errors = * flashSR & FLASH_SR_ERRORS;
+
+    // error flags are cleared by writing ones to them
+    * flashSR = errors;
+
+    return errors ? FLASH_ERROR : FLASH_OK;
+}
@@ -0,0 +1,31 @@
+// file: flash.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for flash.c
+
+# ifndef FLASH_H
+# define FLASH_H
+
+# include <stdint.h>
+
+// Flash Characteristics
+# define FLASH_SECTORS 8
+
+// Flash Status Codes
+# define FLASH_OK 0
+# define FLASH_ERROR 1
+
+// Gets the memory-mapped address a flash sector starts at
+const uint32_t * flash_sector_address(int sector);
+
+// Gets the size of a flash sector in bytes
+uint32_t flash_sector_size(int sector);
+
+// Erases a flash sector to all ones
+int flash_erase_sector(int sector);
+
+// Programs words into erased flash
+int flash_program(const uint32_t * address, const uint32_t * words, int count);
+
+# endif
@@ -0,0 +1,543 @@
+// file: fmt.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains functions for converting numbers to strings without printf
+
+# include <stdint.h>
+# include "fmt.h"
+
+// Division Constants
+// (value * 0x51EB851F) >> 37 equals value / 100 for every 32-bit value, and costs one long multiply
+# define FMT_DIV100(value) ((uint32_t) (((uint64_t) (value) * 0x51EB851F) >> 37))
+# define FMT_CHUNK 100000000
+# define FMT_CHUNK_DIGITS 8
+
+// 10^8 is 2^8 * 390625, so shifting out the 2^8 first leaves a value below 2^56, and for those the high
+// word of value * ceil(2^75 / 390625) shifted right by 11 equals value / 390625, generated offline
+# define FMT_CHUNK_PRESHIFT 8
+# define FMT_CHUNK_RECIPROCAL 0x015798EE2308C39E
+# define FMT_CHUNK_SHIFT 11
+
+// Float Characteristics
+# define FMT_FLOAT_MANTISSA_BITS 23
+# define FMT_FLOAT_EXPONENT_BITS 8
+# define FMT_FLOAT_BIAS 127
+# define FMT_FLOAT_POW10_MIN -31
+
+// Float Layout
+// values whose leading digit sits between 10^-5 and 10^9 print without an exponent
+# define FMT_FLOAT_FIXED_MIN -5
+# define FMT_FLOAT_FIXED_MAX 9
+
+// Function Prototypes
+static int fmt_count_digits(uint32_t value);
+static void fmt_write_digits(uint32_t value, char * end, int digits);
+static char * fmt_write_point(uint32_t value, char * out, int digits, int whole);
+static int fmt_float_shortest(uint32_t bits, uint32_t * digits, int * exponent);
+static uint32_t fmt_round_to_odd(uint64_t factor, uint32_t m);
+static uint64_t fmt_div_chunk(uint64_t value, uint32_t * remainder);
+
+// Digit Pairs
+// the two characters of every value from 00 to 99, so each step emits two digits
+static const char fmtDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Digit Characters
+// the character of every digit up to 15, so each nibble of a power of two base is one lookup
+static const char fmtDigits[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+// Powers of Ten
+static const uint32_t fmtPowers[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// Float Conversion Table
+// 10^e for e from -31 to 45, scaled to 64 significant bits and rounded up, generated offline, these let
+// a float be converted to its shortest round-trip digits with 32x64-bit multiplies instead of big arithmetic
+static const uint64_t fmtPow10Split[77] = {
+    9353610478917778677u, 11692013098647223346u, 14615016373309029183u,
+    18268770466636286478u, 11417981541647679049u, 14272476927059598811u,
+    17840596158824498514u, 11150372599265311571u, 13937965749081639464u,
+    17422457186352049330u, 10889035741470030831u, 13611294676837538539u,
+    17014118346046923174u, 10633823966279326984u, 13292279957849158730u,
+    16615349947311448412u, 10384593717069655258u, 12980742146337069072u,
+    16225927682921336340u, 10141204801825835212u, 12676506002282294015u,
+    15845632502852867519u, 9903520314283042200u, 12379400392853802749u,
+    15474250491067253437u, 9671406556917033398u, 12089258196146291748u,
+    15111572745182864684u, 9444732965739290428u, 11805916207174113035u,
+    14757395258967641293u, 9223372036854775809u, 11529215046068469761u,
+    14411518807585587201u, 18014398509481984001u, 11258999068426240001u,
+    14073748835532800001u, 17592186044416000001u, 10995116277760000001u,
+    13743895347200000001u, 17179869184000000001u, 10737418240000000001u,
+    13421772800000000001u, 16777216000000000001u, 10485760000000000001u,
+    13107200000000000001u, 16384000000000000001u, 10240000000000000001u,
+    12800000000000000001u, 16000000000000000001u, 10000000000000000001u,
+    12500000000000000001u, 15625000000000000001u, 9765625000000000001u,
+    12207031250000000001u, 15258789062500000001u, 9536743164062500001u,
+    11920928955078125001u, 14901161193847656251u, 9313225746154785157u,
+    11641532182693481446u, 14551915228366851807u, 18189894035458564759u,
+    11368683772161602974u, 14210854715202003718u, 17763568394002504647u,
+    11102230246251565405u, 13877787807814456756u, 17347234759768070945u,
+    10842021724855044341u, 13552527156068805426u, 16940658945086006782u,
+    10587911840678754239u, 13234889800848442798u, 16543612251060553498u,
+    10339757656912845936u, 12924697071141057420u
+};
+
+// Writes an unsigned 32-bit integer to a buffer in decimal
+// @ param value - the value to write
+// @ param buffer - the buffer to write to, at least FMT_INT32_SIZE characters
+// @ return the number of characters written, not counting the null terminator
+int fmt_uint32(uint32_t value, char * buffer) {
+
+    int length = fmt_count_digits(value);
+
+    // the length is known up front, so the digits go straight into place from the back
+    fmt_write_digits(value, buffer + length, length);
+    buffer[length] = '\0';
+
+    return length;
+}
+
+// Writes an unsigned 32-bit integer to a buffer in decimal, zero padded to a fixed width
+// @ param value - the value to write, it must fit in the given number of digits
+// @ param buffer - the buffer to write to, at least digits + 1 characters
+// @ param digits - the number of digits to write, 1-10
+// @ return the number of characters written, not counting the null terminator
+int fmt_uint32_padded(uint32_t value, char * buffer, int digits) {
+
+    fmt_write_digits(value, buffer + digits, digits);
+    buffer[digits] = '\0';
+
+    return digits;
+}
+
+// Writes a signed 32-bit integer to a buffer in decimal
+// @ param value - the value to write
+// @ param buffer - the buffer to write to, at least FMT_INT32_SIZE characters
+// @ return the number of characters written, not counting the null terminator
+int fmt_int32(int32_t value, char * buffer) {
+
+    // negate in unsigned arithmetic so INT32_MIN has a magnitude
+    if (value < 0) {
+        buffer[0] = '-';
+        return fmt_uint32(0u - (uint32_t) value, buffer + 1) + 1;
+    }
+
+    return fmt_uint32((uint32_t) value, buffer);
+}
+
+// Writes an unsigned 64-bit integer to a buffer in decimal
+// @ param value - the value to write
+// @ param buffer - the buffer to write to, at least FMT_INT64_SIZE characters
+// @ return the number of characters written, not counting the null terminator
+int fmt_uint64(uint64_t value, char * buffer) {
+
+    if (value <= UINT32_MAX) {
+        return fmt_uint32((uint32_t) value, buffer);
+    }
+
+    // split into 8-digit chunks with reciprocal multiplies, so no 64-bit division is needed
+    uint32_t low;
+    value = fmt_div_chunk(value, &low);
+
+    uint32_t middle;
+    uint32_t high;
+    int middleDigits;
+
+    if (value <= UINT32_MAX) {
+        middle = (uint32_t) value;
+        middleDigits = fmt_count_digits(middle);
+        high = 0;
+    } else {
+        high = (uint32_t) fmt_div_chunk(value, &middle);
+        middleDigits = FMT_CHUNK_DIGITS;
+    }
+
+    int highDigits = high ? fmt_count_digits(high) : 0;
+    int length = highDigits + middleDigits + FMT_CHUNK_DIGITS;
+
+    char * end = buffer + length;
+    fmt_write_digits(low, end, FMT_CHUNK_DIGITS);
+    end -= FMT_CHUNK_DIGITS;
+    fmt_write_digits(middle, end, middleDigits);
+    end -= middleDigits;
+    if (high) {
+        fmt_write_digits(high, end, highDigits);
+    }
+
+    buffer[length] = '\0';
+
+    return length;
+}
+
+// Writes a signed 64-bit integer to a buffer in decimal
+// @ param value - the value to write
+// @ param buffer - the buffer to write to, at least FMT_INT64_SIZE characters
+// @ return the number of characters written, not counting the null terminator
+int fmt_int64(int64_t value, char * buffer) {
+
+    // negate in unsigned arithmetic so INT64_MIN has a magnitude
+    if (value < 0) {
+        buffer[0] = '-';
+        return fmt_uint64(0u - (uint64_t) value, buffer + 1) + 1;
+    }
+
+    return fmt_uint64((uint64_t) value, buffer);
+}
+
+// Writes the low bits of an unsigned integer to a buffer in base 2, 8, or 16, zero padded to as many
+// digits as that many bits take, so a word always shows at the same width
+// @ param value - the value to write
+// @ param buffer - the buffer to write to, at least FMT_RADIX_SIZE characters
+// @ param base - 2, 8, or 16
+// @ param bits - the number of low bits to write, 1-64
+// @ return the number of characters written, not counting the null terminator
+int fmt_radix(uint64_t value, char * buffer, int base, int bits) {
+
+    // each digit is a fixed number of bits, so digits come from shifts and masks rather than division
+    int shift = (base == 16) ? 4 : (base == 8) ? 3 : 1;
+    int digits = (bits + shift - 1) / shift;
+    int mask = base - 1;
+
+    if (bits < 64) {
+        value &= ((uint64_t) 1 << bits) - 1;
+    }
+
+    for (int i = digits - 1; i >= 0; i--) {
+        buffer[i] = fmtDigits[value & mask];
+        value >>= shift;
+    }
+
+    buffer[digits] = '\0';
+
+    return digits;
+}
+
+// Gets the character of a digit
+// @ param digit - the digit, 0-15
+// @ return the character, '0'-'9' or 'A'-'F'
+char fmt_digit(int digit) {
+    return fmtDigits[digit & 0xF];
+}
+
+// Writes a float to a buffer in decimal with the fewest digits that read back as the same float
+// @ param value - the value to write
+// @ param buffer - the buffer to write to, at least FMT_FLOAT_SIZE characters
+// @ param precision - the most significant digits to show, 1-9, rounding away the rest
+// @ return the number of characters written, not counting the null terminator
+int fmt_float(float value, char * buffer, int precision) {
+
+    union { float f; uint32_t u; } pun = { value };
+    uint32_t bits = pun.u;
+    int length = 0;
+
+    if (bits >> 31) {
+        buffer[length++] = '-';
+    }
+
+    // infinities and NaNs have every exponent bit set, a NaN has no meaningful sign
+    if (((bits >> FMT_FLOAT_MANTISSA_BITS) & 0xFF) == 0xFF) {
+        const char * name = "inf";
+        if (bits & ((1u << FMT_FLOAT_MANTISSA_BITS) - 1)) {
+            name = "nan";
+            length = 0;
+        }
+        for (int i = 0; i < 3; i++) {
+            buffer[length++] = name[i];
+        }
+        buffer[length] = '\0';
+        return length;
+    }
+
+    // zero of either sign prints as a plain 0
+    if ((bits & 0x7FFFFFFF) == 0) {
+        buffer[0] = '0';
+        buffer[1] = '\0';
+        return 1;
+    }
+
+    if (precision < 1) precision = 1;
+    if (precision > 9) precision = 9;
+
+    // a whole number below 2^24 is exact and its shortest digits are its own, so it prints the way
+    // an integer does without going through the shortest search
+    uint32_t biased = (bits >> FMT_FLOAT_MANTISSA_BITS) & 0xFF;
+    if (biased >= FMT_FLOAT_BIAS && biased <= FMT_FLOAT_BIAS + FMT_FLOAT_MANTISSA_BITS) {
+        int shift = FMT_FLOAT_BIAS + FMT_FLOAT_MANTISSA_BITS - biased;
+        uint32_t mantissa = (bits & ((1u << FMT_FLOAT_MANTISSA_BITS) - 1)) | (1u << FMT_FLOAT_MANTISSA_BITS);
+        uint32_t whole = mantissa >> shift;
+        if ((whole << shift) == mantissa && whole < fmtPowers[precision]) {
+            return length + fmt_uint32(whole, buffer + length);
+        }
+    }
+
+    uint32_t digits;
+    int exponent;
+    int count = fmt_float_shortest(bits, &digits, &exponent);
+
+    // round the shortest digits down to the display precision, half away from zero
+    if (count > precision) {
+        uint32_t scale = fmtPowers[count - precision];
+        uint32_t rest = digits % scale;
+        digits /= scale;
+        if (rest >= scale / 2) {
+            digits++;
+        }
+        exponent += count - precision;
+        count = precision;
+        if (digits == fmtPowers[count]) {
+            digits /= 10;
+            exponent++;
+        }
+    }
+
+    // rounding and the shortest search both leave trailing zeros to fold into the exponent
+    while (count > 1 && digits % 10 == 0) {
+        digits /= 10;
+        exponent++;
+        count--;
+    }
+
+    // the value is digits * 10^exponent, lead is the power of ten of its first digit
+    int lead = exponent + count - 1;
+    char * out = buffer + length;
+
+    if (lead >= FMT_FLOAT_FIXED_MIN && lead <= FMT_FLOAT_FIXED_MAX) {
+
+        if (exponent >= 0) {
+
+            // an integer, pad with zeros
+            fmt_write_digits(digits, out + count, count);
+            out += count;
+            for (int i = 0; i < exponent; i++) {
+                * out++ = '0';
+            }
+
+        } else if (lead >= 0) {
+
+            // the point falls inside the digits
+            out = fmt_write_point(digits, out, count, lead + 1);
+
+        } else {
+
+            // the point comes before the digits
+            * out++ = '0';
+            * out++ = '.';
+            for (int i = 0; i < -lead - 1; i++) {
+                * out++ = '0';
+            }
+            fmt_write_digits(digits, out + count, count);
+            out += count;
+        }
+
+    } else {
+
+        // scientific notation with a single leading digit
+        if (count > 1) {
+            out = fmt_write_point(digits, out, count, 1);
+        } else {
+            * out++ = '0' + digits;
+        }
+        * out++ = 'e';
+        out += fmt_int32(lead, out);
+    }
+
+    * out = '\0';
+
+    return out - buffer;
+}
+
+// Finds the shortest decimal digits that round to a finite nonzero float, following Schubfach by
+// Raffaello Giulietti, which settles them in one step where Ryu removes digits one at a time
+// @ param bits - the bits of the float
+// @ param digits - where to store the digits, at most 9 of them
+// @ param exponent - where to store the power of ten the digits are scaled by
+// @ return the number of digits
+static int fmt_float_shortest(uint32_t bits, uint32_t * digits, int * exponent) {
+
+    uint32_t ieeeMantissa = bits & ((1u << FMT_FLOAT_MANTISSA_BITS) - 1);
+    uint32_t ieeeExponent = (bits >> FMT_FLOAT_MANTISSA_BITS) & ((1u << FMT_FLOAT_EXPONENT_BITS) - 1);
+
+    // unpack to c * 2^q
+    int q;
+    uint32_t c;
+
+    if (ieeeExponent == 0) {
+        q = 1 - FMT_FLOAT_BIAS - FMT_FLOAT_MANTISSA_BITS;
+        c = ieeeMantissa;
+    } else {
+        q = (int) ieeeExponent - FMT_FLOAT_BIAS - FMT_FLOAT_MANTISSA_BITS;
+        c = (1u << FMT_FLOAT_MANTISSA_BITS) | ieeeMantissa;
+    }
+
+    // an odd mantissa excludes the halfway points to its neighbors, since they round to even
+    uint32_t exclusive = c & 1;
+
+    // the value and the halfway points to its lower and upper neighbors, times four so they are
+    // integers, the lower neighbor is twice as close when the value is a power of two
+    uint32_t cb = c << 2;
+    uint32_t cbr = cb + 2;
+    uint32_t cbl;
+    int k;
+
+    if (ieeeMantissa != 0 || ieeeExponent <= 1) {
+        cbl = cb - 2;
+        k = (q * 78913) >> 18;
+    } else {
+        cbl = cb - 1;
+        k = (q * 78913 - 32752) >> 18;
+    }
+
+    // scale all three by 10^-k, so the halfway points are between one and ten units apart and only
+    // the value's two nearest integers and two nearest multiples of ten can be the shortest digits
+    uint64_t factor = fmtPow10Split[-k - FMT_FLOAT_POW10_MIN];
+    int h = q + ((-k * 1741647) >> 19) + 1;
+
+    uint32_t vb = fmt_round_to_odd(factor, cb << h);
+    uint32_t vbl = fmt_round_to_odd(factor, cbl << h);
+    uint32_t vbr = fmt_round_to_odd(factor, cbr << h);
+
+    uint32_t s = vb >> 2;
+
+    // a multiple of ten in the interval is one digit shorter than anything else in it
+    if (s >= 10) {
+
+        uint32_t sp10 = (s / 10) * 10;
+        uint32_t tp10 = sp10 + 10;
+        int upIn = vbl + exclusive <= sp10 << 2;
+        int wpIn = (tp10 << 2) + exclusive <= vbr;
+
+        if (upIn != wpIn) {
+            * digits = upIn ? sp10 : tp10;
+            * exponent = k;
+            return fmt_count_digits(* digits);
+        }
+    }
+
+    // otherwise the integer on either side of the value that is in the interval, the nearer if both
+    uint32_t t = s + 1;
+    int uIn = vbl + exclusive <= s << 2;
+    int wIn = (t << 2) + exclusive <= vbr;
+
+    if (uIn != wIn) {
+        * digits = uIn ? s : t;
+    } else {
+        // an exact tie rounds to even
+        uint32_t middle = (s + t) << 1;
+        * digits = vb < middle || (vb == middle && (s & 1) == 0) ? s : t;
+    }
+
+    * exponent = k;
+
+    return fmt_count_digits(* digits);
+}
+
+// Multiplies a 32-bit value by a 64-bit factor, keeping the high 32 bits of the 96-bit product and
+// rounding to odd, so a product with any fraction never compares equal to an even integer
+// the low 32 bits hold only the error of the rounded factor, so they are left out of the rounding
+// @ param factor - the factor
+// @ param m - the value, less than 2^30
+// @ return the high 32 bits of the product, with the lowest set if the fraction is not zero
+static uint32_t fmt_round_to_odd(uint64_t factor, uint32_t m) {
+
+    uint64_t low = (uint64_t) m * (uint32_t) factor;
+    uint64_t high = (uint64_t) m * (uint32_t) (factor >> 32);
+    uint64_t product = high + (low >> 32);
+
+    return (uint32_t) (product >> 32) | ((uint32_t) product != 0);
+}
+
+// Divides a value by 10^8 with a reciprocal multiply
+// @ param value - the value
+// @ param remainder - where to store the remainder
+// @ return the quotient
+static uint64_t fmt_div_chunk(uint64_t value, uint32_t * remainder) {
+
+    uint64_t shifted = value >> FMT_CHUNK_PRESHIFT;
+    uint64_t shiftedLow = (uint32_t) shifted;
+    uint64_t shiftedHigh = shifted >> 32;
+    uint64_t reciprocalLow = (uint32_t) FMT_CHUNK_RECIPROCAL;
+    uint64_t reciprocalHigh = (uint64_t) FMT_CHUNK_RECIPROCAL >> 32;
+
+    // the high 64 bits of the 120-bit product, from four 32x32-bit long multiplies
+    uint64_t lowLow = shiftedLow * reciprocalLow;
+    uint64_t lowHigh = shiftedLow * reciprocalHigh;
+    uint64_t highLow = shiftedHigh * reciprocalLow;
+    uint64_t highHigh = shiftedHigh * reciprocalHigh;
+
+    uint64_t middle = (lowLow >> 32) + (uint32_t) lowHigh + (uint32_t) highLow;
+    uint64_t quotient = (highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32)) >> FMT_CHUNK_SHIFT;
+
+    * remainder = (uint32_t) (value - quotient * FMT_CHUNK);
+
+    return quotient;
+}
+
+// Counts the decimal digits in a value
+// @ param value - the value to count
+// @ return the number of digits, at least 1
+static int fmt_count_digits(uint32_t value) {
+
+    int digits = 1;
+
+    while (digits < 10 && value >= fmtPowers[digits]) {
+        digits++;
+    }
+
+    return digits;
+}
+
+// Writes exactly the given number of digits of a value, zero padded, ending just before end
+// @ param value - the value to write
+// @ param end - one past the last character to write
+// @ param digits - the number of digits to write
+// @ return void
+static void fmt_write_digits(uint32_t value, char * end, int digits) {
+
+    // two digits per step from the least significant end
+    while (digits >= 2) {
+        uint32_t quotient = FMT_DIV100(value);
+        int pair = (value - quotient * 100) * 2;
+        * --end = fmtDigitPairs[pair + 1];
+        * --end = fmtDigitPairs[pair];
+        value = quotient;
+        digits -= 2;
+    }
+
+    // an odd count leaves a single leading digit
+    if (digits == 1) {
+        * --end = '0' + value % 10;
+    }
+}
+
+// Writes exactly the given number of digits of a value with a decimal point after the leading ones
+// the digits go down in one pass and the leading ones move up to make room, so no division by a
+// variable power of ten is needed to split them
+// @ param value - the value to write
+// @ param out - where to write the first character
+// @ param digits - the number of digits to write
+// @ param whole - the number of digits before the point, less than digits
+// @ return one past the last character written
+static char * fmt_write_point(uint32_t value, char * out, int digits, int whole) {
+
+    fmt_write_digits(value, out + digits + 1, digits);
+
+    for (int i = 0; i < whole; i++) {
+        out[i] = out[i + 1];
+    }
+    out[whole] = '.';
+
+    return out + digits + 1;
+}
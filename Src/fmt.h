@@ -0,0 +1,43 @@
+// file: fmt.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for fmt.c
+
+# ifndef FMT_H
+# define FMT_H
+
+# include <stdint.h>
+
+// Buffer Sizes
+// large enough for the sign, every digit, and the null terminator
+# define FMT_INT32_SIZE 12
+# define FMT_INT64_SIZE 21
+# define FMT_FLOAT_SIZE 24
+# define FMT_RADIX_SIZE 65
+
+// Writes an unsigned 32-bit integer to a buffer in decimal
+int fmt_uint32(uint32_t value, char * buffer);
+
+// Writes an unsigned 32-bit integer to a buffer in decimal, zero padded to a fixed width
+int fmt_uint32_padded(uint32_t value, char * buffer, int digits);
+
+// Writes a signed 32-bit integer to a buffer in decimal
+int fmt_int32(int32_t value, char * buffer);
+
+// Writes an unsigned 64-bit integer to a buffer in decimal
+int fmt_uint64(uint64_t value, char * buffer);
+
+// Writes a signed 64-bit integer to a buffer in decimal
+int fmt_int64(int64_t value, char * buffer);
+
+// Writes the low bits of an unsigned integer to a buffer in base 2, 8, or 16, zero padded to a fixed width
+int fmt_radix(uint64_t value, char * buffer, int base, int bits);
+
+// Gets the character of a digit
+char fmt_digit(int digit);
+
+// Writes a float to a buffer in decimal with the fewest digits that read back as the same float
+int fmt_float(float value, char * buffer, int precision);
+
+# endif
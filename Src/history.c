@@ -0,0 +1,128 @@
+// file: history.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a fixed-capacity ring buffer of past calculations and their results
+
+# include <stdint.h>
+# include "history.h"
+# include "expr.h"
+
+// Function Prototypes
+static int history_slot(int index);
+
+// History State
+// results and the operands of the operations that gave them are kept as the binary values they were
+// calculated as, with the arithmetic types and operators in separate arrays so no entry is padded out
+// to the alignment of its values, an operator of 0 marks a result that no operation gave
+static expr_value_t historyValues[HISTORY_SIZE];
+static expr_value_t historyLefts[HISTORY_SIZE];
+static expr_value_t historyRights[HISTORY_SIZE];
+static uint8_t historyTypes[HISTORY_SIZE];
+static char historyOperators[HISTORY_SIZE];
+static uint8_t historyNewest = HISTORY_SIZE - 1;
+static uint8_t historyCount;
+
+// Discards every result in the history
+// @ param void
+// @ return void
+void history_clear(void) {
+    historyNewest = HISTORY_SIZE - 1;
+    historyCount = 0;
+}
+
+// Adds a result and the operation that gave it to the history, overwriting the oldest one if it is full
+// @ param type - the arithmetic type the result was calculated in
+// @ param operator - the operator that gave the result, or 0 if no operation did
+// @ param left - the left operand, ignored without an operator
+// @ param right - the right operand, ignored without an operator
+// @ param value - the result
+// @ return void
+void history_add(int type, char operator, expr_value_t left, expr_value_t right, expr_value_t value) {
+
+    historyNewest = (historyNewest + 1) % HISTORY_SIZE;
+    historyValues[historyNewest] = value;
+    historyLefts[historyNewest] = left;
+    historyRights[historyNewest] = right;
+    historyTypes[historyNewest] = type;
+    historyOperators[historyNewest] = operator;
+
+    if (historyCount < HISTORY_SIZE) {
+        historyCount++;
+    }
+}
+
+// Gets the number of results in the history
+// @ param void
+// @ return the number of results
+int history_get_count(void) {
+    return historyCount;
+}
+
+// Gets a result from the history
+// @ param index - how far back the result is, 0 is the newest
+// @ param type - where to store the arithmetic type the result was calculated in
+// @ param value - where to store the result
+// @ return HISTORY_OK, or HISTORY_ERROR_RANGE if the history does not go back that far
+int history_get(int index, int * type, expr_value_t * value) {
+
+    if (index < 0 || index >= historyCount) {
+        return HISTORY_ERROR_RANGE;
+    }
+
+    int slot = history_slot(index);
+
+    * type = historyTypes[slot];
+    * value = historyValues[slot];
+
+    return HISTORY_OK;
+}
+
+// Gets the operation that gave a result in the history
+// @ param index - how far back the result is, 0 is the newest
+// @ param operator - where to store the operator, 0 if no operation gave the result
+// @ param left - where to store the left operand
+// @ param right - where to store the right operand
+// @ return HISTORY_OK, or HISTORY_ERROR_RANGE if the history does not go back that far
+int history_get_operation(int index, char * operator, expr_value_t * left, expr_value_t * right) {
+
+    if (index < 0 || index >= historyCount) {
+        return HISTORY_ERROR_RANGE;
+    }
+
+    int slot = history_slot(index);
+
+    * operator = historyOperators[slot];
+    * left = historyLefts[slot];
+    * right = historyRights[slot];
+
+    return HISTORY_OK;
+}
+
+// Sets the operation that gave a result in the history, for restoring one saved apart from its result
+// @ param index - how far back the result is, 0 is the newest
+// @ param operator - the operator, or 0 if no operation gave the result
+// @ param left - the left operand
+// @ param right - the right operand
+// @ return HISTORY_OK, or HISTORY_ERROR_RANGE if the history does not go back that far
+int history_set_operation(int index, char operator, expr_value_t left, expr_value_t right) {
+
+    if (index < 0 || index >= historyCount) {
+        return HISTORY_ERROR_RANGE;
+    }
+
+    int slot = history_slot(index);
+
+    historyOperators[slot] = operator;
+    historyLefts[slot] = left;
+    historyRights[slot] = right;
+
+    return HISTORY_OK;
+}
+
+// Gets the ring buffer slot that holds an entry of the history
+// @ param index - how far back the entry is, 0 is the newest
+// @ return the index into the history arrays
+static int history_slot(int index) {
+    return (historyNewest + HISTORY_SIZE - index) % HISTORY_SIZE;
+}
@@ -0,0 +1,41 @@
+// file: history.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for history.c
+
+# ifndef HISTORY_H
+# define HISTORY_H
+
+# include <stdint.h>
+# include "expr.h"
+
+// History Capacity
+// the number of calculations kept before the oldest is overwritten
+# ifndef HISTORY_SIZE
+# define HISTORY_SIZE 16
+# endif
+
+// History Status Codes
+# define HISTORY_OK 0
+# define HISTORY_ERROR_RANGE 1
+
+// Discards every result in the history
+void history_clear(void);
+
+// Adds a result and the operation that gave it to the history, overwriting the oldest one if it is full
+void history_add(int type, char operator, expr_value_t left, expr_value_t right, expr_value_t value);
+
+// Gets the number of results in the history
+int history_get_count(void);
+
+// Gets a result from the history
+int history_get(int index, int * type, expr_value_t * value);
+
+// Gets the operation that gave a result in the history
+int history_get_operation(int index, char * operator, expr_value_t * left, expr_value_t * right);
+
+// Sets the operation that gave a result in the history
+int history_set_operation(int index, char operator, expr_value_t left, expr_value_t right);
+
+# endif
@@ -0,0 +1,134 @@
+// file: irq.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains functions for configuring NVIC priorities and enabling interrupts
+
+# include <stdint.h>
+# include "irq.h"
+
+// SCB Addresses
+# define SCB_AIRCR 0xE000ED0C
+
+// SCB Values
+# define SCB_AIRCR_VECTKEY (0x05FA << 16)
+# define SCB_AIRCR_PRIGROUP_MASK (0b111 << 8)
+# define SCB_AIRCR_PRIGROUP_2_2 (0b101 << 8)
+
+// NVIC Addresses
+# define NVIC_BASE 0xE000E100
+# define NVIC_ISER (NVIC_BASE + 0x000)
+# define NVIC_ICER (NVIC_BASE + 0x080)
+# define NVIC_ICPR (NVIC_BASE + 0x180)
+# define NVIC_IPR (NVIC_BASE + 0x300)
+
+// NVIC Characteristics
+// the STM32F446 implements the top 4 priority bits, split here into 2 preemption and 2 sub bits
+# define NVIC_IRQ_COUNT 97
+# define NVIC_PRIORITY_SHIFT 4
+# define NVIC_PREEMPT_BITS 2
+# define NVIC_SUB_BITS 2
+# define NVIC_PREEMPT_MAX ((1 << NVIC_PREEMPT_BITS) - 1)
+# define NVIC_SUB_MAX ((1 << NVIC_SUB_BITS) - 1)
+
+// Register Pointers
+static volatile uint32_t * const nvicISER = (uint32_t *) NVIC_ISER;
+static volatile uint32_t * const nvicICER = (uint32_t *) NVIC_ICER;
+static volatile uint32_t * const nvicICPR = (uint32_t *) NVIC_ICPR;
+static volatile uint8_t * const nvicIPR = (uint8_t *) NVIC_IPR;
+
+// Sets the priority grouping and drops every interrupt to background priority
+// @ param void
+// @ return void
+void irq_init(void) {
+
+    // 2 bits of preemption priority and 2 bits of subpriority
+    uint32_t * scbAIRCR = (uint32_t *) SCB_AIRCR;
+    * scbAIRCR = SCB_AIRCR_VECTKEY | (* scbAIRCR & ~(SCB_AIRCR_PRIGROUP_MASK | 0xFFFF0000)) | SCB_AIRCR_PRIGROUP_2_2;
+
+    // anything not given a priority explicitly must not preempt the drivers
+    for (int irq = 0; irq < NVIC_IRQ_COUNT; irq++) {
+        irq_set_priority(irq, IRQ_PRIORITY_BACKGROUND, 0);
+    }
+}
+
+// Sets the preemption priority and subpriority of an interrupt
+// @ param irq - the interrupt number
+// @ param preempt - the preemption priority, 0-3 with 0 the most urgent
+// @ param sub - the subpriority among pending interrupts of equal preemption priority, 0-3
+// @ return void
+void irq_set_priority(int irq, int preempt, int sub) {
+
+    if (irq < 0 || irq >= NVIC_IRQ_COUNT) {
+        return;
+    }
+
+    if (preempt > NVIC_PREEMPT_MAX) preempt = NVIC_PREEMPT_MAX;
+    if (sub > NVIC_SUB_MAX) sub = NVIC_SUB_MAX;
+
+    nvicIPR[irq] = ((preempt << NVIC_SUB_BITS) | sub) << NVIC_PRIORITY_SHIFT;
+}
+
+// Enables an interrupt in the NVIC
+// @ param irq - the interrupt number
+// @ return void
+void irq_enable(int irq) {
+    if (irq >= 0 && irq < NVIC_IRQ_COUNT) {
+        nvicISER[irq >> 5] = (1 << (irq & 31));
+    }
+}
+
+// Disables an interrupt in the NVIC
+// @ param irq - the interrupt number
+// @ return void
+void irq_disable(int irq) {
+    if (irq >= 0 && irq < NVIC_IRQ_COUNT) {
+        nvicICER[irq >> 5] = (1 << (irq & 31));
+    }
+}
+
+// Clears an interrupt that is pending in the NVIC
+// @ param irq - the interrupt number
+// @ return void
+void irq_clear_pending(int irq) {
+    if (irq >= 0 && irq < NVIC_IRQ_COUNT) {
+        nvicICPR[irq >> 5] = (1 << (irq & 31));
+    }
+}
+
+// Masks every interrupt and returns the previous mask
+// host builds have no interrupts to mask, their stand-in handlers run on threads that only ever
+// touch the single-producer/single-consumer queues
+// @ param void
+// @ return the previous mask, to hand to irq_restore
+uint32_t irq_mask(void) {
+
+    uint32_t primask = 0;
+
+# if defined(__arm__)
+    __asm volatile ("mrs %0, primask" : "=r" (primask));
+    __asm volatile ("cpsid i" ::: "memory");
+# endif
+
+    return primask;
+}
+
+// Restores the interrupt mask returned by irq_mask
+// @ param mask - the mask irq_mask returned
+// @ return void
+void irq_restore(uint32_t mask) {
+# if defined(__arm__)
+    __asm volatile ("msr primask, %0" :: "r" (mask) : "memory");
+# endif
+}
+
+// Idles the core until an interrupt is pending
+// a pending interrupt wakes the core even while irq_mask has it masked, and its handler runs
+// once the mask is restored
+// @ param void
+// @ return void
+void irq_wait(void) {
+# if defined(__arm__)
+    __asm volatile ("wfi" ::: "memory");
+# endif
+}
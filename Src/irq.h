@@ -0,0 +1,50 @@
+// file: irq.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for irq.c
+
+# ifndef IRQ_H
+# define IRQ_H
+
+# include <stdint.h>
+
+// Interrupt Numbers
+# define IRQ_EXTI0 6
+# define IRQ_EXTI1 7
+# define IRQ_EXTI2 8
+# define IRQ_EXTI3 9
+# define IRQ_TIM2 28
+# define IRQ_TIM6_DAC 54
+
+// Preemption Priorities
+// lower numbers preempt higher ones, timing interrupts must be able to cut into keypad handling
+# define IRQ_PRIORITY_TIMING 1
+# define IRQ_PRIORITY_KEYPAD 2
+# define IRQ_PRIORITY_BACKGROUND 3
+
+// Sets the priority grouping and drops every interrupt to background priority
+void irq_init(void);
+
+// Sets the preemption priority and subpriority of an interrupt
+void irq_set_priority(int irq, int preempt, int sub);
+
+// Enables an interrupt in the NVIC
+void irq_enable(int irq);
+
+// Disables an interrupt in the NVIC
+void irq_disable(int irq);
+
+// Clears an interrupt that is pending in the NVIC
+void irq_clear_pending(int irq);
+
+// Masks every interrupt and returns the previous mask
+uint32_t irq_mask(void);
+
+// Restores the interrupt mask returned by irq_mask
+void irq_restore(uint32_t mask);
+
+// Idles the core until an interrupt is pending
+void irq_wait(void);
+
+# endif
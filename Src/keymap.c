@@ -0,0 +1,190 @@
+// file: keymap.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the layered mapping from keypad events to calculator actions
+
+# include <stdint.h>
+# include "keymap.h"
+# include "keypad_driver.h"
+
+// Keypad Characteristics
+# define KEYMAP_KEYS 16
+
+// Layer Tables
+// one action per key number for every layer, index 0 is unused so a key number indexes directly
+//
+//   1   2   3   A
+//   4   5   6   B
+//   7   8   9   C
+//   *   0   #   D
+//
+// on the base layer * and # are modifiers: tapped alone they clear and evaluate, held down they
+// select the shift and function layers for any key pressed with them
+static const uint8_t keymapLayers[KEYMAP_LAYERS][KEYMAP_KEYS + 1] =
+{
+    // base layer
+    {
+        ACTION_NONE,
+        ACTION_DIGIT_1, ACTION_DIGIT_2, ACTION_DIGIT_3, ACTION_ADD,
+        ACTION_DIGIT_4, ACTION_DIGIT_5, ACTION_DIGIT_6, ACTION_SUBTRACT,
+        ACTION_DIGIT_7, ACTION_DIGIT_8, ACTION_DIGIT_9, ACTION_MULTIPLY,
+        ACTION_CLEAR,   ACTION_DIGIT_0, ACTION_EQUALS,  ACTION_DIVIDE
+    },
+
+    // shift layer, held *
+    {
+        ACTION_NONE,
+        ACTION_OPEN,        ACTION_CLOSE,        ACTION_MEMORY_RECALL, ACTION_MEMORY_ADD,
+        ACTION_SCROLL_LEFT, ACTION_HISTORY_UP,   ACTION_SCROLL_RIGHT,  ACTION_MEMORY_SUBTRACT,
+        ACTION_NONE,        ACTION_HISTORY_DOWN, ACTION_MEMORY_CLEAR,  ACTION_MEMORY_SLOT,
+        ACTION_NONE,        ACTION_POINT,        ACTION_NONE,          ACTION_MODULO
+    },
+
+    // function layer, held #
+    {
+        ACTION_NONE,
+        ACTION_SQRT, ACTION_POWER, ACTION_RPN,  ACTION_SWAP,
+        ACTION_SIN,  ACTION_COS,   ACTION_TAN,  ACTION_DROP,
+        ACTION_EXP,  ACTION_LN,    ACTION_NONE, ACTION_ROLL,
+        ACTION_NONE, ACTION_BASE,  ACTION_NONE, ACTION_MODE
+    },
+
+    // bitwise layer, held # in place of the function layer while integers are shown in hex, octal, or binary
+    {
+        ACTION_NONE,
+        ACTION_DIGIT_A,    ACTION_DIGIT_B,     ACTION_DIGIT_C, ACTION_AND,
+        ACTION_DIGIT_D,    ACTION_DIGIT_E,     ACTION_DIGIT_F, ACTION_OR,
+        ACTION_SHIFT_LEFT, ACTION_SHIFT_RIGHT, ACTION_NOT,     ACTION_XOR,
+        ACTION_RPN,        ACTION_BASE,        ACTION_NONE,    ACTION_MODE
+    }
+};
+
+// Modifier Table
+// the layer a key selects while it is held, or the base layer if the key is not a modifier
+static const uint8_t keymapHoldLayers[KEYMAP_KEYS + 1] =
+{
+    KEYMAP_LAYER_BASE,
+    KEYMAP_LAYER_BASE,  KEYMAP_LAYER_BASE, KEYMAP_LAYER_BASE, KEYMAP_LAYER_BASE,
+    KEYMAP_LAYER_BASE,  KEYMAP_LAYER_BASE, KEYMAP_LAYER_BASE, KEYMAP_LAYER_BASE,
+    KEYMAP_LAYER_BASE,  KEYMAP_LAYER_BASE, KEYMAP_LAYER_BASE, KEYMAP_LAYER_BASE,
+    KEYMAP_LAYER_SHIFT, KEYMAP_LAYER_BASE, KEYMAP_LAYER_FUNC, KEYMAP_LAYER_BASE
+};
+
+// Long Press Table
+// the action a modifier triggers when it is held past the long press time without another key
+static const uint8_t keymapLongActions[KEYMAP_KEYS + 1] =
+{
+    ACTION_NONE,
+    ACTION_NONE,  ACTION_NONE, ACTION_NONE, ACTION_NONE,
+    ACTION_NONE,  ACTION_NONE, ACTION_NONE, ACTION_NONE,
+    ACTION_NONE,  ACTION_NONE, ACTION_NONE, ACTION_NONE,
+    ACTION_RESET, ACTION_NONE, ACTION_NONE, ACTION_NONE
+};
+
+// Keymap State
+static uint8_t keymapBaseLayer = KEYMAP_LAYER_BASE;
+static uint8_t keymapFuncLayer = KEYMAP_LAYER_FUNC;
+static uint8_t keymapHeldModifier = 0;
+static char keymapModifierUsed = 0;
+
+// Resolves a key event to the action it triggers on the active layer
+// a modifier produces its tap action on release only if no other key or long press used it
+// @ param event - the key event to resolve
+// @ return the action to perform, or ACTION_NONE if the event does nothing on its own
+int keymap_resolve(const key_event_t * event) {
+
+    int key = event->key;
+
+    if (key < 1 || key > KEYMAP_KEYS) {
+        return ACTION_NONE;
+    }
+
+    switch (event->type) {
+
+        case KEY_EVENT_PRESS:
+
+            // the first modifier pressed selects its layer and waits to see whether it is tapped
+            if (keymapHoldLayers[key] != KEYMAP_LAYER_BASE && keymapHeldModifier == 0) {
+                keymapHeldModifier = key;
+                keymapModifierUsed = 0;
+                return ACTION_NONE;
+            }
+
+            // fall through, a press resolves the same way a repeat does
+
+        case KEY_EVENT_REPEAT:
+
+            // no modifier held, resolve on the base layer
+            if (keymapHeldModifier == 0) {
+                return keymapLayers[keymapBaseLayer][key];
+            }
+
+            // a modifier is held, resolve on its layer and use up its tap
+            keymapModifierUsed = 1;
+
+            if (keymapHoldLayers[keymapHeldModifier] == KEYMAP_LAYER_FUNC) {
+                return keymapLayers[keymapFuncLayer][key];
+            }
+
+            return keymapLayers[keymapHoldLayers[keymapHeldModifier]][key];
+
+        case KEY_EVENT_LONG:
+
+            // an unused modifier held long enough triggers its long press action instead of its tap
+            if (key == keymapHeldModifier && !keymapModifierUsed && keymapLongActions[key] != ACTION_NONE) {
+                keymapModifierUsed = 1;
+                return keymapLongActions[key];
+            }
+
+            return ACTION_NONE;
+
+        case KEY_EVENT_RELEASE:
+
+            // releasing an unused modifier is a tap
+            if (key == keymapHeldModifier) {
+                keymapHeldModifier = 0;
+                if (!keymapModifierUsed) {
+                    return keymapLayers[keymapBaseLayer][key];
+                }
+            }
+
+            return ACTION_NONE;
+
+        default:
+            return ACTION_NONE;
+    }
+}
+
+// Selects the layer keys resolve on when no modifier is held
+// @ param layer - the new base layer
+// @ return void
+void keymap_set_base_layer(int layer) {
+    if (layer >= 0 && layer < KEYMAP_LAYERS) {
+        keymapBaseLayer = layer;
+    }
+}
+
+// Gets the layer keys resolve on when no modifier is held
+// @ param void
+// @ return the current base layer
+int keymap_get_base_layer(void) {
+    return keymapBaseLayer;
+}
+
+// Selects the layer keys resolve on while the function modifier is held
+// @ param layer - the new function layer
+// @ return void
+void keymap_set_func_layer(int layer) {
+    if (layer >= 0 && layer < KEYMAP_LAYERS) {
+        keymapFuncLayer = layer;
+    }
+}
+
+// Forgets any modifier that is currently held
+// @ param void
+// @ return void
+void keymap_reset(void) {
+    keymapHeldModifier = 0;
+    keymapModifierUsed = 0;
+}
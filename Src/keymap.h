@@ -0,0 +1,98 @@
+// file: keymap.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for keymap.c
+
+# ifndef KEYMAP_H
+# define KEYMAP_H
+
+# include "keypad_driver.h"
+
+// Keymap Layers
+# define KEYMAP_LAYER_BASE 0
+# define KEYMAP_LAYER_SHIFT 1
+# define KEYMAP_LAYER_FUNC 2
+# define KEYMAP_LAYER_BITS 3
+# define KEYMAP_LAYERS 4
+
+// Keymap Actions
+// the digit actions are contiguous up to ACTION_DIGIT_F so the digit value is (action - ACTION_DIGIT_0),
+// and so are the operator actions from ACTION_ADD to ACTION_SHIFT_RIGHT and the unary function actions
+// from ACTION_SQRT to ACTION_NOT, in the order of the SCI function values and then EXPR_FUNCTION_NOT
+enum keymap_action {
+    ACTION_NONE,
+    ACTION_DIGIT_0,
+    ACTION_DIGIT_1,
+    ACTION_DIGIT_2,
+    ACTION_DIGIT_3,
+    ACTION_DIGIT_4,
+    ACTION_DIGIT_5,
+    ACTION_DIGIT_6,
+    ACTION_DIGIT_7,
+    ACTION_DIGIT_8,
+    ACTION_DIGIT_9,
+    ACTION_DIGIT_A,
+    ACTION_DIGIT_B,
+    ACTION_DIGIT_C,
+    ACTION_DIGIT_D,
+    ACTION_DIGIT_E,
+    ACTION_DIGIT_F,
+    ACTION_ADD,
+    ACTION_SUBTRACT,
+    ACTION_MULTIPLY,
+    ACTION_DIVIDE,
+    ACTION_MODULO,
+    ACTION_POWER,
+    ACTION_AND,
+    ACTION_OR,
+    ACTION_XOR,
+    ACTION_SHIFT_LEFT,
+    ACTION_SHIFT_RIGHT,
+    ACTION_EQUALS,
+    ACTION_CLEAR,
+    ACTION_RESET,
+    ACTION_OPEN,
+    ACTION_CLOSE,
+    ACTION_SCROLL_LEFT,
+    ACTION_SCROLL_RIGHT,
+    ACTION_POINT,
+    ACTION_MODE,
+    ACTION_SQRT,
+    ACTION_SIN,
+    ACTION_COS,
+    ACTION_TAN,
+    ACTION_EXP,
+    ACTION_LN,
+    ACTION_NOT,
+    ACTION_RPN,
+    ACTION_SWAP,
+    ACTION_DROP,
+    ACTION_ROLL,
+    ACTION_HISTORY_UP,
+    ACTION_HISTORY_DOWN,
+    ACTION_MEMORY_ADD,
+    ACTION_MEMORY_SUBTRACT,
+    ACTION_MEMORY_RECALL,
+    ACTION_MEMORY_CLEAR,
+    ACTION_MEMORY_SLOT,
+    ACTION_BASE,
+    ACTION_COUNT
+};
+
+// Resolves a key event to the action it triggers on the active layer
+int keymap_resolve(const key_event_t * event);
+
+// Selects the layer keys resolve on when no modifier is held
+void keymap_set_base_layer(int layer);
+
+// Gets the layer keys resolve on when no modifier is held
+int keymap_get_base_layer(void);
+
+// Selects the layer keys resolve on while the function modifier is held
+void keymap_set_func_layer(int layer);
+
+// Forgets any modifier that is currently held
+void keymap_reset(void);
+
+# endif
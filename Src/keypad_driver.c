@@ -1,21 +1,26 @@
 // file: keypad_driver.c
 // created by: Grant Wilk
 // date created: 1/5/2020
-// last modified: 1/5/2020
+// last modified: 10/16/2026
 // description: Contains functions for driving the keypad on the CE development board
 
 # include <stdint.h>
-# include "delay.h"
 # include "keypad_driver.h"
+# include "latency.h"
+# include "timebase.h"
 # include "lcd_driver.h"
+# include "irq.h"
 
 // RCC Addresses
 # define RCC_BASE 0x40023800
 # define RCC_AHB1ENR (RCC_BASE + 0x30)
+# define RCC_APB1ENR (RCC_BASE + 0x40)
 # define RCC_APB2ENR (RCC_BASE + 0x44)
 
 // RCC Values
 # define RCC_AHB1ENR_GPIOCEN (1 << 2)
+# define RCC_APB1ENR_TIM6EN (1 << 4)
+# define RCC_APB1ENR_PWREN (1 << 28)
 # define RCC_APB2ENR_SYSCFGEN (1 << 14)
 
 // GPIOC Addresses
@@ -24,6 +29,7 @@
 # define GPIOC_PUPDR (GPIOC_BASE + 0x0C)
 # define GPIOC_IDR (GPIOC_BASE + 0x10)
 # define GPIOC_ODR (GPIOC_BASE + 0x14)
+# define GPIOC_BSRR (GPIOC_BASE + 0x18)
 
 // GPIOC Values
 # define GPIOC_COLUMNS 0xFF
@@ -34,6 +40,9 @@
 # define GPIOC_ODR_ROWS 0xF0
 # define GPIOC_PUPDR_COLUMNS_PULLDOWN 0xAA
 # define GPIOC_PUPDR_ROWS_PULLDOWN 0xAA00
+# define GPIOC_IDR_COLUMNS 0x0F
+# define GPIOC_BSRR_ROW_SET(row) (1 << (4 + (row)))
+# define GPIOC_BSRR_ROWS_RESET (GPIOC_ODR_ROWS << 16)
 
 // SYSCFG Addresses
 # define SYSCFG_BASE 0x40013800
@@ -51,20 +60,82 @@
 // EXTI Values
 # define EXTI_0_THRU_4 0x0F
 
-// NVIC Addresses
-# define NVIC_BASE 0xE000E100
-# define NVIC_ISER0 (NVIC_BASE + 0x00)
-# define NVIC_ICER0 (NVIC_BASE + 0x80)
+// TIM6 Addresses
+# define TIM6_BASE 0x40001000
+# define TIM6_CR1 (TIM6_BASE + 0x00)
+# define TIM6_DIER (TIM6_BASE + 0x0C)
+# define TIM6_SR (TIM6_BASE + 0x10)
+# define TIM6_EGR (TIM6_BASE + 0x14)
+# define TIM6_CNT (TIM6_BASE + 0x24)
+# define TIM6_PSC (TIM6_BASE + 0x28)
+# define TIM6_ARR (TIM6_BASE + 0x2C)
 
-// NVIC Values
-# define NVIC_6_THRU_9 (0b1111 << 6)
+// TIM6 Values
+# define TIM_CR1_CEN (1 << 0)
+# define TIM_CR1_URS (1 << 2)
+# define TIM_DIER_UIE (1 << 0)
+# define TIM_SR_UIF (1 << 0)
+# define TIM_EGR_UG (1 << 0)
+# define TIM6_PSC_1MHZ 15
+# define TIM6_TICKS_PER_MS 1000
+
+// PWR Addresses
+# define PWR_BASE 0x40007000
+# define PWR_CR (PWR_BASE + 0x00)
+
+// PWR Values
+# define PWR_CR_LPDS (1 << 0)
+# define PWR_CR_PDDS (1 << 1)
+
+// SCB Addresses
+# define SCB_SCR 0xE000ED10
+
+// SCB Values
+# define SCB_SCR_SLEEPDEEP (1 << 2)
+
+// Keypad Characteristics
+# define KEY_ROWS 4
+# define KEY_COLUMNS 4
+# define KEY_COUNT (KEY_ROWS * KEY_COLUMNS)
+# define KEY_SETTLE_LOOPS 8
+# define KEY_DEBOUNCE_MS_DEFAULT 20
+# define KEY_DEBOUNCE_MS_MAX 255
+# define KEY_SCAN_PERIOD_MS_DEFAULT 1
+# define KEY_SCAN_PERIOD_MS_MAX 50
+# define KEY_ROW_MASK 0xF
+# define KEY_LONG_PRESS_MS_DEFAULT 1000
+# define KEY_REPEAT_DELAY_MS_DEFAULT 500
+# define KEY_REPEAT_RATE_MS_DEFAULT 100
+# define KEY_HOLD_MS_MAX 0xFFFF
+# define KEY_COLUMN_KEYS 0x1111
+# define KEY_BOUNCE_BUCKETS 32
+# define KEY_ADAPT_MIN_SAMPLES 32
+# define KEY_ADAPT_INTERVAL 16
+# define KEY_ADAPT_MARGIN_MS 2
+# define KEY_ADAPT_FLOOR_MS 3
+# define KEY_CHATTER_MS 50
 
 // Register Pointers
 static uint32_t * const gpiocMODER = (uint32_t *) GPIOC_MODER;
 static uint32_t * const gpiocIDR = (uint32_t *) GPIOC_IDR;
+static uint32_t * const gpiocBSRR = (uint32_t *) GPIOC_BSRR;
+static uint32_t * const extiIMR = (uint32_t *) EXTI_IMR;
+static uint32_t * const extiPR = (uint32_t *) EXTI_PR;
+static uint32_t * const tim6CR1 = (uint32_t *) TIM6_CR1;
+static uint32_t * const tim6SR = (uint32_t *) TIM6_SR;
+static uint32_t * const tim6CNT = (uint32_t *) TIM6_CNT;
+static uint32_t * const tim6ARR = (uint32_t *) TIM6_ARR;
 
-// Row Lookup Table
-const static int rowLUT[9] = {0, 0, 1, 1, 2, 2, 2, 2, 3};
+// Debounce States
+// each key walks IDLE -> PRESS -> HOLD -> RELEASE -> IDLE. in PRESS and RELEASE every raw change
+// restarts the window, and once the level has been stable for the whole window the key either
+// moves on or, if it settled back where it started, returns to IDLE or HOLD as a glitch
+enum key_state {
+    KEY_STATE_IDLE,
+    KEY_STATE_PRESS,
+    KEY_STATE_HOLD,
+    KEY_STATE_RELEASE
+};
 
 // Character Lookup Table
 const static char defaultCharLUT[17] =
@@ -79,8 +150,77 @@ const static char defaultCharLUT[17] =
 // Character Lookup Table Pointer
 static char * charLUT = (char *) defaultCharLUT;
 
-// Last Keypress Variable
-static char lastKeypress = 0;
+// Key Event Queue Size (must be a power of two)
+# define KEY_QUEUE_SIZE 64
+# define KEY_QUEUE_MASK (KEY_QUEUE_SIZE - 1)
+
+// Key Event Queue
+// single-producer/single-consumer ring buffer, the head index is only written by the keypad
+// interrupts and the tail index is only written by the consumer, so neither side needs to
+// disable interrupts. the indices run freely and are masked on access so head - tail is always
+// the number of queued events.
+static volatile key_event_t keyQueue[KEY_QUEUE_SIZE];
+static volatile uint32_t keyQueueHead = 0;
+static volatile uint32_t keyQueueTail = 0;
+
+// Key Event Queue Statistics
+static volatile uint32_t keyQueueOverflows = 0;
+static volatile uint32_t keyQueuePeak = 0;
+
+// Debounce State Machine
+// only touched from the keypad interrupts, one state, stable time and transition time per key
+static uint8_t keyState[KEY_COUNT];
+static uint16_t keyTimer[KEY_COUNT];
+static uint16_t keyStateMs[KEY_COUNT];
+static uint16_t keyRaw = 0;
+static uint32_t keyEdgeTime[KEY_COUNT];
+static uint16_t keyHoldMs[KEY_COUNT];
+static int32_t keyRepeatDueMs[KEY_COUNT];
+static uint16_t keyActive = 0;
+static uint16_t keyLongSent = 0;
+static volatile uint16_t keyDown = 0;
+static volatile uint8_t keyDebounceMs = KEY_DEBOUNCE_MS_DEFAULT;
+
+// Bounce Statistics
+// edges are raw level changes per key, bounce is the time from the first edge to the last change
+// before an accepted transition, and spurious edges are column interrupts that found no key
+static volatile char keyInstrument = 0;
+static volatile char keyAdaptive = 0;
+static volatile uint32_t keyEdgeCount[KEY_COUNT];
+static volatile uint32_t keyBounceHistogram[KEY_BOUNCE_BUCKETS];
+static volatile uint32_t keyBounceSamples = 0;
+static volatile uint16_t keyBounceMaxMs = 0;
+static volatile uint32_t keySpuriousCount[KEY_COLUMNS];
+static volatile uint32_t keyGlitchCount = 0;
+static volatile uint32_t keyChatterCount = 0;
+static volatile uint8_t keyEdgeColumns = 0;
+static volatile uint32_t keyColumnEdgeTime[KEY_COLUMNS];
+
+// Hold Behavior
+static volatile uint16_t keyLongPressMs = KEY_LONG_PRESS_MS_DEFAULT;
+static volatile uint16_t keyRepeatDelayMs = KEY_REPEAT_DELAY_MS_DEFAULT;
+static volatile uint16_t keyRepeatRateMs = KEY_REPEAT_RATE_MS_DEFAULT;
+static volatile uint16_t keyRepeatMask = 0;
+
+// Scan Engine
+static volatile int keyScanMode = KEY_SCAN_EDGE;
+static volatile uint8_t keyScanPeriodMs = KEY_SCAN_PERIOD_MS_DEFAULT;
+static volatile uint32_t keyGhostCount = 0;
+static void (* volatile keyTickCallback)(int elapsed) = 0;
+
+// Sleep Statistics
+static volatile int keySleepMode = KEY_SLEEP_WFI;
+static uint32_t keySleepCount = 0;
+static uint32_t keySleepTimeUs = 0;
+static uint32_t keyStopCount = 0;
+
+// Static Function Prototypes
+static void key_timer_init(void);
+static void key_timer_start(void);
+static void key_queue_push(int key, int type, uint32_t time);
+static void key_record_bounce(int milliseconds);
+static void key_record_chatter(void);
+static void key_sleep(uint32_t start, uint32_t timeout);
 
 // Initializes the keypad pins and readies the keypad peripheral for use
 // @ param void
@@ -115,63 +255,156 @@ void key_init(void) {
     * syscfgEXTICR1 |= (SYSCFG_EXTIX_TO_PIN_C << 8);
     * syscfgEXTICR1 |= (SYSCFG_EXTIX_TO_PIN_C << 12);
 
+    // configure the debounce timer
+    key_timer_init();
+
     // unmask EXTI0-EXTI3 in EXTI IMR
-    uint32_t * extiIMR = (uint32_t *) EXTI_IMR;
     * extiIMR |= EXTI_0_THRU_4;
 
     // set interrupts on rising edge for EXTI0-EXTI3 in EXTI RTSR
     uint32_t * extiRTSR = (uint32_t *) EXTI_RTSR;
     * extiRTSR |= EXTI_0_THRU_4;
 
-    // enable interrupt in NVIC
-    uint32_t * nvicISER0 = (uint32_t *) NVIC_ISER0;
-    * nvicISER0 = NVIC_6_THRU_9;
+    // the debounce tick keeps time for every key so it preempts the column interrupts,
+    // which share one level so they never preempt each other and lower columns are served first
+    irq_set_priority(IRQ_TIM6_DAC, IRQ_PRIORITY_TIMING, 0);
+    for (int column = 0; column < KEY_COLUMNS; column++) {
+        irq_set_priority(IRQ_EXTI0 + column, IRQ_PRIORITY_KEYPAD, column);
+    }
+
+    // enable interrupts in NVIC
+    for (int column = 0; column < KEY_COLUMNS; column++) {
+        irq_clear_pending(IRQ_EXTI0 + column);
+        irq_enable(IRQ_EXTI0 + column);
+    }
+    irq_enable(IRQ_TIM6_DAC);
 
-    // clear the last keypress from memory
+    // clear any queued keypresses
     key_clear();
 
 }
 
-// Clears the last key pressed
+// Discards all queued key events
 // @ param void
 // @ return void
 void key_clear(void) {
-	lastKeypress = 0;
+    keyQueueTail = keyQueueHead;
 }
 
-// Blocks program flow and waits for a keypress
+// Blocks program flow until a key event is queued, sleeping between interrupts
 // @ param void
 // @ return void
 void key_wait(void) {
-	key_clear();
-    while (key_get() == 0);
+    while (key_available() == 0) {
+        key_sleep(0, KEY_WAIT_FOREVER);
+    }
+}
+
+// Blocks program flow until a key event is queued or a timeout passes, sleeping between interrupts
+// the TIM2 alarm wakes the core at the deadline, so the wait takes no key to end
+// @ param milliseconds - how long to wait
+// @ return 1 if a key event is queued, or 0 if the timeout passed first
+int key_wait_timeout(uint32_t milliseconds) {
+
+    uint32_t start = timebase_now_us();
+    uint32_t timeout = milliseconds * 1000;
+
+    timebase_set_alarm(start + timeout);
+
+    while (key_available() == 0 && timebase_elapsed_us(start) < timeout) {
+        key_sleep(start, timeout);
+    }
+
+    timebase_cancel_alarm();
+
+    return key_available() != 0;
+}
+
+// Gets the number of key events waiting in the queue
+// @ param void
+// @ return the number of queued events
+int key_available(void) {
+    return (int) (keyQueueHead - keyQueueTail);
+}
+
+// Removes the oldest key event from the queue
+// @ param event - where to store the event
+// @ return 1 if an event was removed, 0 if the queue was empty
+int key_get_event(key_event_t * event) {
+
+    uint32_t tail = keyQueueTail;
+
+    // return 0 if the queue is empty
+    if (tail == keyQueueHead) {
+        return 0;
+    }
+
+    // copy the event before releasing its slot to the producer
+    event->key = keyQueue[tail & KEY_QUEUE_MASK].key;
+    event->type = keyQueue[tail & KEY_QUEUE_MASK].type;
+    event->time = keyQueue[tail & KEY_QUEUE_MASK].time;
+    keyQueueTail = tail + 1;
+
+    // start timing how long this press takes to reach the display
+    if (event->type == KEY_EVENT_PRESS || event->type == KEY_EVENT_REPEAT) {
+        latency_mark_input(event->time);
+    }
+
+    return 1;
 }
 
-// Gets the last key pressed and returns it
+// Blocks program flow, waits for a key event, and removes it from the queue
+// @ param event - where to store the event
+// @ return void
+void key_get_event_wait(key_event_t * event) {
+    while (!key_get_event(event)) {
+        key_wait();
+    }
+}
+
+// Removes queued events up to and including the oldest keypress or repeat and returns it
 // @ param void
-// @ return the last key pressed or 0 if no key was pressed
+// @ return the oldest queued keypress or 0 if no key was pressed
 int key_get(void) {
-	return lastKeypress;
+
+    key_event_t event;
+
+    // skip over release and long press events, repeats count as presses
+    while (key_get_event(&event)) {
+        if (event.type == KEY_EVENT_PRESS || event.type == KEY_EVENT_REPEAT) {
+            return event.key;
+        }
+    }
+
+    return 0;
 }
 
 // Blocks program flow, waits for a keypress, and returns it
 // @ param void
-// @ return the last key pressed
+// @ return the oldest queued keypress
 int key_get_wait(void) {
-    key_wait();
-    return key_get();
+
+    int key;
+
+    // other events wake the wait without producing a keypress, so wait again
+    do {
+        key_wait();
+        key = key_get();
+    } while (key == 0);
+
+    return key;
 }
 
-// Gets the last key pressed, converts it to a character, and returns it
+// Removes the oldest keypress from the queue, converts it to a character, and returns it
 // @ param void
-// @ return the character of the last key pressed or 0 if no key was pressed
+// @ return the character of the oldest queued keypress or 0 if no key was pressed
 char key_get_char(void) {
     return charLUT[key_get()];
 }
 
 // Blocks program flow, waits for a keypress, converts it to a character, and returns it
 // @ param void
-// @ return the last key pressed
+// @ return the character of the oldest queued keypress
 char key_get_char_wait(void) {
     return charLUT[key_get_wait()];
 }
@@ -188,6 +421,24 @@ char key_to_char(int key) {
 	}
 }
 
+// Converts a character to the keypress that produces it
+// @ param c - the character to look up in the current character LUT
+// @ return the number of the keypress, or 0 if no key produces the character
+int key_from_char(char c) {
+
+    if (c == '\0') {
+        return 0;
+    }
+
+    for (int key = 1; key <= KEY_COUNT; key++) {
+        if (charLUT[key] == c) {
+            return key;
+        }
+    }
+
+    return 0;
+}
+
 // Sets a new character LUT for get character functions
 // @ param newCharLUT - the new character LUT, a 17 element character array that begins with a null terminator character
 // @ return void
@@ -195,72 +446,795 @@ void key_set_char_lut(char newCharLUT[]) {
 	charLUT = newCharLUT;
 }
 
-// Handles keypad interrupts
-// @ param column - the column the interrupt occurred on
+// Selects how the core idles while a blocking keypad function waits
+// @ param mode - KEY_SLEEP_NONE to spin, KEY_SLEEP_WFI for sleep mode, KEY_SLEEP_STOP for stop mode
+// @ return void
+void key_set_sleep_mode(int mode) {
+
+    // stop mode needs the PWR registers
+    if (mode == KEY_SLEEP_STOP) {
+        uint32_t * rccAPB1ENR = (uint32_t *) RCC_APB1ENR;
+        * rccAPB1ENR |= RCC_APB1ENR_PWREN;
+    }
+
+    keySleepMode = mode;
+}
+
+// Gets the number of times a blocking keypad function put the core to sleep
+// @ param void
+// @ return the number of sleep and stop mode entries since the last reset
+uint32_t key_get_sleep_count(void) {
+    return keySleepCount;
+}
+
+// Gets the total time spent in sleep mode while waiting for keys
+// TIM2 is halted in stop mode, so time spent in stop mode is not included
+// @ param void
+// @ return the sleep time in microseconds since the last reset
+uint32_t key_get_sleep_time_us(void) {
+    return keySleepTimeUs;
+}
+
+// Gets the number of times a blocking keypad function entered stop mode
+// @ param void
+// @ return the number of stop mode entries since the last reset
+uint32_t key_get_stop_count(void) {
+    return keyStopCount;
+}
+
+// Resets the sleep statistics
+// @ param void
+// @ return void
+void key_reset_sleep_stats(void) {
+    keySleepCount = 0;
+    keySleepTimeUs = 0;
+    keyStopCount = 0;
+}
+
+// Sets how long a key must be held before a long press event is queued
+// @ param milliseconds - the long press threshold, or 0 to disable long press events
+// @ return void
+void key_set_long_press(int milliseconds) {
+    if (milliseconds < 0) milliseconds = 0;
+    if (milliseconds > KEY_HOLD_MS_MAX) milliseconds = KEY_HOLD_MS_MAX;
+    keyLongPressMs = milliseconds;
+}
+
+// Sets the typematic timing of held keys
+// @ param delayMilliseconds - how long a key is held before the first repeat, or 0 to disable repeats
+// @ param rateMilliseconds - the time between repeats after the first, at least 1 ms
+// @ return void
+void key_set_repeat(int delayMilliseconds, int rateMilliseconds) {
+    if (delayMilliseconds < 0) delayMilliseconds = 0;
+    if (delayMilliseconds > KEY_HOLD_MS_MAX) delayMilliseconds = KEY_HOLD_MS_MAX;
+    if (rateMilliseconds < 1) rateMilliseconds = 1;
+    if (rateMilliseconds > KEY_HOLD_MS_MAX) rateMilliseconds = KEY_HOLD_MS_MAX;
+    keyRepeatDelayMs = delayMilliseconds;
+    keyRepeatRateMs = rateMilliseconds;
+}
+
+// Selects which keys repeat while held
+// @ param mask - a bitmap with bit (key - 1) set for every key that should repeat
+// @ return void
+void key_set_repeat_mask(uint16_t mask) {
+    keyRepeatMask = mask;
+}
+
+// Gets the bitmap of keys that are currently held down after debouncing
+// @ param void
+// @ return a bitmap with bit (key - 1) set for every key that is held
+uint16_t key_get_state(void) {
+    return keyDown;
+}
+
+// Selects the engine that decides when the matrix is scanned
+// @ param mode - KEY_SCAN_EDGE to scan only after a column edge, KEY_SCAN_PERIODIC to scan continuously
 // @ return void
-static void key_interrupt_handler(int column) {
+void key_set_scan_mode(int mode) {
 
-    // mask EXTI0-EXTI3 in EXTI IMR
-    uint32_t * extiIMR = (uint32_t *) EXTI_IMR;
+    // stop scanning while the engine is switched
+    * tim6CR1 &= ~TIM_CR1_CEN;
     * extiIMR &= ~(EXTI_0_THRU_4);
 
-    // set rows as inputs and columns as outputs
-    * gpiocMODER &= ~(GPIOC_COLUMNS | GPIOC_ROWS);
-    * gpiocMODER |= (GPIOC_MODER_COLUMNS_OUTPUT);
+    keyScanMode = mode;
+
+    if (mode == KEY_SCAN_PERIODIC) {
+
+        // the timer owns the matrix all the time
+        key_timer_start();
 
-    // delay 40 milliseconds for debouncing
-    delay_ms(40);
+    } else {
 
-    // get the one-hot value of the row
-    int row = (* gpiocIDR >> 4) & 0xF;
+        // hand the keypad back to the EXTI lines and let the timer finish any active keys
+        * extiPR = EXTI_0_THRU_4;
+        * extiIMR |= EXTI_0_THRU_4;
+        if (keyActive != 0) {
+            * extiIMR &= ~(EXTI_0_THRU_4);
+            key_timer_start();
+        }
+    }
+}
 
-    // if a key is still pressed and the keypress is in a valid position
-    if (row > 0 && row <= 9) {
+// Sets how often the matrix is scanned while the timer is running
+// @ param milliseconds - the scan period, clamped to 1-50 ms
+// @ return void
+void key_set_scan_period(int milliseconds) {
+    if (milliseconds < 1) milliseconds = 1;
+    if (milliseconds > KEY_SCAN_PERIOD_MS_MAX) milliseconds = KEY_SCAN_PERIOD_MS_MAX;
+    keyScanPeriodMs = milliseconds;
+    * tim6ARR = milliseconds * TIM6_TICKS_PER_MS - 1;
+}
 
-        // get the actual value of the row from the LUT
-        row = rowLUT[row];
+// Gets the number of scans that saw an ambiguous key combination
+// @ param void
+// @ return the ghost count since the last reset
+uint32_t key_get_ghost_count(void) {
+    return keyGhostCount;
+}
 
-        // update the last keypress variable
-        lastKeypress = row * 4 + column + 1;
+// Gets the number of key events dropped because the queue was full
+// @ param void
+// @ return the overflow count since the last reset
+uint32_t key_get_overflow_count(void) {
+    return keyQueueOverflows;
+}
+
+// Gets the deepest the key event queue has been
+// @ param void
+// @ return the peak number of queued events since the last reset
+uint32_t key_get_queue_peak(void) {
+    return keyQueuePeak;
+}
+
+// Resets the key event queue and ghosting statistics
+// @ param void
+// @ return void
+void key_reset_queue_stats(void) {
+    keyQueueOverflows = 0;
+    keyQueuePeak = 0;
+    keyGhostCount = 0;
+}
+
+// Adds a synthetic key event to the queue as if it came from the keypad
+// interrupts are masked for the push so it is safe from the main loop and from the tick callback
+// @ param key - the number of the key, 1-16
+// @ param type - the type of the event
+// @ return void
+void key_inject(int key, int type) {
+
+    if (key < 1 || key > KEY_COUNT) {
+        return;
     }
 
-    // set rows as outputs and columns as inputs
-    * gpiocMODER &= ~(GPIOC_COLUMNS | GPIOC_ROWS);
-    * gpiocMODER |= (GPIOC_MODER_ROWS_OUTPUT);
+    uint32_t mask = irq_mask();
 
-    // clear the pending interrupt
-    uint32_t * extiPR = (uint32_t *) EXTI_PR;
-    * extiPR = (1 << column);
+    key_queue_push(key, type, timebase_now_us());
 
-    // unmask EXTI0-EXTI3 in EXTI IMR
+    irq_restore(mask);
+}
+
+// Registers a function to be called from the keypad timer once per scan period
+// the timer and the matrix scan keep running for as long as a callback is registered
+// @ param callback - the function to call with the elapsed milliseconds, or 0 to remove it
+// @ return void
+void key_set_tick_callback(void (* callback)(int elapsed)) {
+
+    keyTickCallback = callback;
+
+    if (callback != 0) {
+        * extiIMR &= ~(EXTI_0_THRU_4);
+        key_timer_start();
+    }
+}
+
+// Adds a key event to the queue, must only be called from the keypad interrupt context
+// @ param key - the number of the key
+// @ param type - the type of the event
+// @ param time - the timebase value when the key first changed
+// @ return void
+static void key_queue_push(int key, int type, uint32_t time) {
+
+    uint32_t head = keyQueueHead;
+    uint32_t depth = head - keyQueueTail;
+
+    // drop the event and count it if the queue is full
+    if (depth >= KEY_QUEUE_SIZE) {
+        keyQueueOverflows++;
+        return;
+    }
+
+    // write the event before publishing it to the consumer
+    keyQueue[head & KEY_QUEUE_MASK].key = key;
+    keyQueue[head & KEY_QUEUE_MASK].type = type;
+    keyQueue[head & KEY_QUEUE_MASK].time = time;
+    keyQueueHead = head + 1;
+
+    // track the high water mark
+    if (depth + 1 > keyQueuePeak) {
+        keyQueuePeak = depth + 1;
+    }
+}
+
+// Sets how long a key must read stable before a press or release is accepted
+// @ param milliseconds - the debounce window, clamped to 1-255 ms
+// @ return void
+void key_set_debounce(int milliseconds) {
+    if (milliseconds < 1) milliseconds = 1;
+    if (milliseconds > KEY_DEBOUNCE_MS_MAX) milliseconds = KEY_DEBOUNCE_MS_MAX;
+    keyDebounceMs = milliseconds;
+}
+
+// Gets the current debounce window
+// @ param void
+// @ return the debounce window in milliseconds
+int key_get_debounce(void) {
+    return keyDebounceMs;
+}
+
+// Enables or disables collection of bounce and noise statistics
+// @ param enable - 1 to collect statistics, 0 to stop
+// @ return void
+void key_set_instrumentation(int enable) {
+    keyInstrument = (enable != 0);
+}
+
+// Enables or disables tuning the debounce window from the bounce statistics
+// the window is shortened to the 99th percentile bounce plus a margin once enough presses have
+// been seen, and lengthened by a millisecond whenever a key bounces open and closed again right
+// after its press was accepted
+// @ param enable - 1 to adapt the window, 0 to leave it fixed
+// @ return void
+void key_set_adaptive_debounce(int enable) {
+    keyAdaptive = (enable != 0);
+    if (enable) {
+        keyInstrument = 1;
+    }
+}
+
+// Gets the number of raw level changes seen on a key
+// @ param key - the number of the key, 1-16
+// @ return the edge count since the last reset, or 0 for an invalid key
+uint32_t key_get_edge_count(int key) {
+    return (key >= 1 && key <= KEY_COUNT) ? keyEdgeCount[key - 1] : 0;
+}
+
+// Gets one bucket of the bounce duration histogram
+// @ param milliseconds - the bucket, 0-31, where the last bucket also counts anything longer
+// @ return the number of transitions whose bounce fell in the bucket
+uint32_t key_get_bounce_histogram(int milliseconds) {
+    return (milliseconds >= 0 && milliseconds < KEY_BOUNCE_BUCKETS) ? keyBounceHistogram[milliseconds] : 0;
+}
+
+// Gets the longest bounce seen on any key
+// @ param void
+// @ return the longest bounce in milliseconds since the last reset
+int key_get_max_bounce(void) {
+    return keyBounceMaxMs;
+}
+
+// Gets the number of column interrupts that found no key pressed in that column
+// @ param column - the column, 0-3
+// @ return the spurious edge count since the last reset
+uint32_t key_get_spurious_count(int column) {
+    return (column >= 0 && column < KEY_COLUMNS) ? keySpuriousCount[column] : 0;
+}
+
+// Gets the number of transitions that settled back to where they started
+// @ param void
+// @ return the glitch count since the last reset
+uint32_t key_get_glitch_count(void) {
+    return keyGlitchCount;
+}
+
+// Resets the bounce and noise statistics
+// @ param void
+// @ return void
+void key_reset_bounce_stats(void) {
+
+    for (int i = 0; i < KEY_COUNT; i++) {
+        keyEdgeCount[i] = 0;
+    }
+
+    for (int i = 0; i < KEY_BOUNCE_BUCKETS; i++) {
+        keyBounceHistogram[i] = 0;
+    }
+
+    for (int i = 0; i < KEY_COLUMNS; i++) {
+        keySpuriousCount[i] = 0;
+    }
+
+    keyBounceSamples = 0;
+    keyBounceMaxMs = 0;
+    keyGlitchCount = 0;
+    keyChatterCount = 0;
+}
+
+// Records the bounce duration of an accepted transition and retunes the window if adapting
+// @ param milliseconds - the time from the first edge to the last change
+// @ return void
+static void key_record_bounce(int milliseconds) {
+
+    if (!keyInstrument) {
+        return;
+    }
+
+    keyBounceHistogram[(milliseconds < KEY_BOUNCE_BUCKETS) ? milliseconds : KEY_BOUNCE_BUCKETS - 1]++;
+    keyBounceSamples++;
+
+    if (milliseconds > keyBounceMaxMs) {
+        keyBounceMaxMs = milliseconds;
+    }
+
+    // retune every so often once there are enough samples to trust
+    if (!keyAdaptive || keyBounceSamples < KEY_ADAPT_MIN_SAMPLES || (keyBounceSamples % KEY_ADAPT_INTERVAL) != 0) {
+        return;
+    }
+
+    // find the 99th percentile bounce
+    uint32_t rank = (keyBounceSamples * 99 + 99) / 100;
+    uint32_t seen = 0;
+    int p99 = KEY_BOUNCE_BUCKETS - 1;
+
+    for (int i = 0; i < KEY_BOUNCE_BUCKETS; i++) {
+        seen += keyBounceHistogram[i];
+        if (seen >= rank) {
+            p99 = i;
+            break;
+        }
+    }
+
+    // the window has to outlast the bounce with some margin, plus a millisecond for every recent
+    // chatter. the chatter is halved on every retune, so once the keys stop chattering the window
+    // falls back to what the bounce alone needs
+    int window = p99 + 1 + KEY_ADAPT_MARGIN_MS + keyChatterCount;
+    keyChatterCount >>= 1;
+    if (window < KEY_ADAPT_FLOOR_MS) window = KEY_ADAPT_FLOOR_MS;
+    if (window > KEY_DEBOUNCE_MS_MAX) window = KEY_DEBOUNCE_MS_MAX;
+    keyDebounceMs = window;
+}
+
+// Records a key that bounced open and closed again soon after its press and widens the window if adapting
+// @ param void
+// @ return void
+static void key_record_chatter(void) {
+
+    if (!keyAdaptive) {
+        return;
+    }
+
+    keyChatterCount++;
+
+    if (keyDebounceMs < KEY_DEBOUNCE_MS_MAX) {
+        keyDebounceMs++;
+    }
+}
+
+// Configures TIM6 as a 1 ms tick for the debounce state machine, the timer is left stopped
+// @ param void
+// @ return void
+static void key_timer_init(void) {
+
+    // enable TIM6 in RCC
+    uint32_t * rccAPB1ENR = (uint32_t *) RCC_APB1ENR;
+    * rccAPB1ENR |= RCC_APB1ENR_TIM6EN;
+
+    // count at 1 MHz from the 16 MHz timer clock and overflow once per scan period
+    uint32_t * tim6PSC = (uint32_t *) TIM6_PSC;
+    * tim6PSC = TIM6_PSC_1MHZ;
+    * tim6ARR = keyScanPeriodMs * TIM6_TICKS_PER_MS - 1;
+
+    // only overflows raise the update flag, then load the prescaler
+    * tim6CR1 = TIM_CR1_URS;
+    uint32_t * tim6EGR = (uint32_t *) TIM6_EGR;
+    * tim6EGR = TIM_EGR_UG;
+
+    // enable the update interrupt
+    uint32_t * tim6DIER = (uint32_t *) TIM6_DIER;
+    * tim6DIER = TIM_DIER_UIE;
+}
+
+// Starts the debounce timer from a full scan period if it is not already running
+// @ param void
+// @ return void
+static void key_timer_start(void) {
+    if (!(* tim6CR1 & TIM_CR1_CEN)) {
+        * tim6CNT = 0;
+        * tim6CR1 |= TIM_CR1_CEN;
+    }
+}
+
+// Idles the core until the next interrupt if no key event is queued and the wait has time left
+// interrupts are masked around the checks so an event or alarm between the checks and the WFI
+// still wakes the core, and its handler runs as soon as they are unmasked again
+// @ param start - when the wait began, from timebase_now_us
+// @ param timeout - how long the wait may last in microseconds, or KEY_WAIT_FOREVER
+// @ return void
+static void key_sleep(uint32_t start, uint32_t timeout) {
+
+    if (keySleepMode == KEY_SLEEP_NONE) {
+        return;
+    }
+
+    uint32_t * scbSCR = (uint32_t *) SCB_SCR;
+
+    uint32_t mask = irq_mask();
+
+    if (key_available() == 0 && (timeout == KEY_WAIT_FOREVER || timebase_elapsed_us(start) < timeout)) {
+
+        // stop mode halts TIM6 and the TIM2 alarm too, so it is only safe while the keypad waits for
+        // an EXTI edge with no deadline
+        int stop = (keySleepMode == KEY_SLEEP_STOP) && (keyScanMode == KEY_SCAN_EDGE) && !(* tim6CR1 & TIM_CR1_CEN) &&
+                   timeout == KEY_WAIT_FOREVER;
+
+        if (stop) {
+
+            // enter stop mode with the low power regulator, the system restarts on HSI when woken
+            uint32_t * pwrCR = (uint32_t *) PWR_CR;
+            * pwrCR = (* pwrCR & ~PWR_CR_PDDS) | PWR_CR_LPDS;
+            * scbSCR |= SCB_SCR_SLEEPDEEP;
+            irq_wait();
+            * scbSCR &= ~SCB_SCR_SLEEPDEEP;
+            keyStopCount++;
+
+        } else {
+
+            // enter sleep mode, peripherals and TIM2 keep running
+            uint32_t start = timebase_now_us();
+            irq_wait();
+            keySleepTimeUs += timebase_elapsed_us(start);
+        }
+
+        keySleepCount++;
+    }
+
+    irq_restore(mask);
+}
+
+// Waits for the keypad lines to settle after changing the driven row
+// @ param void
+// @ return void
+static void key_settle(void) {
+    for (volatile int i = 0; i < KEY_SETTLE_LOOPS; i++);
+}
+
+// Scans the whole keypad by driving one row at a time and reading the columns
+// @ param void
+// @ return a bitmap with bit (row * 4 + column) set for every key that reads pressed
+static uint16_t key_scan_matrix(void) {
+
+    uint16_t pressed = 0;
+
+    for (int row = 0; row < KEY_ROWS; row++) {
+
+        // drive only the current row high
+        * gpiocBSRR = GPIOC_BSRR_ROWS_RESET | GPIOC_BSRR_ROW_SET(row);
+        key_settle();
+
+        // any column that reads high is connected to this row
+        pressed |= (* gpiocIDR & GPIOC_IDR_COLUMNS) << (row * KEY_COLUMNS);
+    }
+
+    // drive every row high again so any press raises a column edge
+    * gpiocBSRR = GPIOC_ODR_ROWS;
+    key_settle();
+
+    return pressed;
+}
+
+// Finds keys whose readings cannot be trusted because of ghosting
+// without diodes, three held corners of a row/column rectangle make the fourth corner read
+// pressed too, so any two rows that share two or more pressed columns are ambiguous
+// @ param pressed - the bitmap of keys that currently read pressed
+// @ return a bitmap of every key on an ambiguous rectangle
+static uint16_t key_find_ghosts(uint16_t pressed) {
+
+    uint16_t ghosts = 0;
+
+    for (int a = 0; a < KEY_ROWS - 1; a++) {
+
+        int rowA = (pressed >> (a * KEY_COLUMNS)) & KEY_ROW_MASK;
+
+        for (int b = a + 1; b < KEY_ROWS; b++) {
+
+            int shared = rowA & (pressed >> (b * KEY_COLUMNS)) & KEY_ROW_MASK;
+
+            // two or more shared columns means a rectangle
+            if (shared & (shared - 1)) {
+                ghosts |= (shared << (a * KEY_COLUMNS)) | (shared << (b * KEY_COLUMNS));
+            }
+        }
+    }
+
+    return ghosts;
+}
+
+// Queues long press and repeat events for a key that has been held for another scan period
+// @ param i - the zero-based index of the key
+// @ param elapsed - the milliseconds since the last step
+// @ return void
+static void key_hold_step(int i, int elapsed) {
+
+    uint16_t bit = (1 << i);
+
+    // time the hold, saturating instead of wrapping
+    if (keyHoldMs[i] > KEY_HOLD_MS_MAX - elapsed) {
+        keyHoldMs[i] = KEY_HOLD_MS_MAX;
+    } else {
+        keyHoldMs[i] += elapsed;
+    }
+
+    // a long press fires once per hold
+    if (keyLongPressMs != 0 && !(keyLongSent & bit) && keyHoldMs[i] >= keyLongPressMs) {
+        keyLongSent |= bit;
+        key_queue_push(i + 1, KEY_EVENT_LONG, timebase_now_us());
+    }
+
+    // repeats fire after the initial delay and then at the repeat rate
+    if (keyRepeatDelayMs != 0 && (keyRepeatMask & bit)) {
+        keyRepeatDueMs[i] -= elapsed;
+        if (keyRepeatDueMs[i] <= 0) {
+            keyRepeatDueMs[i] += keyRepeatRateMs;
+            key_queue_push(i + 1, KEY_EVENT_REPEAT, timebase_now_us());
+        }
+    }
+}
+
+// Advances the debounce state machine of every key by one scan period
+// @ param pressed - the bitmap of keys that currently read pressed
+// @ return void
+static void key_debounce_step(uint16_t pressed) {
+
+    // keys on a ghost rectangle keep their debounced level until the combination clears
+    uint16_t ghosts = key_find_ghosts(pressed);
+    if (ghosts != 0) {
+        keyGhostCount++;
+        pressed = (pressed & ~ghosts) | (keyDown & ghosts);
+    }
+
+    // find the keys whose raw level changed since the last scan
+    uint16_t changed = pressed ^ keyRaw;
+    keyRaw = pressed;
+
+    // count edges per key
+    if (keyInstrument) {
+        for (int i = 0; changed >> i; i++) {
+            if ((changed >> i) & 1) {
+                keyEdgeCount[i]++;
+            }
+        }
+    }
+
+    // only keys that are pressed or mid-transition need work
+    uint16_t pending = pressed | keyActive;
+    int elapsed = keyScanPeriodMs;
+
+    for (int i = 0; pending != 0; i++, pending >>= 1) {
+
+        if (!(pending & 1)) continue;
+
+        int down = (pressed >> i) & 1;
+        int toggled = (changed >> i) & 1;
+
+        switch (keyState[i]) {
+
+            // a new edge, start timing the press from the column interrupt that reported it, or
+            // from this scan if the timer was already scanning and no interrupt was taken
+            case KEY_STATE_IDLE:
+                keyState[i] = KEY_STATE_PRESS;
+                keyTimer[i] = 0;
+                keyStateMs[i] = 0;
+                if (keyEdgeColumns & (1 << (i % KEY_COLUMNS))) {
+                    keyEdgeTime[i] = keyColumnEdgeTime[i % KEY_COLUMNS];
+                } else {
+                    keyEdgeTime[i] = timebase_now_us();
+                }
+                break;
+
+            // accept the press once the key has read pressed for the whole window
+            case KEY_STATE_PRESS:
+
+                keyStateMs[i] += elapsed;
+
+                // any change restarts the window
+                if (toggled) {
+                    keyTimer[i] = 0;
+                    break;
+                }
+
+                if ((keyTimer[i] += elapsed) < keyDebounceMs) {
+                    break;
+                }
+
+                // settled released again, it was only noise
+                if (!down) {
+                    keyState[i] = KEY_STATE_IDLE;
+                    keyGlitchCount++;
+                    break;
+                }
+
+                keyState[i] = KEY_STATE_HOLD;
+                keyDown |= (1 << i);
+                keyHoldMs[i] = 0;
+                keyRepeatDueMs[i] = keyRepeatDelayMs;
+                keyLongSent &= ~(1 << i);
+                key_queue_push(i + 1, KEY_EVENT_PRESS, keyEdgeTime[i]);
+                key_record_bounce(keyStateMs[i] - keyTimer[i]);
+                break;
+
+            // time the hold until the key lets go
+            case KEY_STATE_HOLD:
+                if (!down) {
+                    keyState[i] = KEY_STATE_RELEASE;
+                    keyTimer[i] = 0;
+                    keyStateMs[i] = 0;
+                    keyEdgeTime[i] = timebase_now_us();
+                } else {
+                    key_hold_step(i, elapsed);
+                }
+                break;
+
+            // accept the release once the key has read released for the whole window
+            case KEY_STATE_RELEASE:
+
+                keyStateMs[i] += elapsed;
+
+                // any change restarts the window
+                if (toggled) {
+                    keyTimer[i] = 0;
+                    break;
+                }
+
+                if ((keyTimer[i] += elapsed) < keyDebounceMs) {
+                    break;
+                }
+
+                // settled pressed again, the key never really let go. right after the press was
+                // accepted that is the tail of its bounce, which the window only just outlasted
+                if (down) {
+                    keyState[i] = KEY_STATE_HOLD;
+                    keyGlitchCount++;
+                    if (keyHoldMs[i] < KEY_CHATTER_MS) {
+                        key_record_chatter();
+                    }
+                    break;
+                }
+
+                keyState[i] = KEY_STATE_IDLE;
+                keyDown &= ~(1 << i);
+                key_queue_push(i + 1, KEY_EVENT_RELEASE, keyEdgeTime[i]);
+                key_record_bounce(keyStateMs[i] - keyTimer[i]);
+                break;
+
+            default:
+                keyState[i] = KEY_STATE_IDLE;
+                break;
+        }
+
+        // keep track of which keys still need the timer
+        if (keyState[i] == KEY_STATE_IDLE) {
+            keyActive &= ~(1 << i);
+        } else {
+            keyActive |= (1 << i);
+        }
+    }
+}
+
+// Handles keypad interrupts by handing the matrix to the debounce timer
+// @ param void
+// @ return void
+static void key_interrupt_handler(void) {
+
+    // the edge is stamped here rather than at the first scan, a full scan period later
+    uint32_t now = timebase_now_us();
+
+    // service every column that is pending, not just the one whose vector fired, so two
+    // columns pressed together are both recorded in one pass
+    uint32_t pending = * extiPR & EXTI_0_THRU_4;
+
+    // a vector left over from a column already serviced has nothing to do
+    if (pending == 0) {
+        return;
+    }
+
+    // mask EXTI0-EXTI3 in EXTI IMR, the timer scans every key until they are all released
+    * extiIMR &= ~(EXTI_0_THRU_4);
+
+    // remember when and which columns fired so the first scan can check they were real presses
+    // and time them from their edges
+    for (int column = 0; column < KEY_COLUMNS; column++) {
+        if (pending & (1 << column)) {
+            keyColumnEdgeTime[column] = now;
+        }
+    }
+    keyEdgeColumns |= pending;
+
+    // clear only the lines being serviced, writing a one clears a pending bit
+    * extiPR = pending;
+
+    // the other columns were handled here too, so drop their queued vectors
+    for (int column = 0; column < KEY_COLUMNS; column++) {
+        if (pending & (1 << column)) {
+            irq_clear_pending(IRQ_EXTI0 + column);
+        }
+    }
+
+    // start the debounce timer from a full tick
+    key_timer_start();
+
+}
+
+// Debounce timer interrupt handler
+// @ param void
+// @ return void
+void TIM6_DAC_IRQHandler(void) {
+
+    // clear the update flag
+    * tim6SR &= ~TIM_SR_UIF;
+
+    // scan the matrix and step every key
+    uint16_t pressed = key_scan_matrix();
+    key_debounce_step(pressed);
+
+    // count column interrupts that were not backed by any pressed key in that column
+    if (keyEdgeColumns != 0) {
+        for (int column = 0; column < KEY_COLUMNS; column++) {
+            if (keyInstrument && (keyEdgeColumns & (1 << column)) && !(pressed & (KEY_COLUMN_KEYS << column))) {
+                keySpuriousCount[column]++;
+            }
+        }
+        keyEdgeColumns = 0;
+    }
+
+    // run the tick callback, if there is one
+    void (* callback)(int elapsed) = keyTickCallback;
+    if (callback != 0) {
+        callback(keyScanPeriodMs);
+    }
+
+    // keep the timer running while any key is pressed or settling, while a callback needs ticks,
+    // or for good in periodic mode
+    if (keyActive != 0 || keyTickCallback != 0 || keyScanMode == KEY_SCAN_PERIODIC) {
+        return;
+    }
+
+    // hand the keypad back to the EXTI lines
+    * extiPR = EXTI_0_THRU_4;
     * extiIMR |= EXTI_0_THRU_4;
 
+    // a key pressed between the last scan and the unmask raised no edge, so check the columns
+    if (* gpiocIDR & GPIOC_IDR_COLUMNS) {
+        * extiIMR &= ~(EXTI_0_THRU_4);
+        return;
+    }
+
+    // stop the timer until the next edge
+    * tim6CR1 &= ~TIM_CR1_CEN;
 }
 
 // Keypad column 0 interrupt handler
 // @ param void
 // @ return void
 void EXTI0_IRQHandler(void) {
-	key_interrupt_handler(0);
+	key_interrupt_handler();
 }
 
 // Keypad column 1 interrupt handler
 // @ param void
 // @ return void
 void EXTI1_IRQHandler(void) {
-	key_interrupt_handler(1);
+	key_interrupt_handler();
 }
 
 // Keypad column 2 interrupt handler
 // @ param void
 // @ return void
 void EXTI2_IRQHandler(void) {
-	key_interrupt_handler(2);
+	key_interrupt_handler();
 }
 
 // Keypad column 3 interrupt handler
 // @ param void
 // @ return void
 void EXTI3_IRQHandler(void) {
-	key_interrupt_handler(3);
+	key_interrupt_handler();
 }
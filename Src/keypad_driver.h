@@ -1,25 +1,67 @@
 // file: keypad_driver.h
 // created by: Grant Wilk
 // date created: 1/5/2020
-// last modified: 1/5/2020
+// last modified: 10/16/2026
 // description: Header file for keypad_driver.c
 
+# ifndef KEYPAD_DRIVER_H
+# define KEYPAD_DRIVER_H
+
+# include <stdint.h>
+
+// Key Event Types
+# define KEY_EVENT_PRESS 1
+# define KEY_EVENT_RELEASE 2
+# define KEY_EVENT_LONG 3
+# define KEY_EVENT_REPEAT 4
+
+// Scan Modes
+# define KEY_SCAN_EDGE 0
+# define KEY_SCAN_PERIODIC 1
+
+// Sleep Modes
+# define KEY_SLEEP_NONE 0
+# define KEY_SLEEP_WFI 1
+# define KEY_SLEEP_STOP 2
+
+// Wait Timeouts
+# define KEY_WAIT_FOREVER 0xFFFFFFFF
+
+// A debounced change of a single key, stamped with the timebase value of its first edge
+typedef struct {
+    uint8_t key;
+    uint8_t type;
+    uint32_t time;
+} key_event_t;
+
 // Initializes the keypad pins and readies the keypad peripheral for use
 void key_init(void);
 
-// Clears the last key pressed
+// Discards all queued key events
 void key_clear(void);
 
-// Blocks program flow and waits for a keypress
+// Blocks program flow until a key event is queued, sleeping between interrupts
 void key_wait(void);
 
-// Gets the last key pressed and returns it
+// Blocks program flow until a key event is queued or a timeout passes, sleeping between interrupts
+int key_wait_timeout(uint32_t milliseconds);
+
+// Gets the number of key events waiting in the queue
+int key_available(void);
+
+// Removes the oldest key event from the queue
+int key_get_event(key_event_t * event);
+
+// Blocks program flow, waits for a key event, and removes it from the queue
+void key_get_event_wait(key_event_t * event);
+
+// Removes queued events up to and including the oldest keypress or repeat and returns it
 int key_get(void);
 
 // Blocks program flow, waits for a keypress, and returns it
 int key_get_wait(void);
 
-// Gets the last key pressed, converts it to a character, and returns it
+// Removes the oldest keypress from the queue, converts it to a character, and returns it
 char key_get_char(void);
 
 // Blocks program flow, waits for a keypress, converts it to a character, and returns it
@@ -28,5 +70,91 @@ char key_get_char_wait(void);
 // Converts a keypress to a character and returns it
 char key_to_char(int key);
 
+// Converts a character to the keypress that produces it
+int key_from_char(char c);
+
 // Sets a new character LUT for get character functions
 void key_set_char_lut(char * newCharLUT);
+
+// Gets the number of key events dropped because the queue was full
+uint32_t key_get_overflow_count(void);
+
+// Gets the deepest the key event queue has been
+uint32_t key_get_queue_peak(void);
+
+// Resets the key event queue and ghosting statistics
+void key_reset_queue_stats(void);
+
+// Sets how long a key must read stable before a press or release is accepted
+void key_set_debounce(int milliseconds);
+
+// Gets the current debounce window
+int key_get_debounce(void);
+
+// Gets the bitmap of keys that are currently held down after debouncing
+uint16_t key_get_state(void);
+
+// Selects the engine that decides when the matrix is scanned
+void key_set_scan_mode(int mode);
+
+// Sets how often the matrix is scanned while the timer is running
+void key_set_scan_period(int milliseconds);
+
+// Gets the number of scans that saw an ambiguous key combination
+uint32_t key_get_ghost_count(void);
+
+// Selects how the core idles while a blocking keypad function waits
+void key_set_sleep_mode(int mode);
+
+// Gets the number of times a blocking keypad function put the core to sleep
+uint32_t key_get_sleep_count(void);
+
+// Gets the total time spent in sleep mode while waiting for keys
+uint32_t key_get_sleep_time_us(void);
+
+// Gets the number of times a blocking keypad function entered stop mode
+uint32_t key_get_stop_count(void);
+
+// Resets the sleep statistics
+void key_reset_sleep_stats(void);
+
+// Sets how long a key must be held before a long press event is queued
+void key_set_long_press(int milliseconds);
+
+// Sets the typematic timing of held keys
+void key_set_repeat(int delayMilliseconds, int rateMilliseconds);
+
+// Selects which keys repeat while held
+void key_set_repeat_mask(uint16_t mask);
+
+// Adds a synthetic key event to the queue as if it came from the keypad
+void key_inject(int key, int type);
+
+// Registers a function to be called from the keypad timer once per scan period
+void key_set_tick_callback(void (* callback)(int elapsed));
+
+// Enables or disables collection of bounce and noise statistics
+void key_set_instrumentation(int enable);
+
+// Enables or disables tuning the debounce window from the bounce statistics
+void key_set_adaptive_debounce(int enable);
+
+// Gets the number of raw level changes seen on a key
+uint32_t key_get_edge_count(int key);
+
+// Gets one bucket of the bounce duration histogram
+uint32_t key_get_bounce_histogram(int milliseconds);
+
+// Gets the longest bounce seen on any key
+int key_get_max_bounce(void);
+
+// Gets the number of column interrupts that found no key pressed in that column
+uint32_t key_get_spurious_count(int column);
+
+// Gets the number of transitions that settled back to where they started
+uint32_t key_get_glitch_count(void);
+
+// Resets the bounce and noise statistics
+void key_reset_bounce_stats(void);
+
+# endif
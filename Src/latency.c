@@ -0,0 +1,111 @@
+// file: latency.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a histogram of the time from a key being pressed to its character appearing on the LCD
+
+# include <stdint.h>
+# include "latency.h"
+# include "timebase.h"
+
+// Histogram Characteristics
+# define LATENCY_BUCKETS 128
+# define LATENCY_BUCKET_US 500
+
+// Latency Histogram
+// each bucket counts samples in a 500 us slice, the last bucket also holds everything above 64 ms
+static uint32_t latencyHistogram[LATENCY_BUCKETS];
+static uint32_t latencyCount = 0;
+static uint32_t latencyMaxUs = 0;
+
+// Pending Keypress
+static uint32_t latencyInputTime = 0;
+static char latencyInputPending = 0;
+
+// Static Function Prototypes
+static uint32_t latency_percentile(uint32_t percent);
+
+// Records the timestamp of a keypress that is about to be handled
+// a newer keypress replaces one that never produced any output
+// @ param time - the timebase value of the keypress
+// @ return void
+void latency_mark_input(uint32_t time) {
+    latencyInputTime = time;
+    latencyInputPending = 1;
+}
+
+// Records that a character has finished being written to the display
+// only the first character after a keypress is counted
+// @ param void
+// @ return void
+void latency_mark_output(void) {
+
+    if (!latencyInputPending) {
+        return;
+    }
+
+    latencyInputPending = 0;
+
+    uint32_t elapsed = timebase_elapsed_us(latencyInputTime);
+    uint32_t bucket = elapsed / LATENCY_BUCKET_US;
+
+    if (bucket >= LATENCY_BUCKETS) {
+        bucket = LATENCY_BUCKETS - 1;
+    }
+
+    latencyHistogram[bucket]++;
+    latencyCount++;
+
+    if (elapsed > latencyMaxUs) {
+        latencyMaxUs = elapsed;
+    }
+}
+
+// Gets a summary of the recorded keypress-to-display latencies
+// percentiles are the upper edge of the bucket they fall in, the maximum is exact
+// @ param stats - where to store the summary
+// @ return void
+void latency_get_stats(latency_stats_t * stats) {
+    stats->count = latencyCount;
+    stats->p50Us = latency_percentile(50);
+    stats->p99Us = latency_percentile(99);
+    stats->maxUs = latencyMaxUs;
+}
+
+// Discards every recorded latency
+// @ param void
+// @ return void
+void latency_reset(void) {
+
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        latencyHistogram[i] = 0;
+    }
+
+    latencyCount = 0;
+    latencyMaxUs = 0;
+    latencyInputPending = 0;
+}
+
+// Finds the latency below which a given share of the samples fall
+// @ param percent - the percentile to find, 1-100
+// @ return the percentile in microseconds, or 0 if nothing has been recorded
+static uint32_t latency_percentile(uint32_t percent) {
+
+    if (latencyCount == 0) {
+        return 0;
+    }
+
+    // the rank of the sample we are looking for, rounded up
+    uint32_t rank = (latencyCount * percent + 99) / 100;
+    uint32_t seen = 0;
+
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += latencyHistogram[i];
+        if (seen >= rank) {
+            uint32_t edge = (i + 1) * LATENCY_BUCKET_US;
+            return (edge < latencyMaxUs) ? edge : latencyMaxUs;
+        }
+    }
+
+    return latencyMaxUs;
+}
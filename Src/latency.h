@@ -0,0 +1,32 @@
+// file: latency.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for latency.c
+
+# ifndef LATENCY_H
+# define LATENCY_H
+
+# include <stdint.h>
+
+// Keypress-to-display latency summary
+typedef struct {
+    uint32_t count;
+    uint32_t p50Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+} latency_stats_t;
+
+// Records the timestamp of a keypress that is about to be handled
+void latency_mark_input(uint32_t time);
+
+// Records that a character has finished being written to the display
+void latency_mark_output(void);
+
+// Gets a summary of the recorded keypress-to-display latencies
+void latency_get_stats(latency_stats_t * stats);
+
+// Discards every recorded latency
+void latency_reset(void);
+
+# endif
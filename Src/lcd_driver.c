@@ -1,13 +1,14 @@
 // file: lcd_driver.c
 // created by: Grant Wilk
 // date created: 12/17/2019
-// last modified: 1/5/2020
+// last modified: 10/16/2026
 // description: Contains functions for driving the LCD on the CE development board
 
-# include <stdio.h>
 # include <stdarg.h>
 # include <stdint.h>
 # include "delay.h"
+# include "fmt.h"
+# include "latency.h"
 # include "lcd_driver.h"
 
 // RCC Addresses
@@ -46,6 +47,13 @@
 // LCD Characteristics
 # define LCD_ROW_LENGTH 40
 # define LCD_MAX_LENGTH 80
+# define LCD_ROW_1_ADDRESS 0x40
+
+// LCD Timings
+// how long the controller needs for most instructions and for clearing or returning home, some
+// controllers run slower than the datasheet and need more
+# define LCD_INSTRUCTION_US_DEFAULT 37
+# define LCD_CLEAR_US_DEFAULT 1520
 
 // Static Function Prototypes
 static void lcd_print_string(char s[]);
@@ -55,13 +63,23 @@ static void lcd_instr_clear(void);
 static void lcd_instr_return_home(void);
 static void lcd_instr_entry_mode_set(int cursorDirection, int displayShift);
 static void lcd_instr_display_on_off(int displayOn, int cursorOn, int cursorPosOn);
-static void lcd_instr_cursor_display_shift(int shift, int direction);
 static void lcd_instr_function_set(int dataInterface, int lineNumber, int fontSize);
+static void lcd_instr_set_ddram_address(int address);
 
 // Global Variables
 static uint32_t * const gpioaODR = (uint32_t *) GPIOA_ODR;
 static uint32_t * const gpiocODR = (uint32_t *) GPIOC_ODR;
 
+// Display Shadow
+// a copy of what every DDRAM cell holds and where the cursor is, indexed as y * LCD_ROW_LENGTH + x,
+// so updates can skip the cells that already show the right character
+static char lcdShadow[LCD_MAX_LENGTH];
+static int lcdShadowCursor;
+
+// Timing State
+static int lcdInstructionUs = LCD_INSTRUCTION_US_DEFAULT;
+static int lcdClearUs = LCD_CLEAR_US_DEFAULT;
+
 // Initializes the LCD pins and readies the LCD peripheral for use
 // @ param void
 // @ return void
@@ -98,7 +116,14 @@ void lcd_init(void) {
 // @ param void
 // @ return void
 void lcd_clear(void) {
+
     lcd_instr_clear();
+
+    for (int i = 0; i < LCD_MAX_LENGTH; i++) {
+        lcdShadow[i] = ' ';
+    }
+
+    lcdShadowCursor = 0;
 }
 
 // Moves the cursor back to it's home position
@@ -106,6 +131,7 @@ void lcd_clear(void) {
 // @ return void
 void lcd_cursor_home(void) {
     lcd_instr_return_home();
+    lcdShadowCursor = 0;
 }
 
 // Sets the cursor to a specific (x, y) position on the LCD
@@ -114,18 +140,9 @@ void lcd_cursor_home(void) {
 // @ return void
 void lcd_cursor_set(int x, int y) {
 
-    // move the cursor back to its home position
-    lcd_cursor_home();
-
-    // move the cursor a full row length for each value of y
-    for (int i = 0; i < y * LCD_ROW_LENGTH; i++) {
-        lcd_instr_cursor_display_shift(0, 1);
-    }
-
-    // move the cursor over a single column for each value of x
-    for (int i = 0; i < x; i++) {
-        lcd_instr_cursor_display_shift(0, 1);
-    }
+    // jump straight to the DDRAM address of the position, the second row starts at 0x40
+    lcd_instr_set_ddram_address(y ? LCD_ROW_1_ADDRESS + x : x);
+    lcdShadowCursor = y * LCD_ROW_LENGTH + x;
 }
 
 // Shows the blinking cursor on the LCD
@@ -143,7 +160,8 @@ void lcd_cursor_hide(void) {
 }
 
 // Prints a formatted string to the LCD
-// @ param format - a variable length argument
+// only %d, %i, %u, %c, %s, and %% are understood, which keeps newlib's vsprintf out of the image
+// @ param format - the format string, followed by one argument for each conversion
 // @ return void
 void lcd_printf(const char * format, ... ) {
 
@@ -151,20 +169,140 @@ void lcd_printf(const char * format, ... ) {
     va_list args;
     va_start(args, format);
 
-    // declare the buffer that will store the formatted string
-    char buffer [LCD_MAX_LENGTH];
+    // declare the buffer that will store a formatted number
+    char number[FMT_INT32_SIZE];
+
+    for (; * format != '\0'; format++) {
+
+        // print everything outside a conversion as it is
+        if (* format != '%') {
+            lcd_write_char(* format);
+            continue;
+        }
+
+        switch (* ++format) {
+
+            case 'd':
+            case 'i':
+                lcd_write(number, fmt_int32(va_arg(args, int), number));
+                break;
 
-    // print to the string buffer
-    vsprintf(buffer, format, args);
+            case 'u':
+                lcd_write(number, fmt_uint32(va_arg(args, unsigned int), number));
+                break;
 
-    // print the string buffer to the LCD
-    lcd_print_string(buffer);
+            case 'c':
+                lcd_write_char((char) va_arg(args, int));
+                break;
+
+            case 's':
+                lcd_print_string(va_arg(args, char *));
+                break;
+
+            // a lone % at the end of the format prints nothing
+            case '\0':
+                format--;
+                break;
+
+            // %% and unknown conversions print the character after the %
+            default:
+                lcd_write_char(* format);
+                break;
+        }
+    }
 
     // terminate the variable arg list
     va_end(args);
 
 }
 
+// Writes a buffer of known length to the LCD
+// @ param buffer - the characters to write
+// @ param length - the number of characters to write
+// @ return void
+void lcd_write(const char * buffer, int length) {
+
+    // print every character in the buffer, no terminator or formatting needed
+    for (int i = 0; i < length; i++) {
+        lcd_write_char(buffer[i]);
+    }
+
+}
+
+// Writes a buffer of known length to a position on the LCD, skipping the characters it already shows
+// the cursor is left after the last character written, or where it was if nothing changed
+// @ param x - the zero-based x-position of the first character
+// @ param y - the zero-based y-position of the first character
+// @ param buffer - the characters to write
+// @ param length - the number of characters to write
+// @ return void
+void lcd_update(int x, int y, const char * buffer, int length) {
+
+    int position = y * LCD_ROW_LENGTH + x;
+
+    for (int i = 0; i < length; i++, position++) {
+
+        if (lcdShadow[position] == buffer[i]) {
+            continue;
+        }
+
+        // only move the cursor when the previous character was skipped
+        if (lcdShadowCursor != position) {
+            lcd_cursor_set(x + i, y);
+        }
+
+        lcd_write_char(buffer[i]);
+    }
+}
+
+// Writes a character to a position on the LCD if it shows a different one, leaving the cursor where it was
+// for indicators kept up to date apart from the text being typed
+// @ param x - the zero-based x-position of the character
+// @ param y - the zero-based y-position of the character
+// @ param character - the character to write
+// @ return void
+void lcd_update_cell(int x, int y, char character) {
+
+    int position = y * LCD_ROW_LENGTH + x;
+    int cursor = lcdShadowCursor;
+
+    if (lcdShadow[position] == character) {
+        return;
+    }
+
+    lcd_cursor_set(x, y);
+    lcd_write_char(character);
+    lcd_cursor_set(cursor % LCD_ROW_LENGTH, cursor / LCD_ROW_LENGTH);
+}
+
+// Sets how long the LCD is given to finish each instruction
+// @ param instructionUs - microseconds for writes and most instructions, at least 37
+// @ param clearUs - microseconds for clearing the display and returning home, at least 1520
+// @ return void
+void lcd_set_timing(int instructionUs, int clearUs) {
+
+    if (instructionUs < LCD_INSTRUCTION_US_DEFAULT || clearUs < LCD_CLEAR_US_DEFAULT) {
+        return;
+    }
+
+    lcdInstructionUs = instructionUs;
+    lcdClearUs = clearUs;
+}
+
+// Gets how long the LCD is given to finish a write or most instructions
+// @ param void
+// @ return the time in microseconds
+int lcd_get_instruction_us(void) {
+    return lcdInstructionUs;
+}
+
+// Gets how long the LCD is given to clear the display or return home
+// @ param void
+// @ return the time in microseconds
+int lcd_get_clear_us(void) {
+    return lcdClearUs;
+}
+
 // Prints a string to the LCD
 // @ param s - the string to print
 // @ return void
@@ -223,7 +361,14 @@ static void lcd_write_char(char character) {
         * gpiocODR &= ~(GPIOC_ODR_LCD_E);
 
         // delay for 10us
-        delay_us(37);
+        delay_us(lcdInstructionUs);
+
+        // the DDRAM address increments after every write and wraps from the end of the second row
+        lcdShadow[lcdShadowCursor] = character;
+        lcdShadowCursor = (lcdShadowCursor + 1) % LCD_MAX_LENGTH;
+
+        // the character is now visible, close out any pending keypress latency
+        latency_mark_output();
     }
 }
 
@@ -238,7 +383,7 @@ static void lcd_instr_clear(void) {
     lcd_write_instruction(instruction);
 
     // delay
-    delay_us(1520);
+    delay_us(lcdClearUs);
 }
 
 // Return home instruction for the LCD
@@ -252,7 +397,7 @@ static void lcd_instr_return_home(void) {
     lcd_write_instruction(instruction);
 
     // delay
-    delay_us(1520);
+    delay_us(lcdClearUs);
 }
 
 // Entry mode set instruction for the LCD
@@ -272,7 +417,7 @@ static void lcd_instr_entry_mode_set(int cursorDirection, int displayShift) {
     lcd_write_instruction(instruction);
 
     // delay
-    delay_us(37);
+    delay_us(lcdInstructionUs);
 }
 
 // Display ON/OFF instruction for the LCD
@@ -294,26 +439,7 @@ static void lcd_instr_display_on_off(int displayOn, int cursorOn, int cursorBlin
     lcd_write_instruction(instruction);
 
     // delay
-    delay_us(37);
-}
-
-// Cursor display/shift instruction for the LCD
-// @ param shiftSelect - shift the display if 1, shift the cursor if 0
-// @ param direction - right if 1, left if 0
-// @ return void
-static void lcd_instr_cursor_display_shift(int shiftSelect, int direction) {
-    // the base cursor display/shift instruction
-    int instruction = (1 << 4);
-
-    // set instruction parameters based on function parameters
-    if (shiftSelect) instruction |= (1 << 3);
-    if (direction) instruction |= (1 << 2);
-
-    // write instruction
-    lcd_write_instruction(instruction);
-
-    // delay
-    delay_us(37);
+    delay_us(lcdInstructionUs);
 }
 
 // Function set instruction for the LCD
@@ -335,5 +461,23 @@ static void lcd_instr_function_set(int dataInterface, int lineNumber, int fontSi
     lcd_write_instruction(instruction);
 
     // delay
-    delay_us(37);
+    delay_us(lcdInstructionUs);
+}
+
+// Set DDRAM address instruction for the LCD
+// @ param address - the DDRAM address to move the cursor to
+// @ return void
+static void lcd_instr_set_ddram_address(int address) {
+
+    // the base set DDRAM address instruction
+    int instruction = (1 << 7);
+
+    // set instruction parameters based on function parameters
+    instruction |= address & 0x7F;
+
+    // write the instruction
+    lcd_write_instruction(instruction);
+
+    // delay
+    delay_us(lcdInstructionUs);
 }
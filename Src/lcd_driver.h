@@ -1,7 +1,7 @@
 // file: lcd_driver.h
 // created by: Grant Wilk
 // date created: 12/17/2019
-// last modified: 1/5/2020
+// last modified: 10/16/2026
 // description: Header file for lcd_driver.c
 
 // Initializes the LCD pins and readys the LCD peripheral for use
@@ -24,3 +24,21 @@ void lcd_cursor_hide(void);
 
 // Prints a formatted string to the LCD
 void lcd_printf(const char * format, ...);
+
+// Writes a buffer of known length to the LCD
+void lcd_write(const char * buffer, int length);
+
+// Writes a buffer of known length to a position on the LCD, skipping the characters it already shows
+void lcd_update(int x, int y, const char * buffer, int length);
+
+// Writes a character to a position on the LCD if it shows a different one, leaving the cursor where it was
+void lcd_update_cell(int x, int y, char character);
+
+// Sets how long the LCD is given to finish each instruction
+void lcd_set_timing(int instructionUs, int clearUs);
+
+// Gets how long the LCD is given to finish a write or most instructions
+int lcd_get_instruction_us(void);
+
+// Gets how long the LCD is given to clear the display or return home
+int lcd_get_clear_us(void);
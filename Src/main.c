@@ -7,281 +7,109 @@ I also took a few creative liberties with the LCD and keypad API. In the LCD API
 // file: main.c
 // created by: Grant Wilk
 // date created: 12/17/2019
-// last modified: 1/11/2020
+// last modified: 10/16/2026
 // description: A calculator program with overflow and divide by zero protection
 
-# include <stdio.h>
 # include <stdlib.h>
-# include <limits.h>
-# include "delay.h"
 # include "lcd_driver.h"
 # include "keypad_driver.h"
+# include "keymap.h"
+# include "replay.h"
+# include "timebase.h"
+# include "irq.h"
+# include "calc.h"
+# include "persist.h"
+# include "bench.h"
+
+// Key Values
+# define DIGIT_KEYS 0x2777
+
+// Replay Benchmark
+// building with -DREPLAY_SCRIPT="\"1 2 A 3 4 # *\"" -DREPLAY_LOOPS=1000 drives the calculator from a script at boot,
+// whose steps are separated by whitespace
+# ifndef REPLAY_LOOPS
+# define REPLAY_LOOPS 1
+# endif
+# define REPLAY_MAX_STEPS 64
 
 int main(void) {
 
 	// initialize peripherals
+	irq_init();
+	timebase_init();
 	key_init();
 	lcd_init();
 
-	// op string contains the first operand, operator, and second operand terminated with a null terminator
-	char opString[33];
-	volatile int opStringLength = 0;
-
-	// operand lengths
-	int firstOperandLength = 0;
-	int secondOperandLength = 0;
-
-	// operand and operator flags
-	char operatorEntered = 0;
-	char secondOperandEntered = 0;
-	char resultDisplayed = 0;
-
-	while (1) {
-
-		// block program flow and wait for a keypress from the keypad
-		int key = key_get_wait();
-
-		// if a number key is pressed
-		if ((key >= 1 && key < 4) || (key >= 5 && key < 8) || (key >= 9 && key < 12) || (key == 14)) {
-
-			// do not accept new number inputs if the result is being displayed
-			if (!resultDisplayed) {
-
-				// do not accept new number inputs if the respective operand is longer than 9 digits
-				if ((!operatorEntered && firstOperandLength < 9) || (operatorEntered && secondOperandLength < 9)) {
-
-					// if no operator has been entered, increment the first operand length
-					if (!operatorEntered) firstOperandLength++;
-
-					// if an operator has been entered, increment the second operand length and set the second operand entered flag
-					if (operatorEntered) {
-						secondOperandLength++;
-						secondOperandEntered = 1;
-					}
-
-					// get the character associated with the key
-					char key_char = key_to_char(key);
-
-					// add the character to the op string
-					opString[opStringLength++] = key_char;
-
-					// print the character to the LCD
-					lcd_printf("%c", key_char);
-
-				}
-
-			}
-
-		// if an operator key is pressed
-		} else if ((key == 4) || (key == 8) || (key == 12) || (key == 16)) {
-
-			// as long as there is some sort of input
-			if (opStringLength != 0 && !secondOperandEntered) {
-
-				char opChar;
-
-				// set operator entered flag
-				operatorEntered = 1;
-
-				// clear result displayed flag
-				resultDisplayed = 0;
-
-				// add the operator to the op string and print it to the LCD
-				switch (key) {
-
-					// add key pressed
-					case 4:
-						opChar = '+';
-						break;
-
-					// subtract key pressed
-					case 8:
-						opChar = '-';
-						break;
-
-					// multiply key pressed
-					case 12:
-						opChar = '*';
-						break;
-
-					// divide key pressed
-					case 16:
-						opChar = '/';
-						break;
-
-					// unknown key pressed (should never occur)
-					default:
-						break;
-
-				}
-
-				// append the operator character to the op string
-				opString[opStringLength++] = opChar;
-
-				// move the cursor to the top right corner of the LCD
-				lcd_cursor_set(15, 0);
-
-				// print the operator character to the LCD
-				lcd_printf("%c", opChar);
-
-				// move the cursor to the bottom left corner of the LCD
-				lcd_cursor_set(0, 1);
-
-			}
-
-		// if the equals key is pressed
-		} else if (key == 15) {
-
-			// if the second operand has been entered
-			if (secondOperandEntered) {
-
-				// add a null terminator to the end of the op string
-				opString[opStringLength++] = '\0';
-
-				// parse the op string
-				int firstOperand;
-				char operatorChar;
-				int secondOperand;
-
-				sscanf(opString, "%d%c%d", &firstOperand, &operatorChar, &secondOperand);
-
-				// overflow and underflow flags
-				char overflow;
-				char underflow;
-
-				// do the calculation
-				int result;
-
-				switch (operatorChar) {
-
-					// add operator
-					case '+':;
-
-						// determine if addition will overflow or underflow
-						overflow = (secondOperand > 0) && (firstOperand > INT_MAX - secondOperand);
-						underflow = (secondOperand < 0) && (firstOperand < INT_MIN - secondOperand);
-
-						// default to zero if overflow/underflow, otherwise complete the calculation
-						if (overflow || underflow) {
-							result = 0;
-						} else {
-							result = firstOperand + secondOperand;
-						}
-
-						break;
-
-					// subtract operator
-					case '-':;
-
-						// determine if subtraction will overflow or underflow
-						overflow = (secondOperand < 0) && (firstOperand > INT_MAX + secondOperand);
-						underflow = (secondOperand > 0) && (firstOperand < INT_MIN + secondOperand);
-
-						// default to zero if overflow/underflow, otherwise complete the calculation
-						if (overflow || underflow) {
-							result = 0;
-						} else {
-							result = firstOperand - secondOperand;
-						}
-
-						break;
-
-					// multiply operator
-					case '*':;
-
-						// determine if multiplication will overflow or underflow
-						overflow = firstOperand > INT_MAX / secondOperand;
-						underflow = firstOperand < INT_MIN / secondOperand;
-
-						// default to zero if overflow/underflow, otherwise complete the calculation
-						if (overflow || underflow) {
-							result = 0;
-						} else {
-							result = firstOperand * secondOperand;
-						}
-
-						break;
-
-					// divide operator
-					case '/':;
-
-						// default to zero if dividing by zero, otherwise complete the calculation
-						if (secondOperand == 0) {
-							result = 0;
-						} else {
-							result = firstOperand / secondOperand;
-						}
-
-						break;
-
-					// unknown operator, default to 0
-					default:
-						result = 0;
-
-				}
-
-				// clear the LCD
-				lcd_clear();
-
-				// print result to the LCD
-				lcd_printf("%d", result);
-
-				if (result == 69) {
-
-					lcd_cursor_hide();
-					delay_ms(1000);
-					lcd_printf(" ");
-
-					for (int i = 0; i < 3; i++) {
-						delay_ms(150);
-						lcd_printf(".");
-					}
-
-					delay_ms(800);
-					lcd_printf(" nice.");
-
-					delay_ms(1000);
-					lcd_cursor_show();
-				}
-
-				// copy the result back into the op string for chained calculations
-				sprintf(opString, "%d", result);
-
-				// move the op string length pointer to the end of the first operand
-				opStringLength = 0;
-				while (opString[opStringLength++ + 1] != '\0');
+	// let digits auto-repeat while held
+	key_set_repeat_mask(DIGIT_KEYS);
+
+# ifdef REPLAY_SCRIPT
+	// start the scripted benchmark
+	static replay_step_t replaySteps[REPLAY_MAX_STEPS];
+	int replayCount = replay_parse(REPLAY_SCRIPT, replaySteps, REPLAY_MAX_STEPS);
+
+	// a built-in script that does not parse is a build mistake, so stop and say so rather than run without it
+	if (replayCount <= 0) {
+		lcd_clear();
+		lcd_printf("Replay script");
+		lcd_cursor_set(0, 1);
+		lcd_printf("did not parse");
+		while (1);
+	}
 
-				// update operand lengths
-				firstOperandLength = opStringLength;
-				secondOperandLength = 0;
+	replay_start(replaySteps, replayCount, REPLAY_LOOPS);
+# endif
+
+# ifdef BENCHMARK
+	// building with -DBENCHMARK shows the cycle cost of every benchmarked kernel, one per keypress
+	static bench_result_t benchResults[BENCH_RESULTS_MAX];
+	int benchCount = bench_run(benchResults, BENCH_RESULTS_MAX);
+	for (int i = 0; i < benchCount; i++) {
+		lcd_clear();
+		lcd_printf("%s", benchResults[i].name);
+		lcd_cursor_set(0, 1);
+		lcd_printf("%u cycles", benchResults[i].cycles);
+		key_get_wait();
+	}
+# endif
 
-				// update flags
-				operatorEntered = 0;
-				secondOperandEntered = 0;
-				resultDisplayed = 1;
+	// restore the settings, history, and memory saved before the last power cycle
+	persist_init();
 
-			}
+	// start with no modifier held and an empty expression
+	keymap_reset();
+	calc_init();
 
-		// if the clear key is pressed
-		} else {
+	while (1) {
 
-			// reset op string length
-			opStringLength = 0;
+		// save changes to flash once the keypad goes idle, a key arriving first postpones the save
+		persist_idle();
 
-			// reset operand lengths
-			firstOperandLength = 0;
-			secondOperandLength = 0;
+		// block program flow and wait for a key event from the keypad
+		key_event_t event;
+		key_get_event_wait(&event);
 
-			// reset operand entered flags
-			operatorEntered = 0;
-			secondOperandEntered = 0;
-			resultDisplayed = 0;
+		// resolve the event to an action on the active keymap layer
+		int action = keymap_resolve(&event);
 
-			// clear the LCD
-			lcd_clear();
+		// if the reset action is triggered, reinitialize the LCD, discard any pending input along with
+		// the modifier it held, whose release may have been discarded too, and clear
+		if (action == ACTION_RESET) {
+			lcd_init();
+			key_clear();
+			keymap_reset();
+			action = ACTION_CLEAR;
+		}
 
+		// ignore events that do nothing on their own
+		if (action == ACTION_NONE) {
+			continue;
 		}
 
+		// hand the action to the calculator, which may change what is saved
+		calc_handle(action);
+		persist_mark();
+
 	}
 
 }
@@ -0,0 +1,119 @@
+// file: memory.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a bank of memory registers that accumulate values across calculations
+
+# include <stdint.h>
+# include "memory.h"
+# include "expr.h"
+
+// Memory State
+// each register holds a value in the arithmetic type it was stored in, and only takes part in
+// calculations of that type until it is cleared, and a set bit in the used mask marks a register that holds a value
+static expr_value_t memoryValues[MEMORY_SLOTS];
+static uint8_t memoryTypes[MEMORY_SLOTS];
+static uint8_t memoryUsed;
+
+_Static_assert(MEMORY_SLOTS <= 8, "memory registers exceed the used mask");
+
+// Empties every register
+// @ param void
+// @ return void
+void memory_clear_all(void) {
+    memoryUsed = 0;
+}
+
+// Empties a register
+// @ param slot - the register, 0 to MEMORY_SLOTS - 1
+// @ return void
+void memory_clear(int slot) {
+    if (slot >= 0 && slot < MEMORY_SLOTS) {
+        memoryUsed &= ~(1 << slot);
+    }
+}
+
+// Adds a value to or subtracts a value from a register
+// the register only changes if the whole operation succeeds, and one that is empty starts from zero, while
+// one that holds a value of another type is refused rather than losing that value
+// @ param slot - the register, 0 to MEMORY_SLOTS - 1
+// @ param type - the arithmetic type of the value
+// @ param operator - '+' or '-'
+// @ param value - the value
+// @ return MEMORY_OK, MEMORY_ERROR_RANGE if the slot is out of range, MEMORY_ERROR_TYPE if the register
+//          holds a value of another type, or MEMORY_ERROR_ARITH if the result overflows the type, in
+//          which case the register keeps its value
+int memory_update(int slot, int type, char operator, expr_value_t value) {
+
+    if (slot < 0 || slot >= MEMORY_SLOTS) {
+        return MEMORY_ERROR_RANGE;
+    }
+
+    // an all-zero value is zero in every type
+    expr_value_t total = { .i = 0 };
+
+    if (memoryUsed & (1 << slot)) {
+
+        if (memoryTypes[slot] != type) {
+            return MEMORY_ERROR_TYPE;
+        }
+
+        total = memoryValues[slot];
+    }
+
+    if (expr_apply(type, operator, total, value, &total) != EXPR_OK) {
+        return MEMORY_ERROR_ARITH;
+    }
+
+    memoryValues[slot] = total;
+    memoryTypes[slot] = type;
+    memoryUsed |= 1 << slot;
+
+    return MEMORY_OK;
+}
+
+// Gets the value of a register
+// @ param slot - the register, 0 to MEMORY_SLOTS - 1
+// @ param type - the arithmetic type the value is wanted in
+// @ param value - where to store the value
+// @ return MEMORY_OK, or MEMORY_ERROR_EMPTY if the register holds no value of that type
+int memory_recall(int slot, int type, expr_value_t * value) {
+
+    if (slot < 0 || slot >= MEMORY_SLOTS || !(memoryUsed & (1 << slot)) || memoryTypes[slot] != type) {
+        return MEMORY_ERROR_EMPTY;
+    }
+
+    * value = memoryValues[slot];
+
+    return MEMORY_OK;
+}
+
+// Gets the value and arithmetic type of a register regardless of the type
+// @ param slot - the register, 0 to MEMORY_SLOTS - 1
+// @ param type - where to store the arithmetic type
+// @ param value - where to store the value
+// @ return MEMORY_OK, or MEMORY_ERROR_EMPTY if the register holds no value
+int memory_get(int slot, int * type, expr_value_t * value) {
+
+    if (slot < 0 || slot >= MEMORY_SLOTS || !(memoryUsed & (1 << slot))) {
+        return MEMORY_ERROR_EMPTY;
+    }
+
+    * type = memoryTypes[slot];
+    * value = memoryValues[slot];
+
+    return MEMORY_OK;
+}
+
+// Sets the value and arithmetic type of a register
+// @ param slot - the register, 0 to MEMORY_SLOTS - 1
+// @ param type - the arithmetic type of the value
+// @ param value - the value
+// @ return void
+void memory_set(int slot, int type, expr_value_t value) {
+    if (slot >= 0 && slot < MEMORY_SLOTS) {
+        memoryValues[slot] = value;
+        memoryTypes[slot] = type;
+        memoryUsed |= 1 << slot;
+    }
+}
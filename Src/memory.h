@@ -0,0 +1,44 @@
+// file: memory.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for memory.c
+
+# ifndef MEMORY_H
+# define MEMORY_H
+
+# include <stdint.h>
+# include "expr.h"
+
+// Memory Capacity
+// the number of registers in the bank
+# ifndef MEMORY_SLOTS
+# define MEMORY_SLOTS 4
+# endif
+
+// Memory Status Codes
+# define MEMORY_OK 0
+# define MEMORY_ERROR_EMPTY 1
+# define MEMORY_ERROR_RANGE 2
+# define MEMORY_ERROR_ARITH 3
+# define MEMORY_ERROR_TYPE 4
+
+// Empties every register
+void memory_clear_all(void);
+
+// Empties a register
+void memory_clear(int slot);
+
+// Adds a value to or subtracts a value from a register
+int memory_update(int slot, int type, char operator, expr_value_t value);
+
+// Gets the value of a register
+int memory_recall(int slot, int type, expr_value_t * value);
+
+// Gets the value and arithmetic type of a register regardless of the type
+int memory_get(int slot, int * type, expr_value_t * value);
+
+// Sets the value and arithmetic type of a register
+void memory_set(int slot, int type, expr_value_t value);
+
+# endif
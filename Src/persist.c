@@ -0,0 +1,357 @@
+// file: persist.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the saving and restoring of settings, history, and memory across power cycles
+
+# include <stdint.h>
+# include <string.h>
+# include "persist.h"
+# include "storage.h"
+# include "calc.h"
+# include "history.h"
+# include "expr.h"
+# include "arith.h"
+# include "memory.h"
+# include "decimal.h"
+# include "keypad_driver.h"
+# include "lcd_driver.h"
+
+// Storage Keys
+# define PERSIST_KEY_SETTINGS 0
+# define PERSIST_KEY_HISTORY 1
+# define PERSIST_KEY_MEMORY 2
+# define PERSIST_KEY_OPERATIONS 3
+
+// Settings Record
+// one byte per calculator setting and two little-endian bytes per driver timing, the version changes
+// whenever the layout does so an old record is ignored rather than misread
+# define PERSIST_SETTINGS_VERSION 2
+# define PERSIST_SETTINGS_BYTES 13
+
+// History Record
+// the number of results, then each result oldest first as its type and the 8 bytes of its value
+# define PERSIST_HISTORY_ENTRY_BYTES (1 + sizeof(expr_value_t))
+# define PERSIST_HISTORY_BYTES (1 + HISTORY_SIZE * PERSIST_HISTORY_ENTRY_BYTES)
+
+// Operation Records
+// the operation that gave each result, oldest first as its operator and the 8 bytes of each operand,
+// spread over as many records from PERSIST_KEY_OPERATIONS as a full history takes
+# define PERSIST_OPERATION_ENTRY_BYTES (1 + 2 * sizeof(expr_value_t))
+# define PERSIST_OPERATION_ENTRIES (STORAGE_RECORD_MAX / PERSIST_OPERATION_ENTRY_BYTES)
+# define PERSIST_OPERATION_RECORDS ((HISTORY_SIZE + PERSIST_OPERATION_ENTRIES - 1) / PERSIST_OPERATION_ENTRIES)
+
+// Memory Record
+// each register in order as its type and the 8 bytes of its value, an empty register has no type
+# define PERSIST_MEMORY_EMPTY 0xFF
+# define PERSIST_MEMORY_ENTRY_BYTES (1 + sizeof(expr_value_t))
+# define PERSIST_MEMORY_BYTES (MEMORY_SLOTS * PERSIST_MEMORY_ENTRY_BYTES)
+
+_Static_assert(PERSIST_HISTORY_BYTES <= STORAGE_RECORD_MAX, "the history does not fit in a storage record");
+_Static_assert(PERSIST_MEMORY_BYTES <= STORAGE_RECORD_MAX, "the memory does not fit in a storage record");
+_Static_assert(PERSIST_KEY_OPERATIONS + PERSIST_OPERATION_RECORDS <= STORAGE_KEYS, "the operations need more storage keys");
+
+// Function Prototypes
+static int persist_settings_build(uint8_t * record);
+static void persist_settings_apply(const uint8_t * record, int length);
+static int persist_history_build(uint8_t * record);
+static void persist_history_apply(const uint8_t * record, int length);
+static int persist_operations_build(int part, uint8_t * record);
+static void persist_operations_apply(int part, const uint8_t * record, int length);
+static int persist_memory_build(uint8_t * record);
+static void persist_memory_apply(const uint8_t * record, int length);
+
+// Persist State
+static char persistPending;
+
+// Restores the settings, history, and memory saved in flash
+// @ param void
+// @ return void
+void persist_init(void) {
+
+    if (storage_init() != STORAGE_OK) {
+        return;
+    }
+
+    uint8_t record[STORAGE_RECORD_MAX];
+    int length;
+
+    if (storage_read(PERSIST_KEY_SETTINGS, record, sizeof(record), &length) == STORAGE_OK) {
+        persist_settings_apply(record, length);
+    }
+
+    if (storage_read(PERSIST_KEY_HISTORY, record, sizeof(record), &length) == STORAGE_OK) {
+        persist_history_apply(record, length);
+    }
+
+    // the operations attach to the results restored above
+    for (int part = 0; part < PERSIST_OPERATION_RECORDS; part++) {
+        if (storage_read(PERSIST_KEY_OPERATIONS + part, record, sizeof(record), &length) == STORAGE_OK) {
+            persist_operations_apply(part, record, length);
+        }
+    }
+
+    if (storage_read(PERSIST_KEY_MEMORY, record, sizeof(record), &length) == STORAGE_OK) {
+        persist_memory_apply(record, length);
+    }
+
+    persistPending = 0;
+}
+
+// Notes that something worth saving may have changed
+// nothing is written until the keypad has been idle, so a burst of keys costs one batch of writes
+// @ param void
+// @ return void
+void persist_mark(void) {
+    persistPending = 1;
+}
+
+// Saves any changes once the keypad has been idle long enough, returning early if a key arrives
+// @ param void
+// @ return void
+void persist_idle(void) {
+
+    if (!persistPending) {
+        return;
+    }
+
+    // sleep through the wait, the timer alarm ends it if no key does
+    if (key_wait_timeout(PERSIST_IDLE_MS) == 0) {
+        persist_flush();
+    }
+}
+
+// Saves any changes to flash now
+// records that did not change since they were last saved are not written again
+// @ param void
+// @ return void
+void persist_flush(void) {
+
+    uint8_t record[STORAGE_RECORD_MAX];
+
+    storage_write(PERSIST_KEY_SETTINGS, record, persist_settings_build(record));
+    storage_write(PERSIST_KEY_HISTORY, record, persist_history_build(record));
+
+    for (int part = 0; part < PERSIST_OPERATION_RECORDS; part++) {
+        storage_write(PERSIST_KEY_OPERATIONS + part, record, persist_operations_build(part, record));
+    }
+    storage_write(PERSIST_KEY_MEMORY, record, persist_memory_build(record));
+
+    persistPending = 0;
+}
+
+// Writes the settings record
+// @ param record - where to write the record
+// @ return the length of the record
+static int persist_settings_build(uint8_t * record) {
+
+    int debounce = key_get_debounce();
+    int instructionUs = lcd_get_instruction_us();
+    int clearUs = lcd_get_clear_us();
+
+    record[0] = PERSIST_SETTINGS_VERSION;
+    record[1] = calc_get_mode();
+    record[2] = calc_get_float_precision();
+    record[3] = decimal_get_places();
+    record[4] = calc_get_rpn();
+    record[5] = calc_get_rpn_depth();
+    record[6] = debounce;
+    record[7] = debounce >> 8;
+    record[8] = instructionUs;
+    record[9] = instructionUs >> 8;
+    record[10] = clearUs;
+    record[11] = clearUs >> 8;
+    record[12] = calc_get_base();
+
+    return PERSIST_SETTINGS_BYTES;
+}
+
+// Restores the settings from their record, every setter rejects a value out of its range
+// @ param record - the record
+// @ param length - the length of the record
+// @ return void
+static void persist_settings_apply(const uint8_t * record, int length) {
+
+    if (length != PERSIST_SETTINGS_BYTES || record[0] != PERSIST_SETTINGS_VERSION) {
+        return;
+    }
+
+    lcd_set_timing(record[8] | (record[9] << 8), record[10] | (record[11] << 8));
+    key_set_debounce(record[6] | (record[7] << 8));
+    decimal_set_places(record[3]);
+    calc_set_float_precision(record[2]);
+    calc_set_rpn_depth(record[5]);
+    calc_set_rpn(record[4]);
+    calc_set_base(record[12]);
+    calc_set_mode(record[1]);
+}
+
+// Writes the history record
+// @ param record - where to write the record
+// @ return the length of the record
+static int persist_history_build(uint8_t * record) {
+
+    int count = history_get_count();
+    uint8_t * entry = record + 1;
+
+    record[0] = count;
+
+    for (int index = count - 1; index >= 0; index--) {
+
+        int type;
+        expr_value_t value;
+        history_get(index, &type, &value);
+
+        entry[0] = type;
+        memcpy(entry + 1, &value, sizeof(value));
+        entry += PERSIST_HISTORY_ENTRY_BYTES;
+    }
+
+    return entry - record;
+}
+
+// Restores the history from its record
+// @ param record - the record
+// @ param length - the length of the record
+// @ return void
+static void persist_history_apply(const uint8_t * record, int length) {
+
+    int count = record[0];
+
+    if (length < 1 || count > HISTORY_SIZE || length != 1 + count * (int) PERSIST_HISTORY_ENTRY_BYTES) {
+        return;
+    }
+
+    history_clear();
+
+    const uint8_t * entry = record + 1;
+
+    for (int i = 0; i < count; i++) {
+
+        expr_value_t value;
+        memcpy(&value, entry + 1, sizeof(value));
+
+        // the operations are restored from their own records
+        history_add(entry[0], 0, value, value, value);
+        entry += PERSIST_HISTORY_ENTRY_BYTES;
+    }
+}
+
+// Writes one of the operation records
+// @ param part - which of the records, 0 holds the oldest operations
+// @ param record - where to write the record
+// @ return the length of the record
+static int persist_operations_build(int part, uint8_t * record) {
+
+    int count = history_get_count();
+    uint8_t * entry = record;
+
+    for (int position = part * PERSIST_OPERATION_ENTRIES;
+         position < count && position < (part + 1) * PERSIST_OPERATION_ENTRIES; position++) {
+
+        char operator;
+        expr_value_t left;
+        expr_value_t right;
+        history_get_operation(count - 1 - position, &operator, &left, &right);
+
+        entry[0] = operator;
+        memcpy(entry + 1, &left, sizeof(left));
+        memcpy(entry + 1 + sizeof(left), &right, sizeof(right));
+        entry += PERSIST_OPERATION_ENTRY_BYTES;
+    }
+
+    return entry - record;
+}
+
+// Restores the operations of one of the operation records to the restored results
+// power can fail between the writes of the history and its operations, so an operation is only
+// restored if applying it again gives the result it is restored to
+// @ param part - which of the records, 0 holds the oldest operations
+// @ param record - the record
+// @ param length - the length of the record
+// @ return void
+static void persist_operations_apply(int part, const uint8_t * record, int length) {
+
+    int count = history_get_count();
+
+    if (length % PERSIST_OPERATION_ENTRY_BYTES != 0) {
+        return;
+    }
+
+    const uint8_t * entry = record;
+    int position = part * PERSIST_OPERATION_ENTRIES;
+
+    for (int i = 0; i < length / (int) PERSIST_OPERATION_ENTRY_BYTES && position < count; i++, position++) {
+
+        int type;
+        char operator = entry[0];
+        expr_value_t left;
+        expr_value_t right;
+        expr_value_t value;
+        expr_value_t result;
+
+        memcpy(&left, entry + 1, sizeof(left));
+        memcpy(&right, entry + 1 + sizeof(left), sizeof(right));
+        history_get(count - 1 - position, &type, &value);
+
+        // a float fills only part of a value, so only its own bits are compared
+        int same = 0;
+        if (operator != 0 && expr_apply(type, operator, left, right, &result) == EXPR_OK) {
+            same = (type == ARITH_TYPE_FLOAT) ? memcmp(&result.f, &value.f, sizeof(value.f)) == 0 : result.i == value.i;
+        }
+
+        if (same) {
+            history_set_operation(count - 1 - position, operator, left, right);
+        }
+
+        entry += PERSIST_OPERATION_ENTRY_BYTES;
+    }
+}
+
+// Writes the memory record
+// @ param record - where to write the record
+// @ return the length of the record
+static int persist_memory_build(uint8_t * record) {
+
+    uint8_t * entry = record;
+
+    for (int slot = 0; slot < MEMORY_SLOTS; slot++) {
+
+        int type = PERSIST_MEMORY_EMPTY;
+        expr_value_t value = { .i = 0 };
+        memory_get(slot, &type, &value);
+
+        entry[0] = type;
+        memcpy(entry + 1, &value, sizeof(value));
+        entry += PERSIST_MEMORY_ENTRY_BYTES;
+    }
+
+    return entry - record;
+}
+
+// Restores the memory from its record
+// @ param record - the record
+// @ param length - the length of the record
+// @ return void
+static void persist_memory_apply(const uint8_t * record, int length) {
+
+    if (length != PERSIST_MEMORY_BYTES) {
+        return;
+    }
+
+    memory_clear_all();
+
+    const uint8_t * entry = record;
+
+    for (int slot = 0; slot < MEMORY_SLOTS; slot++) {
+
+        expr_value_t value;
+        memcpy(&value, entry + 1, sizeof(value));
+
+        if (entry[0] != PERSIST_MEMORY_EMPTY) {
+            memory_set(slot, entry[0], value);
+        }
+
+        entry += PERSIST_MEMORY_ENTRY_BYTES;
+    }
+}
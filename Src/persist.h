@@ -0,0 +1,28 @@
+// file: persist.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for persist.c
+
+# ifndef PERSIST_H
+# define PERSIST_H
+
+// Save Delay
+// how long the keypad has to be idle before changes are written to flash
+# ifndef PERSIST_IDLE_MS
+# define PERSIST_IDLE_MS 500
+# endif
+
+// Restores the settings, history, and memory saved in flash
+void persist_init(void);
+
+// Notes that something worth saving may have changed
+void persist_mark(void);
+
+// Saves any changes once the keypad has been idle long enough, returning early if a key arrives
+void persist_idle(void);
+
+// Saves any changes to flash now
+void persist_flush(void);
+
+# endif
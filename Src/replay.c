@@ -0,0 +1,257 @@
+// file: replay.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a scripted keypress replay engine for driving the calculator without touching the keypad
+
+# include <stdint.h>
+# include "keypad_driver.h"
+# include "replay.h"
+# include "timebase.h"
+
+// Replay Timing
+# define REPLAY_DEFAULT_DELAY_MS 100
+# define REPLAY_TAP_HOLD_MS 40
+# define REPLAY_DELAY_MS_MAX 0xFFFF
+# define REPLAY_STEPS_PER_TICK 8
+
+// Replay State
+// only touched from the tick, apart from replay_start and replay_stop which run with the tick detached
+static const replay_step_t * replaySteps = 0;
+static int replayCount = 0;
+static int replayIndex = 0;
+static uint32_t replayLoopsLeft = 0;
+static volatile uint32_t replayLoopsDone = 0;
+static int32_t replayWaitMs = 0;
+static uint8_t replayHeldKey = 0;
+static int32_t replayHeldMs = 0;
+static volatile char replayRunning = 0;
+
+// Replay Statistics
+static uint32_t replayStartTime = 0;
+static volatile uint32_t replayElapsedUs = 0;
+
+// Static Function Prototypes
+static void replay_release_held(void);
+static void replay_run_step(const replay_step_t * step);
+
+// Parses a text script into replay steps
+// the script is a whitespace separated list of keypad characters, each optionally prefixed with
+// '+' to only press the key or '-' to only release it, and optionally followed by '@' and the
+// delay in milliseconds before the next step, e.g. "1 2 A 3@250 # +* 1 -*"
+// @ param text - the null terminated script
+// @ param steps - where to store the parsed steps
+// @ param maxSteps - the capacity of the steps array
+// @ return the number of steps parsed, or -1 if the script is invalid or too long
+int replay_parse(const char * text, replay_step_t * steps, int maxSteps) {
+
+    int count = 0;
+
+    while (* text != '\0') {
+
+        // skip whitespace between steps
+        if (* text == ' ' || * text == '\t' || * text == '\n' || * text == '\r') {
+            text++;
+            continue;
+        }
+
+        if (count >= maxSteps) {
+            return -1;
+        }
+
+        replay_step_t * step = &steps[count++];
+        step->action = REPLAY_TAP;
+        step->delayMs = REPLAY_DEFAULT_DELAY_MS;
+
+        // an optional press or release prefix, a lone '+' or '-' is still a key if one exists
+        if ((* text == '+' || * text == '-') && text[1] != '\0' && text[1] != ' ' && text[1] != '@') {
+            step->action = (* text == '+') ? REPLAY_PRESS : REPLAY_RELEASE;
+            text++;
+        }
+
+        // the key itself
+        step->key = key_from_char(* text++);
+        if (step->key == 0) {
+            return -1;
+        }
+
+        // an optional delay
+        if (* text == '@') {
+
+            uint32_t delay = 0;
+            text++;
+
+            if (* text < '0' || * text > '9') {
+                return -1;
+            }
+
+            while (* text >= '0' && * text <= '9') {
+                delay = delay * 10 + (* text++ - '0');
+                if (delay > REPLAY_DELAY_MS_MAX) {
+                    return -1;
+                }
+            }
+
+            step->delayMs = delay;
+        }
+
+        // steps must be separated
+        if (* text != '\0' && * text != ' ' && * text != '\t' && * text != '\n' && * text != '\r') {
+            return -1;
+        }
+    }
+
+    return count;
+}
+
+// Starts replaying a script through the keypad event queue
+// the steps are injected from the keypad timer, so they reach the application exactly like real keys
+// @ param steps - the script, which must stay valid until the replay finishes
+// @ param count - the number of steps in the script
+// @ param loops - how many times to run the script
+// @ return void
+void replay_start(const replay_step_t * steps, int count, uint32_t loops) {
+
+    // detach from the tick while the state is replaced
+    key_set_tick_callback(0);
+
+    if (count <= 0 || loops == 0) {
+        replayRunning = 0;
+        return;
+    }
+
+    replaySteps = steps;
+    replayCount = count;
+    replayIndex = 0;
+    replayLoopsLeft = loops;
+    replayLoopsDone = 0;
+    replayWaitMs = 0;
+    replayHeldKey = 0;
+    replayElapsedUs = 0;
+    replayStartTime = timebase_now_us();
+    replayRunning = 1;
+
+    key_set_tick_callback(replay_tick);
+}
+
+// Stops a running replay, releasing any key it is holding
+// @ param void
+// @ return void
+void replay_stop(void) {
+    key_set_tick_callback(0);
+    replay_release_held();
+    replayRunning = 0;
+}
+
+// Advances the replay by some number of milliseconds, injecting the steps that have come due
+// the tick runs in the keypad timer interrupt, so it injects at most REPLAY_STEPS_PER_TICK steps,
+// which also keeps a tap's press and release within the event queue. a script whose delays add up
+// to less than that per tick, down to all zero, falls behind and runs at that rate instead
+// @ param elapsed - the milliseconds since the last tick
+// @ return void
+void replay_tick(int elapsed) {
+
+    if (!replayRunning) {
+        return;
+    }
+
+    // let go of a tapped key once it has been held long enough
+    if (replayHeldKey != 0) {
+        replayHeldMs -= elapsed;
+        if (replayHeldMs <= 0) {
+            replay_release_held();
+        }
+    }
+
+    replayWaitMs -= elapsed;
+
+    for (int steps = 0; replayWaitMs <= 0; steps++) {
+
+        // the rest is due next tick, without a backlog to catch up on
+        if (steps == REPLAY_STEPS_PER_TICK) {
+            replayWaitMs = 0;
+            return;
+        }
+
+        const replay_step_t * step = &replaySteps[replayIndex];
+
+        replay_run_step(step);
+        replayWaitMs += step->delayMs;
+        replayElapsedUs = timebase_elapsed_us(replayStartTime);
+
+        // move to the next step, wrapping around for each loop
+        if (++replayIndex >= replayCount) {
+
+            replayIndex = 0;
+            replayLoopsDone++;
+
+            if (--replayLoopsLeft == 0) {
+                replay_release_held();
+                replayRunning = 0;
+                key_set_tick_callback(0);
+                return;
+            }
+        }
+    }
+}
+
+// Checks whether a replay is still running
+// @ param void
+// @ return 1 if steps are still being injected, otherwise 0
+int replay_is_running(void) {
+    return replayRunning;
+}
+
+// Gets the number of complete passes through the script so far
+// @ param void
+// @ return the number of finished loops
+uint32_t replay_get_loops_done(void) {
+    return replayLoopsDone;
+}
+
+// Gets the time from the start of the replay to its last injected step
+// @ param void
+// @ return the elapsed time in microseconds
+uint32_t replay_get_elapsed_us(void) {
+    return replayElapsedUs;
+}
+
+// Injects the release of a tapped key that is still held
+// @ param void
+// @ return void
+static void replay_release_held(void) {
+    if (replayHeldKey != 0) {
+        key_inject(replayHeldKey, KEY_EVENT_RELEASE);
+        replayHeldKey = 0;
+    }
+}
+
+// Injects the events of a single step
+// @ param step - the step to run
+// @ return void
+static void replay_run_step(const replay_step_t * step) {
+
+    // a new step always follows the release of the previous tap
+    replay_release_held();
+
+    switch (step->action) {
+
+        // press now and release after the tap hold time or at the next step, whichever comes first
+        case REPLAY_TAP:
+            key_inject(step->key, KEY_EVENT_PRESS);
+            replayHeldKey = step->key;
+            replayHeldMs = (step->delayMs < REPLAY_TAP_HOLD_MS) ? step->delayMs : REPLAY_TAP_HOLD_MS;
+            break;
+
+        case REPLAY_PRESS:
+            key_inject(step->key, KEY_EVENT_PRESS);
+            break;
+
+        case REPLAY_RELEASE:
+            key_inject(step->key, KEY_EVENT_RELEASE);
+            break;
+
+        default:
+            break;
+    }
+}
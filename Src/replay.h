@@ -0,0 +1,45 @@
+// file: replay.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for replay.c
+
+# ifndef REPLAY_H
+# define REPLAY_H
+
+# include <stdint.h>
+
+// Step Actions
+# define REPLAY_TAP 0
+# define REPLAY_PRESS 1
+# define REPLAY_RELEASE 2
+
+// One scripted key action followed by a delay before the next step
+typedef struct {
+    uint8_t key;
+    uint8_t action;
+    uint16_t delayMs;
+} replay_step_t;
+
+// Parses a text script into replay steps
+int replay_parse(const char * text, replay_step_t * steps, int maxSteps);
+
+// Starts replaying a script through the keypad event queue
+void replay_start(const replay_step_t * steps, int count, uint32_t loops);
+
+// Stops a running replay, releasing any key it is holding
+void replay_stop(void);
+
+// Advances the replay by some number of milliseconds
+void replay_tick(int elapsed);
+
+// Checks whether a replay is still running
+int replay_is_running(void);
+
+// Gets the number of complete passes through the script so far
+uint32_t replay_get_loops_done(void);
+
+// Gets the time from the start of the replay to its last injected step
+uint32_t replay_get_elapsed_us(void);
+
+# endif
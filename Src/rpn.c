@@ -0,0 +1,194 @@
+// file: rpn.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a fixed-depth reverse polish notation operand stack
+
+# include <stdint.h>
+# include "rpn.h"
+# include "expr.h"
+
+// Function Prototypes
+static int rpn_slot(const rpn_t * rpn, int level);
+
+// Empties a stack and sets its depth and the arithmetic type it evaluates in
+// @ param rpn - the stack to empty
+// @ param type - ARITH_TYPE_INT32, ARITH_TYPE_INT64, ARITH_TYPE_FLOAT, or ARITH_TYPE_DECIMAL
+// @ param depth - the number of values the stack holds, clamped to 2-RPN_DEPTH_MAX
+// @ return void
+void rpn_init(rpn_t * rpn, int type, int depth) {
+
+    if (depth < 2) depth = 2;
+    if (depth > RPN_DEPTH_MAX) depth = RPN_DEPTH_MAX;
+
+    rpn->type = type;
+    rpn->depth = depth;
+    rpn->top = 0;
+    rpn->count = 0;
+}
+
+// Pushes a value onto a stack, dropping the oldest value if it is full
+// @ param rpn - the stack
+// @ param value - the value to push
+// @ return void
+void rpn_push(rpn_t * rpn, expr_value_t value) {
+
+    // the slot after the top is either free or holds the oldest value
+    rpn->top = rpn_slot(rpn, -1);
+    rpn->values[rpn->top] = value;
+
+    if (rpn->count < rpn->depth) {
+        rpn->count++;
+    }
+}
+
+// Pops the value on top of a stack
+// @ param rpn - the stack
+// @ param value - where to store the value
+// @ return RPN_OK, or RPN_ERROR_EMPTY if the stack is empty
+int rpn_pop(rpn_t * rpn, expr_value_t * value) {
+
+    if (rpn->count == 0) {
+        return RPN_ERROR_EMPTY;
+    }
+
+    * value = rpn->values[rpn->top];
+    rpn->top = rpn_slot(rpn, 1);
+    rpn->count--;
+
+    return RPN_OK;
+}
+
+// Gets the value at a level of a stack without removing it
+// @ param rpn - the stack
+// @ param level - the level, 0 is the top
+// @ param value - where to store the value
+// @ return RPN_OK, or RPN_ERROR_EMPTY if the level holds no value
+int rpn_peek(const rpn_t * rpn, int level, expr_value_t * value) {
+
+    if (level < 0 || level >= rpn->count) {
+        return RPN_ERROR_EMPTY;
+    }
+
+    * value = rpn->values[rpn_slot(rpn, level)];
+
+    return RPN_OK;
+}
+
+// Gets the number of values on a stack
+// @ param rpn - the stack
+// @ return the number of values
+int rpn_get_count(const rpn_t * rpn) {
+    return rpn->count;
+}
+
+// Replaces the top two values of a stack with the result of a binary operator
+// the second value is the left operand, so values are entered in the order they are written
+// an operation with no result leaves both values on the stack
+// @ param rpn - the stack
+// @ param operator - '+', '-', '*', '/', '%', '^', or one of the bitwise operators of arith_int
+// @ return RPN_OK, RPN_ERROR_EMPTY if the stack holds fewer than two values, or RPN_ERROR_ARITH if the
+// operation overflows, divides by zero, or has no real value
+int rpn_operator(rpn_t * rpn, char operator) {
+
+    if (rpn->count < 2) {
+        return RPN_ERROR_EMPTY;
+    }
+
+    expr_value_t a = rpn->values[rpn_slot(rpn, 1)];
+    expr_value_t b = rpn->values[rpn->top];
+    expr_value_t result;
+
+    if (expr_apply(rpn->type, operator, a, b, &result) != EXPR_OK) {
+        return RPN_ERROR_ARITH;
+    }
+
+    rpn_pop(rpn, &b);
+    rpn->values[rpn->top] = result;
+
+    return RPN_OK;
+}
+
+// Replaces the top value of a stack with the result of a scientific function
+// a function with no result leaves the value on the stack
+// @ param rpn - the stack
+// @ param function - one of the SCI function values, or EXPR_FUNCTION_NOT for an integer
+// @ return RPN_OK, RPN_ERROR_EMPTY if the stack is empty, or RPN_ERROR_ARITH if the value is outside the
+// function's domain or the result overflows
+int rpn_function(rpn_t * rpn, int function) {
+
+    if (rpn->count == 0) {
+        return RPN_ERROR_EMPTY;
+    }
+
+    expr_value_t * x = &rpn->values[rpn->top];
+
+    if (expr_apply_unary(rpn->type, function, * x, x) != EXPR_OK) {
+        return RPN_ERROR_ARITH;
+    }
+
+    return RPN_OK;
+}
+
+// Exchanges the top two values of a stack
+// @ param rpn - the stack
+// @ return RPN_OK, or RPN_ERROR_EMPTY if the stack holds fewer than two values
+int rpn_swap(rpn_t * rpn) {
+
+    if (rpn->count < 2) {
+        return RPN_ERROR_EMPTY;
+    }
+
+    int y = rpn_slot(rpn, 1);
+    expr_value_t x = rpn->values[rpn->top];
+
+    rpn->values[rpn->top] = rpn->values[y];
+    rpn->values[y] = x;
+
+    return RPN_OK;
+}
+
+// Removes the top value of a stack
+// @ param rpn - the stack
+// @ return RPN_OK, or RPN_ERROR_EMPTY if the stack is empty
+int rpn_drop(rpn_t * rpn) {
+
+    expr_value_t x;
+
+    return rpn_pop(rpn, &x);
+}
+
+// Rotates a stack down, moving the top value to the bottom and every other value up a level
+// @ param rpn - the stack
+// @ return RPN_OK, or RPN_ERROR_EMPTY if the stack is empty
+int rpn_roll(rpn_t * rpn) {
+
+    if (rpn->count == 0) {
+        return RPN_ERROR_EMPTY;
+    }
+
+    // a full ring already has the top value just past the bottom one, so only the top moves
+    if (rpn->count == rpn->depth) {
+        rpn->top = rpn_slot(rpn, 1);
+        return RPN_OK;
+    }
+
+    // otherwise every value moves up a level into the slot below it
+    expr_value_t x = rpn->values[rpn->top];
+
+    for (int level = 0; level < rpn->count - 1; level++) {
+        rpn->values[rpn_slot(rpn, level)] = rpn->values[rpn_slot(rpn, level + 1)];
+    }
+
+    rpn->values[rpn_slot(rpn, rpn->count - 1)] = x;
+
+    return RPN_OK;
+}
+
+// Gets the ring buffer slot that holds a level of a stack
+// @ param rpn - the stack
+// @ param level - the level, 0 is the top and -1 is the slot a push fills
+// @ return the index into the stack's values
+static int rpn_slot(const rpn_t * rpn, int level) {
+    return (rpn->top + rpn->depth - level) % rpn->depth;
+}
@@ -0,0 +1,67 @@
+// file: rpn.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for rpn.c
+
+# ifndef RPN_H
+# define RPN_H
+
+# include <stdint.h>
+# include "expr.h"
+
+// Stack Limits
+// the deepest stack a calculator can select, and the depth it starts with
+# define RPN_DEPTH_MAX 16
+
+# ifndef RPN_DEPTH_DEFAULT
+# define RPN_DEPTH_DEFAULT 4
+# endif
+
+// RPN Status Codes
+# define RPN_OK 0
+# define RPN_ERROR_EMPTY 1
+# define RPN_ERROR_ARITH 2
+
+// RPN Stack
+// a ring buffer of the last depth values pushed, level 0 (X) is values[top] and each level below
+// it is one slot further back, so a full stack drops its oldest value by overwriting it
+typedef struct {
+    expr_value_t values[RPN_DEPTH_MAX];
+    uint8_t top;
+    uint8_t count;
+    uint8_t depth;
+    uint8_t type;
+} rpn_t;
+
+// Empties a stack and sets its depth and the arithmetic type it evaluates in
+void rpn_init(rpn_t * rpn, int type, int depth);
+
+// Pushes a value onto a stack, dropping the oldest value if it is full
+void rpn_push(rpn_t * rpn, expr_value_t value);
+
+// Pops the value on top of a stack
+int rpn_pop(rpn_t * rpn, expr_value_t * value);
+
+// Gets the value at a level of a stack without removing it
+int rpn_peek(const rpn_t * rpn, int level, expr_value_t * value);
+
+// Gets the number of values on a stack
+int rpn_get_count(const rpn_t * rpn);
+
+// Replaces the top two values of a stack with the result of a binary operator
+int rpn_operator(rpn_t * rpn, char operator);
+
+// Replaces the top value of a stack with the result of a scientific function
+int rpn_function(rpn_t * rpn, int function);
+
+// Exchanges the top two values of a stack
+int rpn_swap(rpn_t * rpn);
+
+// Removes the top value of a stack
+int rpn_drop(rpn_t * rpn);
+
+// Rotates a stack down, moving the top value to the bottom
+int rpn_roll(rpn_t * rpn);
+
+# endif
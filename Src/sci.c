@@ -0,0 +1,1124 @@
+// file: sci.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the scientific functions for the float, decimal, and integer calculator modes
+
+# include <stdint.h>
+# include "sci.h"
+# include "decimal.h"
+# include "arith.h"
+
+// Float Limits
+// exp overflows above ln(FLT_MAX) and flushes to zero below ln(FLT_MIN), trig reduces angles
+// past pi / 4 in fixed point and refuses angles too large for it
+# define SCI_FLOAT_EXP_MAX 88.7228394f
+# define SCI_FLOAT_EXP_MIN -87.3365479f
+# define SCI_FLOAT_TRIG_SMALL 0.78125f
+# define SCI_FLOAT_TRIG_MAX 1073741824.0f
+
+// Float Reduction Constants
+// pi / 32, ln(2) / 32, and ln(2) split so the leading parts have 10 or 12 significant bits,
+// which keeps their products with the reduction multiple exact for every argument in range
+# define SCI_FLOAT_32_OVER_PI 10.1859159f
+# define SCI_FLOAT_PI_32_A 0.09814453125f
+# define SCI_FLOAT_PI_32_B 3.02493572e-05f
+# define SCI_FLOAT_PI_32_C -1.01825428e-08f
+# define SCI_FLOAT_32_OVER_LN2 46.1662407f
+# define SCI_FLOAT_LN2_32_A 0.02166748046875f
+# define SCI_FLOAT_LN2_32_B -6.63107630e-06f
+# define SCI_FLOAT_LN2_A 0.693115234375f
+# define SCI_FLOAT_LN2_B 3.19461833e-05f
+
+// Whole Powers
+// powers with a whole exponent this small multiply by squaring instead of going through exp and ln
+# define SCI_POW_INT_MAX 64
+
+// Table Sizes
+# define SCI_SIN_TABLE_SIZE 64
+# define SCI_EXP2_TABLE_SIZE 32
+# define SCI_LN_TABLE_SIZE 49
+# define SCI_CORDIC_STEPS 34
+# define SCI_FIXED_LN_STEPS 32
+
+// Fixed Point Constants
+// Q32.32 except the CORDIC gain, which is Q2.62 like the CORDIC vectors
+# define SCI_FIXED_LN2 2977044472LL
+# define SCI_FIXED_INV_LN2 6196328019LL
+# define SCI_FIXED_TWO_OVER_PI 2734261102LL
+# define SCI_FIXED_HALF_PI 6746518852LL
+# define SCI_FIXED_HALF_PI_LOW 1121027178LL
+# define SCI_FIXED_HALF_PI_TAIL -1987263209LL
+# define SCI_FIXED_TRIG_MAX ((int64_t) 1 << 62)
+# define SCI_CORDIC_GAIN 2800459870029452954LL
+
+// Function Prototypes
+static int32_t sci_nearest(float x);
+static float sci_pow2(int32_t exponent);
+static int sci_sqrtf(float x, float * result);
+static int sci_sincosf(float x, float * sine, float * cosine);
+static int sci_expf(float x, float * result);
+static int sci_logf(float x, float * result);
+static int sci_float_pow_int(float x, int32_t exponent, float * result);
+static int sci_fixed_mul(int64_t a, int64_t b, int64_t * result);
+static int sci_fixed_pow_int(int64_t x, int32_t exponent, int64_t * result);
+static int64_t sci_fixed_reduce(int64_t x, int32_t * quadrant);
+static int sci_fixed_sincos(int64_t x, int64_t * sine, int64_t * cosine);
+static int sci_fixed_exp(int64_t x, int64_t * result);
+static int sci_fixed_ln(int64_t x, int64_t * result);
+static int sci_fixed_sqrt(int64_t x, int64_t * result);
+static int sci_decimal_to_fixed(int64_t x, int64_t * result);
+static int sci_fixed_to_decimal(int64_t x, int64_t * result);
+static uint64_t sci_isqrt(uint64_t value);
+
+// Sine Table
+// sin(k * pi / 32) for a full turn, cos(k * pi / 32) is the entry a quarter turn later
+static const float sciSinTable[SCI_SIN_TABLE_SIZE] = {
+    0.0f, 0.0980171412f, 0.195090324f, 0.290284663f,
+    0.382683426f, 0.471396744f, 0.555570245f, 0.634393275f,
+    0.707106769f, 0.773010433f, 0.831469595f, 0.881921291f,
+    0.923879504f, 0.956940353f, 0.980785251f, 0.99518472f,
+    1.0f, 0.99518472f, 0.980785251f, 0.956940353f,
+    0.923879504f, 0.881921291f, 0.831469595f, 0.773010433f,
+    0.707106769f, 0.634393275f, 0.555570245f, 0.471396744f,
+    0.382683426f, 0.290284663f, 0.195090324f, 0.0980171412f,
+    0.0f, -0.0980171412f, -0.195090324f, -0.290284663f,
+    -0.382683426f, -0.471396744f, -0.555570245f, -0.634393275f,
+    -0.707106769f, -0.773010433f, -0.831469595f, -0.881921291f,
+    -0.923879504f, -0.956940353f, -0.980785251f, -0.99518472f,
+    -1.0f, -0.99518472f, -0.980785251f, -0.956940353f,
+    -0.923879504f, -0.881921291f, -0.831469595f, -0.773010433f,
+    -0.707106769f, -0.634393275f, -0.555570245f, -0.471396744f,
+    -0.382683426f, -0.290284663f, -0.195090324f, -0.0980171412f
+};
+
+// Exponential Table
+// 2^(j / 32), the fractional part of the power of two an exponent reduces to
+static const float sciExp2Table[SCI_EXP2_TABLE_SIZE] = {
+    1.0f, 1.0218972f, 1.04427373f, 1.06714046f,
+    1.09050775f, 1.1143868f, 1.13878858f, 1.1637249f,
+    1.18920708f, 1.21524739f, 1.24185777f, 1.26905096f,
+    1.29683959f, 1.32523668f, 1.35425556f, 1.38390994f,
+    1.41421354f, 1.44518077f, 1.47682619f, 1.50916445f,
+    1.54221082f, 1.5759809f, 1.61049032f, 1.64575553f,
+    1.68179286f, 1.71861935f, 1.75625217f, 1.79470909f,
+    1.8340081f, 1.87416768f, 1.91520655f, 1.95714414f
+};
+
+// Logarithm Tables
+// ln(c) and 1 / c for c = 0.75 + j / 64, one entry exactly at 1 so logs near 1 keep their precision
+static const float sciLnTable[SCI_LN_TABLE_SIZE] = {
+    -0.287682086f, -0.267062783f, -0.246860072f, -0.227057457f,
+    -0.207639366f, -0.188591167f, -0.169899032f, -0.151549906f,
+    -0.133531392f, -0.115831815f, -0.0984400734f, -0.0813456401f,
+    -0.0645385236f, -0.0480092205f, -0.0317486972f, -0.0157483574f,
+    0.0f, 0.015504187f, 0.0307716578f, 0.0458095372f,
+    0.0606246218f, 0.0752234235f, 0.0896121562f, 0.103796795f,
+    0.117783032f, 0.131576359f, 0.145182014f, 0.158605024f,
+    0.171850264f, 0.184922338f, 0.197825745f, 0.210564762f,
+    0.223143548f, 0.235566065f, 0.247836158f, 0.259957522f,
+    0.271933705f, 0.283768177f, 0.295464218f, 0.307025045f,
+    0.318453729f, 0.32975328f, 0.340926588f, 0.351976424f,
+    0.362905502f, 0.373716414f, 0.384411693f, 0.394993812f,
+    0.405465096f
+};
+
+static const float sciLnInverseTable[SCI_LN_TABLE_SIZE] = {
+    1.33333337f, 1.30612242f, 1.27999997f, 1.25490201f,
+    1.23076928f, 1.20754719f, 1.18518519f, 1.16363633f,
+    1.14285719f, 1.12280703f, 1.10344827f, 1.08474576f,
+    1.06666672f, 1.04918027f, 1.03225803f, 1.01587307f,
+    1.0f, 0.984615386f, 0.969696999f, 0.955223858f,
+    0.941176474f, 0.927536249f, 0.914285719f, 0.901408434f,
+    0.888888896f, 0.876712322f, 0.864864886f, 0.853333354f,
+    0.842105269f, 0.83116883f, 0.820512831f, 0.810126603f,
+    0.800000012f, 0.790123463f, 0.780487776f, 0.771084309f,
+    0.761904776f, 0.752941191f, 0.744186044f, 0.735632181f,
+    0.727272749f, 0.719101131f, 0.711111128f, 0.703296721f,
+    0.695652187f, 0.688172042f, 0.680851042f, 0.673684239f,
+    0.666666687f
+};
+
+// CORDIC Angle Table
+// atan(2^-i) in Q2.62, the angle each rotation step turns by, carried 30 bits past the result
+// so the rounding of every step stays out of it
+static const int64_t sciCordicAngles[SCI_CORDIC_STEPS] = {
+    3622009729038561421LL, 2138197195906305897LL, 1129764675555192497LL,
+    573486189672913778LL, 287855953345232185LL, 144068303048368715LL,
+    72051730834756822LL, 36028064038054493LL, 18014306884351854LL,
+    9007187801521084LL, 4503598195715550LL, 2251799634728303LL,
+    1125899884473003LL, 562949950625109LL, 281474976361131LL,
+    140737488311637LL, 70368744172203LL, 35184372088149LL,
+    17592186044331LL, 8796093022197LL, 4398046511103LL,
+    2199023255552LL, 1099511627776LL, 549755813888LL,
+    274877906944LL, 137438953472LL, 68719476736LL,
+    34359738368LL, 17179869184LL, 8589934592LL,
+    4294967296LL, 2147483648LL, 1073741824LL,
+    536870912LL
+};
+
+// Shift-and-Add Logarithm Table
+// ln(1 + 2^-i) in Q32.32 for i from 1, multiplying by (1 + 2^-i) is a shift and an add
+static const uint32_t sciFixedLnTable[SCI_FIXED_LN_STEPS] = {
+    1741459379u, 958394255u, 505874286u, 260380768u,
+    132163268u, 66589974u, 33424039u, 16744533u,
+    8380427u, 4192257u, 2096640u, 1048448u,
+    524256u, 262136u, 131070u, 65536u,
+    32768u, 16384u, 8192u, 4096u,
+    2048u, 1024u, 512u, 256u,
+    128u, 64u, 32u, 16u,
+    8u, 4u, 2u, 1u
+};
+
+// Applies a scientific function to a float
+// each kernel reduces its argument onto a small table and finishes with a short polynomial
+// @ param function - one of the SCI function values
+// @ param x - the argument
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN, or SCI_ERROR_OVERFLOW if the result is not finite
+int sci_float(int function, float x, float * result) {
+
+    float r;
+    float other;
+    int status;
+
+    // infinities and NaNs are outside every domain
+    if (x - x != 0.0f) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    switch (function) {
+
+        case SCI_SQRT:
+            status = sci_sqrtf(x, &r);
+            break;
+
+        case SCI_SIN:
+            status = sci_sincosf(x, &r, &other);
+            break;
+
+        case SCI_COS:
+            status = sci_sincosf(x, &other, &r);
+            break;
+
+        case SCI_TAN:
+            status = sci_sincosf(x, &r, &other);
+            if (status == SCI_OK) {
+                if (other == 0.0f) {
+                    return SCI_ERROR_OVERFLOW;
+                }
+                r = r / other;
+            }
+            break;
+
+        case SCI_EXP:
+            status = sci_expf(x, &r);
+            break;
+
+        case SCI_LN:
+            status = sci_logf(x, &r);
+            break;
+
+        default:
+            return SCI_ERROR_DOMAIN;
+    }
+
+    if (status != SCI_OK) {
+        return status;
+    }
+
+    if (r - r != 0.0f) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    * result = r;
+
+    return SCI_OK;
+}
+
+// Raises a float to a float power
+// negative bases only take whole exponents, where the sign comes from the exponent's parity
+// @ param x - the base
+// @ param y - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN, or SCI_ERROR_OVERFLOW if the result is not finite
+int sci_float_pow(float x, float y, float * result) {
+
+    if (x - x != 0.0f || y - y != 0.0f) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    if (y >= -SCI_POW_INT_MAX && y <= SCI_POW_INT_MAX && y == (float) (int32_t) y) {
+        return sci_float_pow_int(x, (int32_t) y, result);
+    }
+
+    if (x == 0.0f) {
+        if (y < 0.0f) {
+            return SCI_ERROR_DOMAIN;
+        }
+        * result = 0.0f;
+        return SCI_OK;
+    }
+
+    // every float of 2^24 or more is an even integer
+    float sign = 1.0f;
+
+    if (x < 0.0f) {
+        if (y > -16777216.0f && y < 16777216.0f) {
+            if (y != (float) (int32_t) y) {
+                return SCI_ERROR_DOMAIN;
+            }
+            if ((int32_t) y & 1) {
+                sign = -1.0f;
+            }
+        }
+        x = -x;
+    }
+
+    float ln;
+    sci_logf(x, &ln);
+
+    float r;
+    int status = sci_expf(y * ln, &r);
+
+    if (status != SCI_OK) {
+        return status;
+    }
+
+    if (r - r != 0.0f) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    * result = sign * r;
+
+    return SCI_OK;
+}
+
+// Applies a scientific function to a Q32.32 fixed point value
+// trig rotates with CORDIC and exp and ln multiply by (1 + 2^-i) factors, all shifts and adds
+// @ param function - one of the SCI function values
+// @ param x - the argument
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN, or SCI_ERROR_OVERFLOW if the result does not fit
+int sci_fixed(int function, int64_t x, int64_t * result) {
+
+    int64_t sine;
+    int64_t cosine;
+    int status;
+
+    switch (function) {
+
+        case SCI_SQRT:
+            return sci_fixed_sqrt(x, result);
+
+        case SCI_SIN:
+        case SCI_COS:
+            status = sci_fixed_sincos(x, &sine, &cosine);
+            if (status == SCI_OK) {
+                * result = function == SCI_SIN ? sine : cosine;
+            }
+            return status;
+
+        // the sine has room to shift up 30 bits, the last 2 bits of the quotient come from the remainder
+        case SCI_TAN:
+            status = sci_fixed_sincos(x, &sine, &cosine);
+            if (status == SCI_OK) {
+                if (cosine == 0) {
+                    return SCI_ERROR_OVERFLOW;
+                }
+                int64_t quotient = sine * (SCI_FIXED_ONE >> 2) / cosine;
+                int64_t remainder = sine * (SCI_FIXED_ONE >> 2) % cosine;
+                * result = quotient * 4 + remainder * 4 / cosine;
+            }
+            return status;
+
+        case SCI_EXP:
+            return sci_fixed_exp(x, result);
+
+        case SCI_LN:
+            return sci_fixed_ln(x, result);
+
+        default:
+            return SCI_ERROR_DOMAIN;
+    }
+}
+
+// Raises a Q32.32 fixed point value to a fixed point power
+// @ param x - the base
+// @ param y - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN, or SCI_ERROR_OVERFLOW if the result does not fit
+int sci_fixed_pow(int64_t x, int64_t y, int64_t * result) {
+
+    if ((y & (SCI_FIXED_ONE - 1)) == 0 && y >= -SCI_POW_INT_MAX * SCI_FIXED_ONE && y <= SCI_POW_INT_MAX * SCI_FIXED_ONE) {
+        return sci_fixed_pow_int(x, (int32_t) (y >> 32), result);
+    }
+
+    if (x == 0) {
+        if (y <= 0) {
+            return SCI_ERROR_DOMAIN;
+        }
+        * result = 0;
+        return SCI_OK;
+    }
+
+    // negative bases only take whole exponents, where the sign comes from the exponent's parity
+    int negative = 0;
+
+    if (x < 0) {
+        if (y & (SCI_FIXED_ONE - 1)) {
+            return SCI_ERROR_DOMAIN;
+        }
+        negative = (y >> 32) & 1;
+        x = -x;
+    }
+
+    int64_t ln;
+    sci_fixed_ln(x, &ln);
+
+    // a product too large to hold is far past overflow when positive and rounds to zero when negative
+    int64_t product;
+    if (sci_fixed_mul(y, ln, &product) != SCI_OK) {
+        if ((y < 0) == (ln < 0)) {
+            return SCI_ERROR_OVERFLOW;
+        }
+        * result = 0;
+        return SCI_OK;
+    }
+
+    int64_t r;
+    int status = sci_fixed_exp(product, &r);
+
+    if (status == SCI_OK) {
+        * result = negative ? -r : r;
+    }
+
+    return status;
+}
+
+// Applies a scientific function to a decimal
+// the argument converts to fixed point and back, except square roots, which are exact while they fit
+// @ param function - one of the SCI function values
+// @ param x - the argument
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN, or SCI_ERROR_OVERFLOW if the result does not fit
+int sci_decimal(int function, int64_t x, int64_t * result) {
+
+    if (function == SCI_SQRT) {
+
+        if (x < 0) {
+            return SCI_ERROR_DOMAIN;
+        }
+
+        // sqrt(x / 10^places) * 10^places is the integer square root of x * 10^places
+        int64_t scale;
+        uint64_t square;
+        decimal_from_digits(1, 0, &scale);
+
+        if (!__builtin_mul_overflow((uint64_t) x, (uint64_t) scale, &square)) {
+
+            uint64_t root = sci_isqrt(square);
+
+            // an integer square root is never exactly halfway, so round up past root^2 + root
+            if (square - root * root > root) {
+                root++;
+            }
+
+            * result = root;
+            return SCI_OK;
+        }
+    }
+
+    int64_t fixed;
+    int status = sci_decimal_to_fixed(x, &fixed);
+
+    if (status == SCI_OK) {
+        status = sci_fixed(function, fixed, &fixed);
+    }
+
+    if (status == SCI_OK) {
+        status = sci_fixed_to_decimal(fixed, result);
+    }
+
+    return status;
+}
+
+// Raises a decimal to a decimal power
+// whole numbers to whole powers are exact, everything else goes through fixed point
+// @ param x - the base
+// @ param y - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN, or SCI_ERROR_OVERFLOW if the result does not fit
+int sci_decimal_pow(int64_t x, int64_t y, int64_t * result) {
+
+    int64_t scale;
+    decimal_from_digits(1, 0, &scale);
+
+    if (x % scale == 0 && y % scale == 0 && y >= 0) {
+
+        int64_t power;
+
+        if (arith_int(ARITH_TYPE_INT64, '^', x / scale, y / scale, &power) != ARITH_OK ||
+            __builtin_mul_overflow(power, scale, &power)) {
+            return SCI_ERROR_OVERFLOW;
+        }
+
+        * result = power;
+        return SCI_OK;
+    }
+
+    int64_t fixedX;
+    int64_t fixedY;
+    int status = sci_decimal_to_fixed(x, &fixedX);
+
+    if (status == SCI_OK) {
+        status = sci_decimal_to_fixed(y, &fixedY);
+    }
+
+    if (status == SCI_OK) {
+        status = sci_fixed_pow(fixedX, fixedY, &fixedX);
+    }
+
+    if (status == SCI_OK) {
+        status = sci_fixed_to_decimal(fixedX, result);
+    }
+
+    return status;
+}
+
+// Applies a scientific function to an integer
+// only the square root has an integer result worth showing, truncated toward zero
+// @ param function - one of the SCI function values
+// @ param x - the argument
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, or SCI_ERROR_DOMAIN for a negative root or any other function
+int sci_int(int function, int64_t x, int64_t * result) {
+
+    if (function != SCI_SQRT || x < 0) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    * result = sci_isqrt(x);
+
+    return SCI_OK;
+}
+
+// Rounds a float to the nearest integer, halfway cases away from zero
+// @ param x - the float, within the range of an int32_t
+// @ return the nearest integer
+static int32_t sci_nearest(float x) {
+    return (int32_t) (x < 0.0f ? x - 0.5f : x + 0.5f);
+}
+
+// Builds a power of two as a float straight from its exponent bits
+// @ param exponent - the power, -126 to 127
+// @ return 2^exponent
+static float sci_pow2(int32_t exponent) {
+    union { uint32_t u; float f; } pun = { (uint32_t) (exponent + 127) << 23 };
+    return pun.f;
+}
+
+// Takes the square root of a float with the FPU's VSQRT instruction
+// @ param x - the argument
+// @ param result - where to store the result
+// @ return SCI_OK, or SCI_ERROR_DOMAIN if the argument is negative
+static int sci_sqrtf(float x, float * result) {
+
+    if (x < 0.0f) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+# if defined(__ARM_FP)
+    __asm__ ("vsqrt.f32 %0, %1" : "=t" (* result) : "t" (x));
+# else
+    * result = __builtin_sqrtf(x);
+# endif
+
+    return SCI_OK;
+}
+
+// Takes the sine and cosine of a float
+// the angle reduces to a table entry k * pi / 32 and a remainder under pi / 64, then the angle sum
+// identities combine the table with short Taylor series of the remainder
+// @ param x - the angle in radians
+// @ param sine - where to store the sine
+// @ param cosine - where to store the cosine
+// @ return SCI_OK, or SCI_ERROR_DOMAIN if the angle is 2^30 or more
+static int sci_sincosf(float x, float * sine, float * cosine) {
+
+    int32_t offset = 0;
+
+    // larger angles first reduce by pi / 2 in fixed point, which holds every float this large exactly,
+    // with pi / 2 carried to 96 fraction bits so up to 2^30 quarter turns leave an error under 2^-66
+    // and results near a zero keep their precision
+    if (x >= SCI_FLOAT_TRIG_SMALL || x <= -SCI_FLOAT_TRIG_SMALL) {
+
+        if (x >= SCI_FLOAT_TRIG_MAX || x <= -SCI_FLOAT_TRIG_MAX) {
+            return SCI_ERROR_DOMAIN;
+        }
+
+        int32_t quadrant;
+        int64_t reduced = sci_fixed_reduce((int64_t) (x * 4294967296.0f), &quadrant);
+
+        // the reduction floors away the low word of n * pi / 2, put it back as a fraction along with
+        // the tail of pi / 2 past it, both in units of 2^-64
+        int64_t floored = (int64_t) (uint32_t) ((int64_t) quadrant * SCI_FIXED_HALF_PI_LOW) +
+                          (((int64_t) quadrant * SCI_FIXED_HALF_PI_TAIL) >> 32);
+
+        x = ((float) reduced - (float) floored * (1.0f / 4294967296.0f)) * (1.0f / 4294967296.0f);
+        offset = quadrant * (SCI_SIN_TABLE_SIZE / 4);
+    }
+
+    int32_t n = sci_nearest(x * SCI_FLOAT_32_OVER_PI);
+
+    float r = x - (float) n * SCI_FLOAT_PI_32_A;
+    r = r - (float) n * SCI_FLOAT_PI_32_B;
+    r = r - (float) n * SCI_FLOAT_PI_32_C;
+
+    int32_t k = (n + offset) & (SCI_SIN_TABLE_SIZE - 1);
+    float sk = sciSinTable[k];
+    float ck = sciSinTable[(k + SCI_SIN_TABLE_SIZE / 4) & (SCI_SIN_TABLE_SIZE - 1)];
+
+    // sin(r) and cos(r) - 1, the terms past these are below float precision for |r| < pi / 64
+    float r2 = r * r;
+    float sr = r + r * r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f));
+    float cr = r2 * (-0.5f + r2 * (1.0f / 24.0f));
+
+    * sine = sk + (sk * cr + ck * sr);
+    * cosine = ck + (ck * cr - sk * sr);
+
+    return SCI_OK;
+}
+
+// Raises e to a float power
+// the exponent reduces to n * ln(2) / 32 and a remainder under ln(2) / 64, so the result is
+// 2^(n / 32) from the table and a power of two, times a short Taylor series of the remainder
+// @ param x - the exponent
+// @ param result - where to store the result
+// @ return SCI_OK, or SCI_ERROR_OVERFLOW if the result is larger than a float
+static int sci_expf(float x, float * result) {
+
+    if (x > SCI_FLOAT_EXP_MAX) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    if (x < SCI_FLOAT_EXP_MIN) {
+        * result = 0.0f;
+        return SCI_OK;
+    }
+
+    int32_t n = sci_nearest(x * SCI_FLOAT_32_OVER_LN2);
+
+    float r = x - (float) n * SCI_FLOAT_LN2_32_A;
+    r = r - (float) n * SCI_FLOAT_LN2_32_B;
+
+    int32_t j = n & (SCI_EXP2_TABLE_SIZE - 1);
+    int32_t k = (n - j) / SCI_EXP2_TABLE_SIZE;
+
+    // e^r - 1
+    float p = r + r * r * (0.5f + r * (1.0f / 6.0f + r * (1.0f / 24.0f)));
+    float y = sciExp2Table[j] + sciExp2Table[j] * p;
+
+    // scale in two halves so 2^128 is never needed on its own
+    y = y * sci_pow2(k / 2);
+    y = y * sci_pow2(k - k / 2);
+
+    * result = y;
+
+    return SCI_OK;
+}
+
+// Takes the natural logarithm of a float
+// the argument splits into 2^e * m with m from 0.75 to 1.5, and m into the nearest table entry c
+// and a ratio m / c under 1 + 1 / 96, whose logarithm is a short Taylor series
+// @ param x - the argument
+// @ param result - where to store the result
+// @ return SCI_OK, or SCI_ERROR_DOMAIN if the argument is not positive
+static int sci_logf(float x, float * result) {
+
+    if (!(x > 0.0f)) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    union { float f; uint32_t u; } pun = { x };
+    int32_t e = 0;
+
+    // subnormals scale up by 2^23 to get a leading one
+    if ((pun.u >> 23) == 0) {
+        pun.f = x * 8388608.0f;
+        e = -23;
+    }
+
+    e += (int32_t) (pun.u >> 23) - 127;
+    pun.u = (pun.u & 0x007FFFFF) | 0x3F800000;
+
+    float m = pun.f;
+
+    if (m >= 1.5f) {
+        m = m * 0.5f;
+        e++;
+    }
+
+    // m - 0.75 and m - c are both exact, c is never more than a factor of two away from m
+    int32_t j = sci_nearest((m - 0.75f) * 64.0f);
+    float c = 0.75f + (float) j * (1.0f / 64.0f);
+    float t = (m - c) * sciLnInverseTable[j];
+
+    // ln(1 + t)
+    float p = t - t * t * (0.5f - t * (1.0f / 3.0f - t * 0.25f));
+
+    * result = (float) e * SCI_FLOAT_LN2_A + (sciLnTable[j] + ((float) e * SCI_FLOAT_LN2_B + p));
+
+    return SCI_OK;
+}
+
+// Raises a float to a whole power by repeated squaring
+// @ param x - the base
+// @ param exponent - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN for zero to a negative power, or SCI_ERROR_OVERFLOW
+static int sci_float_pow_int(float x, int32_t exponent, float * result) {
+
+    if (x == 0.0f && exponent < 0) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    uint32_t remaining = exponent < 0 ? -exponent : exponent;
+    float accumulator = 1.0f;
+    float base = x;
+
+    while (remaining != 0) {
+        if (remaining & 1) {
+            accumulator = accumulator * base;
+        }
+        remaining >>= 1;
+        if (remaining != 0) {
+            base = base * base;
+        }
+    }
+
+    if (exponent < 0) {
+        accumulator = 1.0f / accumulator;
+    }
+
+    if (accumulator - accumulator != 0.0f) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    * result = accumulator;
+
+    return SCI_OK;
+}
+
+// Multiplies two Q32.32 fixed point values
+// the 128-bit product is built from four 32-bit UMULL partial products and rounded to 32 fraction bits
+// @ param a - the left operand
+// @ param b - the right operand
+// @ param result - where to store the product, untouched on error
+// @ return SCI_OK, or SCI_ERROR_OVERFLOW if the product does not fit
+static int sci_fixed_mul(int64_t a, int64_t b, int64_t * result) {
+
+    int negative = (a < 0) != (b < 0);
+    uint64_t aMagnitude = a < 0 ? -(uint64_t) a : (uint64_t) a;
+    uint64_t bMagnitude = b < 0 ? -(uint64_t) b : (uint64_t) b;
+
+    uint64_t aLow = (uint32_t) aMagnitude;
+    uint64_t aHigh = aMagnitude >> 32;
+    uint64_t bLow = (uint32_t) bMagnitude;
+    uint64_t bHigh = bMagnitude >> 32;
+
+    uint64_t low = aLow * bLow;
+    uint64_t high = aHigh * bHigh;
+
+    if (high >> 31) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    // the product shifted down 32 bits, rounded on the bit below
+    uint64_t product = high << 32;
+
+    if (__builtin_add_overflow(product, aLow * bHigh, &product) ||
+        __builtin_add_overflow(product, aHigh * bLow, &product) ||
+        __builtin_add_overflow(product, (low >> 32) + ((low >> 31) & 1), &product) ||
+        product > INT64_MAX) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    * result = negative ? -(int64_t) product : (int64_t) product;
+
+    return SCI_OK;
+}
+
+// Raises a Q32.32 fixed point value to a whole power by repeated squaring
+// @ param x - the base
+// @ param exponent - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, SCI_ERROR_DOMAIN for zero to a negative power, or SCI_ERROR_OVERFLOW
+static int sci_fixed_pow_int(int64_t x, int32_t exponent, int64_t * result) {
+
+    if (x == 0 && exponent < 0) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    uint32_t remaining = exponent < 0 ? -exponent : exponent;
+    int64_t accumulator = SCI_FIXED_ONE;
+    int64_t base = x;
+
+    // a square only overflows when the power still needs it, so every overflow is a real one
+    while (remaining != 0) {
+        if ((remaining & 1) && sci_fixed_mul(accumulator, base, &accumulator) != SCI_OK) {
+            return SCI_ERROR_OVERFLOW;
+        }
+        remaining >>= 1;
+        if (remaining != 0 && sci_fixed_mul(base, base, &base) != SCI_OK) {
+            return SCI_ERROR_OVERFLOW;
+        }
+    }
+
+    // the reciprocal of a Q32.32 value is 2^64 divided by it, rounded, anything 2^-31 or smaller has
+    // a reciprocal too large to hold
+    if (exponent < 0) {
+
+        uint64_t magnitude = accumulator < 0 ? -(uint64_t) accumulator : (uint64_t) accumulator;
+
+        if (magnitude <= 2) {
+            return SCI_ERROR_OVERFLOW;
+        }
+
+        uint64_t reciprocal = UINT64_MAX / magnitude;
+        uint64_t remainder = UINT64_MAX % magnitude + 1;
+
+        if (remainder >= magnitude) {
+            reciprocal++;
+            remainder -= magnitude;
+        }
+
+        if (remainder >= magnitude - remainder) {
+            reciprocal++;
+        }
+
+        accumulator = accumulator < 0 ? -(int64_t) reciprocal : (int64_t) reciprocal;
+    }
+
+    * result = accumulator;
+
+    return SCI_OK;
+}
+
+// Reduces a Q32.32 angle to within pi / 4 of a multiple of pi / 2
+// pi / 2 is carried to 64 fraction bits so the remainder keeps all 32 of its own
+// @ param x - the angle in radians, less than 2^30 in magnitude
+// @ param quadrant - where to store the multiple of pi / 2 taken away
+// @ return the remainder
+static int64_t sci_fixed_reduce(int64_t x, int32_t * quadrant) {
+
+    int64_t scaled;
+    sci_fixed_mul(x, SCI_FIXED_TWO_OVER_PI, &scaled);
+
+    int32_t n = (int32_t) ((scaled + (SCI_FIXED_ONE / 2)) >> 32);
+
+    * quadrant = n;
+
+    return x - (int64_t) n * SCI_FIXED_HALF_PI - (((int64_t) n * SCI_FIXED_HALF_PI_LOW) >> 32);
+}
+
+// Takes the sine and cosine of a Q32.32 angle with a rotation mode CORDIC
+// the vector starts at the CORDIC gain on the x axis, so after every step it has unit length
+// @ param x - the angle in radians
+// @ param sine - where to store the sine
+// @ param cosine - where to store the cosine
+// @ return SCI_OK, or SCI_ERROR_DOMAIN if the angle is 2^30 or more
+static int sci_fixed_sincos(int64_t x, int64_t * sine, int64_t * cosine) {
+
+    if (x >= SCI_FIXED_TRIG_MAX || x <= -SCI_FIXED_TRIG_MAX) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    // the remainder is under pi / 4, so it has room to move up to Q2.62
+    int32_t quadrant;
+    int64_t z = sci_fixed_reduce(x, &quadrant) * ((int64_t) 1 << 30);
+    int64_t cx = SCI_CORDIC_GAIN;
+    int64_t cy = 0;
+
+    for (int i = 0; i < SCI_CORDIC_STEPS; i++) {
+
+        int64_t dx = cy >> i;
+        int64_t dy = cx >> i;
+
+        if (z >= 0) {
+            cx -= dx;
+            cy += dy;
+            z -= sciCordicAngles[i];
+        } else {
+            cx += dx;
+            cy -= dy;
+            z += sciCordicAngles[i];
+        }
+    }
+
+    // round back to Q32.32, then rotate by the quarter turns the reduction took away
+    cx = (cx + ((int64_t) 1 << 29)) >> 30;
+    cy = (cy + ((int64_t) 1 << 29)) >> 30;
+
+    switch (quadrant & 3) {
+
+        case 0:
+            * sine = cy;
+            * cosine = cx;
+            break;
+
+        case 1:
+            * sine = cx;
+            * cosine = -cy;
+            break;
+
+        case 2:
+            * sine = -cy;
+            * cosine = -cx;
+            break;
+
+        default:
+            * sine = -cx;
+            * cosine = cy;
+            break;
+    }
+
+    return SCI_OK;
+}
+
+// Raises e to a Q32.32 power
+// the exponent reduces to k * ln(2) plus a remainder r under ln(2), then e^r is built in Q2.61 by
+// taking each factor (1 + 2^-i) whose logarithm still fits in what is left of r
+// @ param x - the exponent
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, or SCI_ERROR_OVERFLOW if the result does not fit
+static int sci_fixed_exp(int64_t x, int64_t * result) {
+
+    if (x >= 31 * SCI_FIXED_LN2) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    if (x < -33 * SCI_FIXED_LN2) {
+        * result = 0;
+        return SCI_OK;
+    }
+
+    int64_t scaled;
+    sci_fixed_mul(x, SCI_FIXED_INV_LN2, &scaled);
+
+    int32_t k = (int32_t) (scaled >> 32);
+    int64_t r = x - k * SCI_FIXED_LN2;
+
+    // the reciprocal is rounded, so the remainder can land one step outside of [0, ln(2))
+    while (r < 0) {
+        r += SCI_FIXED_LN2;
+        k--;
+    }
+
+    while (r >= SCI_FIXED_LN2) {
+        r -= SCI_FIXED_LN2;
+        k++;
+    }
+
+    uint64_t y = (uint64_t) 1 << 61;
+
+    for (int i = 1; i <= SCI_FIXED_LN_STEPS; i++) {
+        if (r >= sciFixedLnTable[i - 1]) {
+            r -= sciFixedLnTable[i - 1];
+            y += y >> i;
+        }
+    }
+
+    // scale from Q2.61 and 2^k to Q32.32, rounding anything shifted out
+    int shift = 29 - k;
+
+    if (shift < 0) {
+        y <<= -shift;
+    } else if (shift > 0) {
+        y = (y + ((uint64_t) 1 << (shift - 1))) >> shift;
+    }
+
+    if (y > INT64_MAX) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    * result = (int64_t) y;
+
+    return SCI_OK;
+}
+
+// Takes the natural logarithm of a Q32.32 value
+// the argument normalizes to 2^k * m with m in [1, 2) held in Q2.61, then multiplies toward 2 by
+// each factor (1 + 2^-i) that keeps it below 2, so ln(m) is ln(2) less the logarithms of the factors
+// @ param x - the argument
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, or SCI_ERROR_DOMAIN if the argument is not positive
+static int sci_fixed_ln(int64_t x, int64_t * result) {
+
+    if (x <= 0) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    uint64_t m = (uint64_t) x;
+    int32_t k = 29;
+
+    while (m >= ((uint64_t) 1 << 62)) {
+        m >>= 1;
+        k++;
+    }
+
+    while (m < ((uint64_t) 1 << 61)) {
+        m <<= 1;
+        k--;
+    }
+
+    const uint64_t two = (uint64_t) 1 << 62;
+    int64_t sum = 0;
+
+    for (int i = 1; i <= SCI_FIXED_LN_STEPS; i++) {
+        uint64_t t = m + (m >> i);
+        if (t <= two) {
+            m = t;
+            sum += sciFixedLnTable[i - 1];
+        }
+    }
+
+    // what is left to reach 2 is ln(2 / m), about (2 - m) / 2, moved from Q2.61 to Q32.32
+    int64_t residual = (int64_t) ((two - m) >> 30);
+
+    * result = (int64_t) (k + 1) * SCI_FIXED_LN2 - sum - residual;
+
+    return SCI_OK;
+}
+
+// Takes the square root of a Q32.32 value
+// the argument shifts up by an even amount until its top two bits are occupied, so the integer root
+// always carries 32 significant bits, and a root that still needs fraction bits below those carries on
+// digit by digit from the remainder, as if the argument went on with zeros
+// @ param x - the argument
+// @ param result - where to store the result, untouched on error
+// @ return SCI_OK, or SCI_ERROR_DOMAIN if the argument is negative
+static int sci_fixed_sqrt(int64_t x, int64_t * result) {
+
+    if (x < 0) {
+        return SCI_ERROR_DOMAIN;
+    }
+
+    if (x == 0) {
+        * result = 0;
+        return SCI_OK;
+    }
+
+    uint64_t value = (uint64_t) x;
+    int shift = 0;
+
+    while (value < ((uint64_t) 1 << 62)) {
+        value <<= 2;
+        shift++;
+    }
+
+    // sqrt(x * 2^32) = sqrt(value) * 2^(16 - shift)
+    uint64_t root = sci_isqrt(value);
+
+    if (shift <= 16) {
+
+        // the remainder stays under twice the root, so it has room for the two bits each step adds
+        uint64_t remainder = value - root * root;
+
+        for (int i = shift; i < 16; i++) {
+            uint64_t trial = (root << 2) + 1;
+            remainder <<= 2;
+            root <<= 1;
+            if (remainder >= trial) {
+                remainder -= trial;
+                root++;
+            }
+        }
+
+        // (root + 1/2)^2 is below the argument exactly when the remainder is more than the root
+        if (remainder > root) {
+            root++;
+        }
+
+    } else {
+        root = (root + ((uint64_t) 1 << (shift - 17))) >> (shift - 16);
+    }
+
+    * result = (int64_t) root;
+
+    return SCI_OK;
+}
+
+// Converts a decimal to Q32.32 fixed point, rounding the fraction to the nearest 2^-32
+// @ param x - the decimal
+// @ param result - where to store the fixed point value, untouched on error
+// @ return SCI_OK, or SCI_ERROR_OVERFLOW if the whole part is 2^31 or more
+static int sci_decimal_to_fixed(int64_t x, int64_t * result) {
+
+    int64_t scale;
+    decimal_from_digits(1, 0, &scale);
+
+    uint64_t magnitude = x < 0 ? -(uint64_t) x : (uint64_t) x;
+    uint64_t whole = magnitude / scale;
+    uint64_t fraction = magnitude % scale;
+
+    if (whole >> 31) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    // the fraction is under 10^9, so it has room to shift up 32 bits
+    uint64_t fixed = (whole << 32) + ((fraction << 32) + scale / 2) / scale;
+
+    * result = x < 0 ? -(int64_t) fixed : (int64_t) fixed;
+
+    return SCI_OK;
+}
+
+// Converts a Q32.32 fixed point value to a decimal, rounding to the nearest decimal place
+// @ param x - the fixed point value
+// @ param result - where to store the decimal, untouched on error
+// @ return SCI_OK, or SCI_ERROR_OVERFLOW if the decimal does not fit
+static int sci_fixed_to_decimal(int64_t x, int64_t * result) {
+
+    int64_t scale;
+    decimal_from_digits(1, 0, &scale);
+
+    uint64_t magnitude = x < 0 ? -(uint64_t) x : (uint64_t) x;
+    uint64_t fraction = ((magnitude & 0xFFFFFFFF) * scale + 0x80000000) >> 32;
+    uint64_t value;
+
+    if (__builtin_mul_overflow(magnitude >> 32, (uint64_t) scale, &value) ||
+        __builtin_add_overflow(value, fraction, &value) ||
+        value > INT64_MAX) {
+        return SCI_ERROR_OVERFLOW;
+    }
+
+    * result = x < 0 ? -(int64_t) value : (int64_t) value;
+
+    return SCI_OK;
+}
+
+// Takes the integer square root of a 64-bit value one result bit at a time
+// @ param value - the value
+// @ return the square root, rounded down
+static uint64_t sci_isqrt(uint64_t value) {
+
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t) 1 << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
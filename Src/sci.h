@@ -0,0 +1,52 @@
+// file: sci.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for sci.c
+
+# ifndef SCI_H
+# define SCI_H
+
+# include <stdint.h>
+
+// Scientific Functions
+// contiguous so a function indexes from its first keymap action
+# define SCI_SQRT 0
+# define SCI_SIN 1
+# define SCI_COS 2
+# define SCI_TAN 3
+# define SCI_EXP 4
+# define SCI_LN 5
+# define SCI_FUNCTIONS 6
+
+// Fixed Point Format
+// fixed point values are signed Q32.32, 32 integer bits and 32 fraction bits in an int64_t
+# define SCI_FIXED_ONE ((int64_t) 1 << 32)
+
+// Scientific Status Codes
+# define SCI_OK 0
+# define SCI_ERROR_DOMAIN 1
+# define SCI_ERROR_OVERFLOW 2
+
+// Applies a scientific function to a float
+int sci_float(int function, float x, float * result);
+
+// Raises a float to a float power
+int sci_float_pow(float x, float y, float * result);
+
+// Applies a scientific function to a Q32.32 fixed point value
+int sci_fixed(int function, int64_t x, int64_t * result);
+
+// Raises a Q32.32 fixed point value to a fixed point power
+int sci_fixed_pow(int64_t x, int64_t y, int64_t * result);
+
+// Applies a scientific function to a decimal
+int sci_decimal(int function, int64_t x, int64_t * result);
+
+// Raises a decimal to a decimal power
+int sci_decimal_pow(int64_t x, int64_t y, int64_t * result);
+
+// Applies a scientific function to an integer
+int sci_int(int function, int64_t x, int64_t * result);
+
+# endif
@@ -0,0 +1,350 @@
+// file: storage.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a wear-leveled, power-loss safe record log over two flash sectors
+
+# include <stdint.h>
+# include <string.h>
+# include "storage.h"
+# include "flash.h"
+
+// Storage Sectors
+// the top two 128K sectors, which the linker script keeps the program out of
+# define STORAGE_SECTOR_A 6
+# define STORAGE_SECTOR_B 7
+
+// Sector Header
+// a sector is part of the log once its magic word is programmed, which happens after everything else
+// in it, and the valid sector with the higher sequence number is the active one
+# define STORAGE_MAGIC 0x31474F4C
+# define STORAGE_HEADER_BYTES 8
+# define STORAGE_ERASED 0xFFFFFFFF
+
+// Record Header
+// one word holding the key, the payload length, and a CRC-16 of both and the payload, followed by the
+// payload padded to a whole word, a record cut short by a power loss fails its CRC and is skipped
+# define STORAGE_KEY_MASK 0xFF
+# define STORAGE_LENGTH_SHIFT 8
+# define STORAGE_LENGTH_MASK 0xFF
+# define STORAGE_CRC_SHIFT 16
+# define STORAGE_NONE 0xFFFFFFFF
+
+// Function Prototypes
+static int storage_format(int index, uint32_t sequence);
+static int storage_erase(int index);
+static void storage_scan(void);
+static int storage_compact(void);
+static const uint32_t * storage_address(int index, uint32_t offset);
+static int storage_record_valid(const uint32_t * record, uint32_t room);
+static uint16_t storage_crc(uint16_t crc, const uint8_t * data, int length);
+
+// Storage State
+// the log is the active sector, records are appended at the write offset, and the newest intact record
+// of every key is remembered so reading never walks the log
+static const uint8_t storageSectors[2] = { STORAGE_SECTOR_A, STORAGE_SECTOR_B };
+static int storageActive = -1;
+static uint32_t storageSequence;
+static uint32_t storageOffset;
+static uint32_t storageNewest[STORAGE_KEYS];
+static char storageDamaged;
+
+// Finds the log in flash, formatting it if there is none
+// @ param void
+// @ return STORAGE_OK, or STORAGE_ERROR_FLASH if a new log could not be formatted
+int storage_init(void) {
+
+    storageActive = -1;
+    storageSequence = 0;
+
+    // the valid sector with the higher sequence wins, the other is either stale or a compaction cut short
+    for (int index = 0; index < 2; index++) {
+
+        const uint32_t * header = storage_address(index, 0);
+
+        if (header[0] == STORAGE_MAGIC && (storageActive < 0 || header[1] > storageSequence)) {
+            storageActive = index;
+            storageSequence = header[1];
+        }
+    }
+
+    if (storageActive < 0) {
+        if (storage_format(0, 1) != FLASH_OK) {
+            return STORAGE_ERROR_FLASH;
+        }
+    }
+
+    storage_scan();
+
+    return STORAGE_OK;
+}
+
+// Reads the newest record of a key
+// @ param key - the key, 0 to STORAGE_KEYS - 1
+// @ param buffer - where to copy the record
+// @ param size - the size of the buffer
+// @ param length - where to store the length of the record
+// @ return STORAGE_OK, STORAGE_ERROR_NOT_FOUND if the key has no record, or STORAGE_ERROR_LENGTH if it does not fit
+int storage_read(int key, void * buffer, int size, int * length) {
+
+    if (storageActive < 0 || key < 0 || key >= STORAGE_KEYS || storageNewest[key] == STORAGE_NONE) {
+        return STORAGE_ERROR_NOT_FOUND;
+    }
+
+    const uint32_t * record = storage_address(storageActive, storageNewest[key]);
+    int recordLength = (record[0] >> STORAGE_LENGTH_SHIFT) & STORAGE_LENGTH_MASK;
+
+    if (recordLength > size) {
+        return STORAGE_ERROR_LENGTH;
+    }
+
+    memcpy(buffer, record + 1, recordLength);
+    * length = recordLength;
+
+    return STORAGE_OK;
+}
+
+// Appends a record for a key, compacting the log first if it is full
+// a record identical to the newest one of its key is not written again, so saving often costs no wear
+// @ param key - the key, 0 to STORAGE_KEYS - 1
+// @ param data - the record
+// @ param length - the length of the record, at most STORAGE_RECORD_MAX
+// @ return STORAGE_OK, STORAGE_ERROR_LENGTH if the key or length is out of range, or STORAGE_ERROR_FLASH
+int storage_write(int key, const void * data, int length) {
+
+    if (storageActive < 0) {
+        return STORAGE_ERROR_FLASH;
+    }
+
+    if (key < 0 || key >= STORAGE_KEYS || length < 0 || length > STORAGE_RECORD_MAX) {
+        return STORAGE_ERROR_LENGTH;
+    }
+
+    if (storageNewest[key] != STORAGE_NONE) {
+        const uint32_t * newest = storage_address(storageActive, storageNewest[key]);
+        if (((newest[0] >> STORAGE_LENGTH_SHIFT) & STORAGE_LENGTH_MASK) == (uint32_t) length &&
+            memcmp(newest + 1, data, length) == 0) {
+            return STORAGE_OK;
+        }
+    }
+
+    // build the whole record first so it is programmed in one pass, padding with zeros
+    uint32_t record[1 + STORAGE_RECORD_MAX / 4];
+    int words = 1 + (length + 3) / 4;
+
+    record[words - 1] = 0;
+    memcpy(record + 1, data, length);
+
+    uint8_t keyLength[2] = { key, length };
+    uint16_t crc = storage_crc(0xFFFF, keyLength, 2);
+    crc = storage_crc(crc, (const uint8_t *) (record + 1), length);
+
+    record[0] = key | (length << STORAGE_LENGTH_SHIFT) | ((uint32_t) crc << STORAGE_CRC_SHIFT);
+
+    // a damaged tail cannot be appended to safely, and a full log makes room by dropping old records
+    uint32_t size = flash_sector_size(storageSectors[storageActive]);
+
+    if (storageDamaged || storageOffset + words * 4 > size) {
+        if (storage_compact() != STORAGE_OK || storageOffset + words * 4 > size) {
+            return STORAGE_ERROR_FLASH;
+        }
+    }
+
+    uint32_t offset = storageOffset;
+    storageOffset += words * 4;
+
+    if (flash_program(storage_address(storageActive, offset), record, words) != FLASH_OK) {
+        storageDamaged = 1;
+        return STORAGE_ERROR_FLASH;
+    }
+
+    storageNewest[key] = offset;
+
+    return STORAGE_OK;
+}
+
+// Erases a sector and makes it an empty log
+// @ param index - which of the two storage sectors to format
+// @ param sequence - the sequence number the log gets
+// @ return FLASH_OK, or FLASH_ERROR if the sector could not be erased or programmed
+static int storage_format(int index, uint32_t sequence) {
+
+    if (storage_erase(index) != FLASH_OK) {
+        return FLASH_ERROR;
+    }
+
+    // the magic word is programmed last, so a sector is never valid before its sequence is
+    uint32_t magic = STORAGE_MAGIC;
+
+    if (flash_program(storage_address(index, 4), &sequence, 1) != FLASH_OK ||
+        flash_program(storage_address(index, 0), &magic, 1) != FLASH_OK) {
+        return FLASH_ERROR;
+    }
+
+    storageActive = index;
+    storageSequence = sequence;
+
+    return FLASH_OK;
+}
+
+// Erases one of the storage sectors
+// an erase cut short leaves any mix of old and erased words, so the magic word is cleared first to keep a
+// stale sector from coming back with an erased, and so higher, sequence number
+// @ param index - which of the two storage sectors to erase
+// @ return FLASH_OK, or FLASH_ERROR if the sector could not be erased
+static int storage_erase(int index) {
+
+    uint32_t retired = 0;
+
+    if (* storage_address(index, 0) != STORAGE_ERASED &&
+        flash_program(storage_address(index, 0), &retired, 1) != FLASH_OK) {
+        return FLASH_ERROR;
+    }
+
+    return flash_erase_sector(storageSectors[index]);
+}
+
+// Walks the active sector to find the newest intact record of every key and where the log ends
+// @ param void
+// @ return void
+static void storage_scan(void) {
+
+    uint32_t size = flash_sector_size(storageSectors[storageActive]);
+    uint32_t offset = STORAGE_HEADER_BYTES;
+
+    for (int key = 0; key < STORAGE_KEYS; key++) {
+        storageNewest[key] = STORAGE_NONE;
+    }
+
+    storageDamaged = 0;
+
+    while (offset + 4 <= size) {
+
+        const uint32_t * record = storage_address(storageActive, offset);
+
+        // the first erased header is the end of the log
+        if (record[0] == STORAGE_ERASED) {
+            break;
+        }
+
+        // a header torn by a power loss may claim more than the sector holds, nothing after it can be trusted
+        uint32_t words = 1 + ((((record[0] >> STORAGE_LENGTH_SHIFT) & STORAGE_LENGTH_MASK) + 3) / 4);
+
+        if (offset + words * 4 > size) {
+            storageDamaged = 1;
+            break;
+        }
+
+        if (storage_record_valid(record, size - offset)) {
+            storageNewest[record[0] & STORAGE_KEY_MASK] = offset;
+        }
+
+        offset += words * 4;
+    }
+
+    storageOffset = offset;
+}
+
+// Copies the newest record of every key into the other sector and makes it the active one
+// the old sector stays valid until the new one is complete, so a power loss at any point loses nothing,
+// which is also why the record of a key about to be written is copied too
+// @ param void
+// @ return STORAGE_OK, or STORAGE_ERROR_FLASH if the other sector could not be erased or programmed
+static int storage_compact(void) {
+
+    int source = storageActive;
+    int target = 1 - source;
+
+    if (storage_erase(target) != FLASH_OK) {
+        return STORAGE_ERROR_FLASH;
+    }
+
+    uint32_t offset = STORAGE_HEADER_BYTES;
+    uint32_t newest[STORAGE_KEYS];
+
+    for (int key = 0; key < STORAGE_KEYS; key++) {
+
+        newest[key] = STORAGE_NONE;
+
+        if (storageNewest[key] == STORAGE_NONE) {
+            continue;
+        }
+
+        const uint32_t * record = storage_address(source, storageNewest[key]);
+        int words = 1 + (((record[0] >> STORAGE_LENGTH_SHIFT) & STORAGE_LENGTH_MASK) + 3) / 4;
+
+        if (flash_program(storage_address(target, offset), record, words) != FLASH_OK) {
+            return STORAGE_ERROR_FLASH;
+        }
+
+        newest[key] = offset;
+        offset += words * 4;
+    }
+
+    // the magic word commits the new sector
+    uint32_t sequence = storageSequence + 1;
+    uint32_t magic = STORAGE_MAGIC;
+
+    if (flash_program(storage_address(target, 4), &sequence, 1) != FLASH_OK ||
+        flash_program(storage_address(target, 0), &magic, 1) != FLASH_OK) {
+        return STORAGE_ERROR_FLASH;
+    }
+
+    storageActive = target;
+    storageSequence = sequence;
+    storageOffset = offset;
+    storageDamaged = 0;
+
+    for (int key = 0; key < STORAGE_KEYS; key++) {
+        storageNewest[key] = newest[key];
+    }
+
+    return STORAGE_OK;
+}
+
+// Gets the address of a byte offset into one of the storage sectors
+// @ param index - which of the two storage sectors
+// @ param offset - the word-aligned byte offset
+// @ return the address
+static const uint32_t * storage_address(int index, uint32_t offset) {
+    return flash_sector_address(storageSectors[index]) + offset / 4;
+}
+
+// Checks whether a record is intact
+// @ param record - the record
+// @ param room - the bytes left in the sector from the record on
+// @ return 1 if its key is in range and its CRC matches, otherwise 0
+static int storage_record_valid(const uint32_t * record, uint32_t room) {
+
+    uint32_t key = record[0] & STORAGE_KEY_MASK;
+    uint32_t length = (record[0] >> STORAGE_LENGTH_SHIFT) & STORAGE_LENGTH_MASK;
+
+    if (key >= STORAGE_KEYS || length > STORAGE_RECORD_MAX || 4 + length > room) {
+        return 0;
+    }
+
+    uint8_t keyLength[2] = { key, length };
+    uint16_t crc = storage_crc(0xFFFF, keyLength, 2);
+    crc = storage_crc(crc, (const uint8_t *) (record + 1), length);
+
+    return crc == (record[0] >> STORAGE_CRC_SHIFT);
+}
+
+// Continues a CRC-16/CCITT over more data
+// @ param crc - the CRC so far, 0xFFFF to start
+// @ param data - the data
+// @ param length - the number of bytes
+// @ return the updated CRC
+static uint16_t storage_crc(uint16_t crc, const uint8_t * data, int length) {
+
+    for (int i = 0; i < length; i++) {
+
+        crc ^= (uint16_t) data[i] << 8;
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
@@ -0,0 +1,32 @@
+// file: storage.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for storage.c
+
+# ifndef STORAGE_H
+# define STORAGE_H
+
+# include <stdint.h>
+
+// Storage Limits
+// records are looked up by a small key and hold at most STORAGE_RECORD_MAX bytes
+# define STORAGE_KEYS 8
+# define STORAGE_RECORD_MAX 252
+
+// Storage Status Codes
+# define STORAGE_OK 0
+# define STORAGE_ERROR_NOT_FOUND 1
+# define STORAGE_ERROR_LENGTH 2
+# define STORAGE_ERROR_FLASH 3
+
+// Finds the log in flash, formatting it if there is none
+int storage_init(void);
+
+// Reads the newest record of a key
+int storage_read(int key, void * buffer, int size, int * length);
+
+// Appends a record for a key, compacting the log first if it is full
+int storage_write(int key, const void * data, int length);
+
+# endif
@@ -0,0 +1,30 @@
+// file: system.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains the core setup the startup code runs before static initialization and main
+
+# include <stdint.h>
+# include "system.h"
+
+// SCB Addresses
+# define SCB_CPACR 0xE000ED88
+
+// SCB Values
+// full access to coprocessors 10 and 11, which together are the FPU
+# define SCB_CPACR_CP10_CP11_FULL (0xF << 20)
+
+// Prepares the core before the C runtime starts, called from the startup code
+// the build uses the hard float ABI, so the FPU has to be on before any code that might touch it
+// @ param void
+// @ return void
+void SystemInit(void) {
+
+    // enable the FPU
+    uint32_t * scbCPACR = (uint32_t *) SCB_CPACR;
+    * scbCPACR |= SCB_CPACR_CP10_CP11_FULL;
+
+    // make sure the enable has taken effect before the next instruction
+    __asm volatile ("dsb");
+    __asm volatile ("isb");
+}
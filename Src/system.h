@@ -0,0 +1,13 @@
+// file: system.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for system.c
+
+# ifndef SYSTEM_H
+# define SYSTEM_H
+
+// Prepares the core before the C runtime starts, called from the startup code
+void SystemInit(void);
+
+# endif
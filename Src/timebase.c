@@ -0,0 +1,135 @@
+// file: timebase.c
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Contains a free-running microsecond counter built on TIM2 for timestamps and statistics, and the core cycle counter for benchmarks
+
+# include <stdint.h>
+# include "timebase.h"
+# include "irq.h"
+
+// RCC Addresses
+# define RCC_BASE 0x40023800
+# define RCC_APB1ENR (RCC_BASE + 0x40)
+
+// RCC Values
+# define RCC_APB1ENR_TIM2EN (1 << 0)
+
+// TIM2 Addresses
+# define TIM2_BASE 0x40000000
+# define TIM2_CR1 (TIM2_BASE + 0x00)
+# define TIM2_DIER (TIM2_BASE + 0x0C)
+# define TIM2_SR (TIM2_BASE + 0x10)
+# define TIM2_EGR (TIM2_BASE + 0x14)
+# define TIM2_CNT (TIM2_BASE + 0x24)
+# define TIM2_PSC (TIM2_BASE + 0x28)
+# define TIM2_ARR (TIM2_BASE + 0x2C)
+# define TIM2_CCR1 (TIM2_BASE + 0x34)
+
+// DWT Addresses
+# define DWT_BASE 0xE0001000
+# define DWT_CTRL (DWT_BASE + 0x00)
+# define DWT_CYCCNT (DWT_BASE + 0x04)
+# define DEMCR 0xE000EDFC
+
+// DWT Values
+# define DWT_CTRL_CYCCNTENA (1 << 0)
+# define DEMCR_TRCENA (1 << 24)
+
+// TIM2 Values
+# define TIM_CR1_CEN (1 << 0)
+# define TIM_EGR_UG (1 << 0)
+# define TIM_DIER_CC1IE (1 << 1)
+# define TIM_SR_CC1IF (1 << 1)
+# define TIM2_PSC_1MHZ 15
+# define TIM2_ARR_MAX 0xFFFFFFFF
+
+// Register Pointers
+static volatile uint32_t * const tim2CNT = (uint32_t *) TIM2_CNT;
+static volatile uint32_t * const tim2DIER = (uint32_t *) TIM2_DIER;
+static volatile uint32_t * const tim2SR = (uint32_t *) TIM2_SR;
+static volatile uint32_t * const tim2CCR1 = (uint32_t *) TIM2_CCR1;
+static volatile uint32_t * const dwtCYCCNT = (uint32_t *) DWT_CYCCNT;
+
+// Starts the free-running microsecond counter
+// the 32-bit counter wraps about every 71 minutes, so only differences between readings are meaningful
+// @ param void
+// @ return void
+void timebase_init(void) {
+
+    // enable TIM2 in RCC
+    uint32_t * rccAPB1ENR = (uint32_t *) RCC_APB1ENR;
+    * rccAPB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    // count at 1 MHz from the 16 MHz timer clock across the full 32-bit range
+    uint32_t * tim2PSC = (uint32_t *) TIM2_PSC;
+    uint32_t * tim2ARR = (uint32_t *) TIM2_ARR;
+    * tim2PSC = TIM2_PSC_1MHZ;
+    * tim2ARR = TIM2_ARR_MAX;
+
+    // load the prescaler and start counting
+    uint32_t * tim2EGR = (uint32_t *) TIM2_EGR;
+    uint32_t * tim2CR1 = (uint32_t *) TIM2_CR1;
+    * tim2EGR = TIM_EGR_UG;
+    * tim2CR1 |= TIM_CR1_CEN;
+
+    // the alarm only wakes the core, so it sits below everything that does real work
+    irq_set_priority(IRQ_TIM2, IRQ_PRIORITY_BACKGROUND, 0);
+    irq_enable(IRQ_TIM2);
+
+    // start the core cycle counter too, it needs trace enabled in the debug block
+    uint32_t * demcr = (uint32_t *) DEMCR;
+    uint32_t * dwtCTRL = (uint32_t *) DWT_CTRL;
+    * demcr |= DEMCR_TRCENA;
+    * dwtCYCCNT = 0;
+    * dwtCTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+// Gets the current value of the microsecond counter
+// @ param void
+// @ return the counter value in microseconds
+uint32_t timebase_now_us(void) {
+    return * tim2CNT;
+}
+
+// Gets the number of microseconds elapsed since an earlier counter value
+// @ param since - an earlier value from timebase_now_us
+// @ return the elapsed time in microseconds, correct across a single wrap
+uint32_t timebase_elapsed_us(uint32_t since) {
+    return * tim2CNT - since;
+}
+
+// Gets the current value of the core cycle counter
+// the counter wraps after 2^32 cycles, so only differences between nearby readings are meaningful
+// @ param void
+// @ return the counter value in core clock cycles
+uint32_t timebase_cycles(void) {
+    return * dwtCYCCNT;
+}
+
+// Arms an interrupt for when the microsecond counter reaches a value, so a sleeping core wakes then
+// the alarm fires once, on the exact match, so a value already passed fires only after the counter wraps
+// @ param at - the counter value to wake at
+// @ return void
+void timebase_set_alarm(uint32_t at) {
+    * tim2CCR1 = at;
+    * tim2SR = ~TIM_SR_CC1IF;
+    * tim2DIER |= TIM_DIER_CC1IE;
+}
+
+// Disarms the alarm if it has not fired yet
+// @ param void
+// @ return void
+void timebase_cancel_alarm(void) {
+    * tim2DIER &= ~TIM_DIER_CC1IE;
+    * tim2SR = ~TIM_SR_CC1IF;
+}
+
+// Alarm interrupt handler
+// the alarm only has to end a sleep, whoever armed it checks the time once awake
+// @ param void
+// @ return void
+void TIM2_IRQHandler(void) {
+    * tim2SR = ~TIM_SR_CC1IF;
+    * tim2DIER &= ~TIM_DIER_CC1IE;
+}
@@ -0,0 +1,30 @@
+// file: timebase.h
+// created by: agent
+// date created: 10/16/2026
+// last modified: 10/16/2026
+// description: Header file for timebase.c
+
+# ifndef TIMEBASE_H
+# define TIMEBASE_H
+
+# include <stdint.h>
+
+// Starts the free-running microsecond counter
+void timebase_init(void);
+
+// Gets the current value of the microsecond counter
+uint32_t timebase_now_us(void);
+
+// Gets the number of microseconds elapsed since an earlier counter value
+uint32_t timebase_elapsed_us(uint32_t since);
+
+// Gets the current value of the core cycle counter
+uint32_t timebase_cycles(void);
+
+// Arms an interrupt for when the microsecond counter reaches a value
+void timebase_set_alarm(uint32_t at);
+
+// Disarms the alarm if it has not fired yet
+void timebase_cancel_alarm(void);
+
+# endif